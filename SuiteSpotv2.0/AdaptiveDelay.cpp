@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "AdaptiveDelay.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+namespace
+{
+    constexpr int kStateVersion = 1;
+
+    double ClampDelay(double sec)
+    {
+        return std::clamp(sec, 0.0, AdaptiveDelayTable::kMaxDelaySec);
+    }
+
+    // One comma-terminated field of a persisted line; false leaves p as is.
+    // The file may be hand-edited, so anything out of range is rejected
+    // rather than cast.
+    bool ReadDelayField(const char*& p, double& value)
+    {
+        char* end = nullptr;
+        value = std::strtod(p, &end);
+        if (end == p || *end != ',' || !std::isfinite(value)) return false;
+        p = end + 1;
+        return true;
+    }
+
+    bool ReadCountField(const char*& p, uint32_t& value)
+    {
+        // strtoul would accept and negate a leading '-'
+        if (*p < '0' || *p > '9') return false;
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long long parsed = std::strtoull(p, &end, 10);
+        if (end == p || *end != ',' || errno == ERANGE || parsed > UINT32_MAX) return false;
+        value = static_cast<uint32_t>(parsed);
+        p = end + 1;
+        return true;
+    }
+}
+
+// Commas would split the persisted line; they never appear in real playlist names
+std::string AdaptiveDelayTable::Key(std::string_view action, std::string_view mode, std::string_view playlist)
+{
+    std::string key;
+    key.reserve(action.size() + mode.size() + playlist.size() + 2);
+    key.append(action).append("/").append(mode).append("/").append(playlist.empty() ? std::string_view("unknown") : playlist);
+    std::replace(key.begin(), key.end(), ',', ' ');
+    return key;
+}
+
+double AdaptiveDelayTable::GetDelay(const std::string& key, double initialSec) const
+{
+    const auto it = entries_.find(key);
+    return it == entries_.end() ? ClampDelay(initialSec) : it->second.delaySec;
+}
+
+AdaptiveDelayTable::Entry& AdaptiveDelayTable::Touch(const std::string& key, double initialSec)
+{
+    const auto inserted = entries_.try_emplace(key);
+    if (inserted.second) inserted.first->second.delaySec = ClampDelay(initialSec);
+    return inserted.first->second;
+}
+
+void AdaptiveDelayTable::RecordSuccess(const std::string& key, double /*issuedAtSec*/, double initialSec)
+{
+    Entry& e = Touch(key, initialSec);
+    ++e.successes;
+    ++e.sinceFailure;
+    if (e.sinceFailure % kFloorDecayStreak == 0) {
+        e.floorSec = std::max(0.0, e.floorSec - kMarginSec);
+    }
+    if (++e.streak >= kSuccessStreak) {
+        const double step = std::max(kMinStepSec, e.delaySec * kStepFraction);
+        e.delaySec = std::max(e.floorSec, e.delaySec - step);
+        e.streak = 0;
+    }
+}
+
+void AdaptiveDelayTable::RecordFailure(const std::string& key, double issuedAtSec, double initialSec)
+{
+    Entry& e = Touch(key, initialSec);
+    ++e.failures;
+    e.streak = 0;
+    e.sinceFailure = 0;
+    e.floorSec = ClampDelay(std::max(e.floorSec, issuedAtSec + kMarginSec));
+    e.delaySec = ClampDelay(std::max(e.delaySec, e.floorSec + kMarginSec));
+}
+
+// Lines: "version,1" then "delay,<delay>,<floor>,<streak>,<sinceFailure>,<successes>,<failures>,<key>"
+// (key last: it is the only free-form field)
+void AdaptiveDelayTable::Serialize(std::ostream& out) const
+{
+    out << "version," << kStateVersion << "\n";
+    for (const auto& [key, e] : entries_) {
+        out << "delay," << e.delaySec << "," << e.floorSec << "," << e.streak << "," << e.sinceFailure << ","
+            << e.successes << "," << e.failures << "," << key << "\n";
+    }
+}
+
+bool AdaptiveDelayTable::Deserialize(std::istream& in)
+{
+    bool sawVersion = false;
+    std::map<std::string, Entry> entries;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.rfind("version,", 0) == 0) {
+            sawVersion = std::atoi(line.c_str() + 8) == kStateVersion;
+            continue;
+        }
+        if (line.rfind("delay,", 0) != 0) continue;
+
+        const char* p = line.c_str() + 6;
+        Entry e;
+        const bool ok = ReadDelayField(p, e.delaySec) && ReadDelayField(p, e.floorSec) &&
+                        ReadCountField(p, e.streak) && ReadCountField(p, e.sinceFailure) &&
+                        ReadCountField(p, e.successes) && ReadCountField(p, e.failures);
+        if (!ok || *p == '\0') continue;
+        e.delaySec = ClampDelay(e.delaySec);
+        e.floorSec = ClampDelay(e.floorSec);
+        entries[p] = e;
+    }
+    if (!sawVersion) return false;
+    entries_ = std::move(entries);
+    return true;
+}
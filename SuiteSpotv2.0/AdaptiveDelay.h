@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <string_view>
+
+// AdaptiveDelayTable: Learned post-match delays
+//
+// Purpose: Replaces hand-tuned load/queue delays with the smallest delay
+// that has been working, per action, map mode and playlist (e.g.
+// "load/training/Ranked Doubles"). The post-match sequence asks for a
+// key's delay, issues the command that long after match end, checks
+// that the game acted on it, and reports the outcome:
+//   - a success streak of kSuccessStreak shaves the delay by a step
+//     (15%, at least kMinStepSec), never below the floor
+//   - a failure at t seconds raises the floor to t + kMarginSec and the
+//     delay to at least the floor plus a margin, so the next match is
+//     safe again
+//   - every kFloorDecayStreak successes since the last failure lower the
+//     floor by one margin, so a faster game (or PC) is eventually learned
+// A key starts from the user's configured delay, which was chosen to be
+// safe.
+//
+// Persistence: Serialize/Deserialize write one "key,value" line per
+// field (see Deserialize); SuiteSpot keeps the table per machine under
+// SuiteTraining.
+class AdaptiveDelayTable
+{
+public:
+    static constexpr double kMarginSec = 0.5;
+    static constexpr double kMinStepSec = 0.25;
+    static constexpr double kStepFraction = 0.15;
+    static constexpr uint32_t kSuccessStreak = 3;
+    static constexpr uint32_t kFloorDecayStreak = 20;
+    static constexpr double kMaxDelaySec = 300.0;  // Same limit as the delay cvars
+
+    struct Entry {
+        double delaySec = 0.0;
+        double floorSec = 0.0;
+        uint32_t streak = 0;         // Successes since the last step down or failure
+        uint32_t sinceFailure = 0;   // Successes since the last failure
+        uint32_t successes = 0;
+        uint32_t failures = 0;
+    };
+
+    static std::string Key(std::string_view action, std::string_view mode, std::string_view playlist);
+
+    // Learned delay for key, or initialSec when nothing has been learned
+    double GetDelay(const std::string& key, double initialSec) const;
+
+    // issuedAtSec: when the command was issued, in seconds after match end
+    void RecordSuccess(const std::string& key, double issuedAtSec, double initialSec);
+    void RecordFailure(const std::string& key, double issuedAtSec, double initialSec);
+
+    const std::map<std::string, Entry>& Entries() const { return entries_; }
+    void Clear() { entries_.clear(); }
+
+    void Serialize(std::ostream& out) const;
+    bool Deserialize(std::istream& in);
+
+private:
+    Entry& Touch(const std::string& key, double initialSec);
+
+    std::map<std::string, Entry> entries_;
+};
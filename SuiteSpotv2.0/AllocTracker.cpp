@@ -0,0 +1,102 @@
+#include "pch.h"
+#include "AllocTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#if SUITESPOT_ALLOC_TRACKING
+
+namespace
+{
+    // Constant-initialized, so usable from operator new at any point in a
+    // thread's life
+    thread_local uint64_t tlsAllocations = 0;
+    thread_local uint64_t tlsBytes = 0;
+
+    void* Allocate(std::size_t size)
+    {
+        ++tlsAllocations;
+        tlsBytes += size;
+        return std::malloc(size ? size : 1);
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        ++tlsAllocations;
+        tlsBytes += size;
+        const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, align);
+#else
+        // aligned_alloc needs a multiple of the alignment
+        return std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+#endif
+    }
+
+    void FreeAligned(void* p)
+    {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+AllocCounters ThreadAllocCounters()
+{
+    return { tlsAllocations, tlsBytes };
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = AllocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = AllocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+
+#else
+
+AllocCounters ThreadAllocCounters()
+{
+    return {};
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap accounting is compiled in when SUITESPOT_ALLOC_TRACKING is 1: by
+// default in debug builds; pass /DSUITESPOT_ALLOC_TRACKING=1 to keep it in
+// a release build.
+#ifndef SUITESPOT_ALLOC_TRACKING
+#ifdef _DEBUG
+#define SUITESPOT_ALLOC_TRACKING 1
+#else
+#define SUITESPOT_ALLOC_TRACKING 0
+#endif
+#endif
+
+// Heap traffic of one thread since it started
+struct AllocCounters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;       // Requested, not what the heap rounded up to
+};
+
+// AllocTracker: Counts SuiteSpot's own heap allocations per thread
+//
+// Purpose: With SUITESPOT_ALLOC_TRACKING, AllocTracker.cpp replaces the
+// global operator new family for the plugin module. A DLL's replacement
+// only sees allocations made by code linked into that DLL, so the counts
+// cover SuiteSpot (and the SDK pieces it links statically), not the game
+// or other plugins. Each allocation bumps two thread-local counters and
+// otherwise goes to malloc as the default operator new does, so memory
+// still crosses module boundaries safely.
+//
+// Callers take two snapshots and subtract: ProfileScope does this for
+// every SS_PROFILE_SCOPE, which is what the profiler's per-panel
+// allocation columns show.
+//
+// Threading: ThreadAllocCounters reads the calling thread's counters only.
+//
+// Usage Example:
+//   const AllocCounters before = ThreadAllocCounters();
+//   RenderSomething();
+//   const AllocCounters used = ThreadAllocCounters() - before;
+AllocCounters ThreadAllocCounters();
+
+// False when compiled out: every snapshot is zero
+constexpr bool AllocTrackingEnabled() { return SUITESPOT_ALLOC_TRACKING != 0; }
+
+inline AllocCounters operator-(const AllocCounters& a, const AllocCounters& b)
+{
+    return { a.allocations - b.allocations, a.bytes - b.bytes };
+}
@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "AsyncLogger.h"
+
+#include <cstdio>
+#include <system_error>
+
+const char* LogLevelName(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warn: return "warn";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: return "off";
+        default: return "?";
+    }
+}
+
+AsyncLogger& GlobalLogger()
+{
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger()
+    : slots_(std::make_unique<Slot[]>(kCapacity))
+{
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+    // Slot i is free for the producer whose position is i
+    for (size_t i = 0; i < kCapacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    Stop();
+}
+
+void AsyncLogger::Start(Sink console)
+{
+    if (Running()) return;
+    console_ = std::move(console);
+    stopping_.store(false, std::memory_order_relaxed);
+    fileChanged_.store(true, std::memory_order_relaxed);  // Reopen a file set before a Stop
+    flusher_ = std::thread([this] { Run(); });
+    running_.store(true, std::memory_order_release);
+}
+
+// #detailed comments: AsyncLogger::Stop
+// Purpose: After running_ goes false no new producer gets past the check
+// in Submit; waiting for producers_ to reach zero covers the ones that
+// already did, so the flusher's final Drain sees every accepted line.
+void AsyncLogger::Stop()
+{
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    while (producers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    stopping_.store(true, std::memory_order_release);
+    if (flusher_.joinable()) flusher_.join();
+    file_.close();
+    filePath_.clear();
+    DrainConsole();
+    console_ = nullptr;
+}
+
+void AsyncLogger::DrainConsole()
+{
+    {
+        std::lock_guard<std::mutex> lock(consoleMutex_);
+        if (consolePending_.empty()) return;
+        consoleBatch_.swap(consolePending_);
+    }
+    for (const auto& [level, line] : consoleBatch_) {
+        if (console_) console_(level, line);
+    }
+    consoleBatch_.clear();
+}
+
+// Flusher: the line waits for the owner thread's next DrainConsole
+void AsyncLogger::QueueConsole(LogLevel level, std::string line)
+{
+    std::lock_guard<std::mutex> lock(consoleMutex_);
+    if (consolePending_.size() >= kCapacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    consolePending_.emplace_back(level, std::move(line));
+}
+
+bool AsyncLogger::Submit(LogLevel level, std::string& line)
+{
+    producers_.fetch_add(1, std::memory_order_acq_rel);
+    if (!running_.load(std::memory_order_acquire)) {
+        producers_.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &slots_[pos & (kCapacity - 1)];
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Full: the flusher has not freed this slot from the last lap
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            producers_.fetch_sub(1, std::memory_order_release);
+            line.clear();
+            return true;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->line = std::move(line);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    producers_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogger::Pop(LogLevel& level, std::string& line)
+{
+    Slot& slot = slots_[dequeuePos_ & (kCapacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) return false;
+    level = slot.level;
+    line = std::move(slot.line);
+    slot.line.clear();
+    // Free for the producer one lap ahead
+    slot.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+void AsyncLogger::Run()
+{
+    for (;;) {
+        // Stop sets stopping_ once no producer can add more, so the drain
+        // after seeing it is the last one needed
+        const bool last = stopping_.load(std::memory_order_acquire);
+        const size_t count = Drain();
+        if (last) break;
+        if (count == 0) std::this_thread::sleep_for(kFlushInterval);
+    }
+}
+
+size_t AsyncLogger::Drain()
+{
+    if (fileChanged_.exchange(false, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        file_.close();
+        filePath_ = requestedFile_;
+        fileBytes_ = 0;
+        if (!filePath_.empty()) {
+            std::error_code ec;
+            fileBytes_ = std::filesystem::exists(filePath_, ec) ? std::filesystem::file_size(filePath_, ec) : 0;
+            file_.open(filePath_, std::ios::app | std::ios::binary);
+        }
+    }
+
+    size_t count = 0;
+    LogLevel level;
+    std::string line;
+    while (Pop(level, line)) {
+        if (file_.is_open()) WriteFile(level, line);
+        if (console_) QueueConsole(level, std::move(line));
+        ++count;
+    }
+
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != droppedReported_) {
+        line = "SuiteSpot: log queue full, dropped " + std::to_string(dropped - droppedReported_) + " line(s)";
+        droppedReported_ = dropped;
+        if (file_.is_open()) WriteFile(LogLevel::Warn, line);
+        if (console_) QueueConsole(LogLevel::Warn, std::move(line));
+    }
+    if (count > 0 && file_.is_open()) file_.flush();
+    return count;
+}
+
+void AsyncLogger::WriteFile(LogLevel level, const std::string& line)
+{
+    using namespace std::chrono;
+    const auto now = floor<milliseconds>(system_clock::now());
+    const auto day = floor<days>(now);
+    const year_month_day date{ day };
+    const hh_mm_ss<milliseconds> time{ now - day };
+
+    char stamp[48];
+    const int len = std::snprintf(stamp, sizeof(stamp), "%04d-%02u-%02u %02d:%02d:%02d.%03d %-5s ",
+        static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()),
+        static_cast<int>(time.hours().count()), static_cast<int>(time.minutes().count()),
+        static_cast<int>(time.seconds().count()), static_cast<int>(time.subseconds().count()), LogLevelName(level));
+    file_.write(stamp, len);
+    file_.write(line.data(), static_cast<std::streamsize>(line.size()));
+    file_.put('\n');
+    fileBytes_ += static_cast<uintmax_t>(len) + line.size() + 1;
+    if (fileBytes_ >= kMaxFileBytes) Rotate();
+}
+
+// name.log -> name.1.log -> ... -> name.(kMaxFiles-1).log, oldest deleted
+void AsyncLogger::Rotate()
+{
+    file_.close();
+    const auto numbered = [this](int n) {
+        auto path = filePath_;
+        path.replace_extension("." + std::to_string(n) + filePath_.extension().string());
+        return path;
+    };
+    std::error_code ec;
+    std::filesystem::remove(numbered(kMaxFiles - 1), ec);
+    for (int n = kMaxFiles - 2; n >= 1; --n) {
+        std::filesystem::rename(numbered(n), numbered(n + 1), ec);
+    }
+    std::filesystem::rename(filePath_, numbered(1), ec);
+    file_.open(filePath_, std::ios::trunc | std::ios::binary);
+    fileBytes_ = 0;
+}
+
+void AsyncLogger::SetFile(std::filesystem::path path)
+{
+    {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        requestedFile_ = std::move(path);
+    }
+    fileChanged_.store(true, std::memory_order_release);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class LogLevel : uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+const char* LogLevelName(LogLevel level);
+
+// AsyncLogger: Moves log output off the calling thread
+//
+// Purpose: LOG used to hand every line to the console on the thread that
+// logged it, game thread included. Submit now only moves the formatted
+// line into a bounded lock-free queue; one flusher thread drains it every
+// kFlushInterval to a rotating file when enabled (kMaxFileBytes per file,
+// kMaxFiles kept: name.log, name.1.log, ...) and hands it on for the
+// console.
+//
+// Console: BakkesMod does not document the console as thread-safe, so the
+// console sink only ever runs on the thread that calls DrainConsole (the
+// game thread's tick, and Stop). The flusher parks console lines in a
+// batch of at most kCapacity; lines past that are dropped and counted.
+//
+// Queue: Vyukov's bounded MPMC ring, used with many producers and the one
+// flusher. A producer claims a slot with one CAS and never waits; when the
+// ring is full the line is dropped and counted, and the flusher reports
+// the count. Lines keep their per-thread order.
+//
+// Threading: Submit, SetFile and SetLevel from any thread. Start, Stop and
+// DrainConsole from one owner thread (the game thread: onLoad, the tick,
+// onUnload). Stop waits for producers already inside Submit, drains what
+// is queued, joins the flusher and writes the last console lines, so
+// nothing reaches the sinks after it returns.
+//
+// Usage Example:
+//   logger.Start([](LogLevel, const std::string& line) { console->log(line); });
+//   std::string line = "hello";
+//   if (!logger.Submit(LogLevel::Info, line)) console->log(line);  // not running
+//   logger.DrainConsole();  // every tick
+//   logger.Stop();
+class AsyncLogger
+{
+public:
+    using Sink = std::function<void(LogLevel level, const std::string& line)>;
+
+    static constexpr size_t kCapacity = 4096;  // Power of two
+    static constexpr std::chrono::milliseconds kFlushInterval{ 10 };
+    static constexpr uintmax_t kMaxFileBytes = 1024 * 1024;
+    static constexpr int kMaxFiles = 3;
+
+    AsyncLogger();
+    ~AsyncLogger();
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void Start(Sink console);
+    void Stop();
+    // Owner thread: passes the lines the flusher has queued to the console sink
+    void DrainConsole();
+    bool Running() const { return running_.load(std::memory_order_acquire); }
+
+    // Takes line (moved from) and returns true when running, dropped or
+    // not; false leaves line untouched for the caller to write itself
+    bool Submit(LogLevel level, std::string& line);
+
+    // Also write to path (rotating); empty turns the file off
+    void SetFile(std::filesystem::path path);
+
+    // Runtime threshold; lines below it are never formatted (see logging.h)
+    void SetLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    LogLevel Level() const { return level_.load(std::memory_order_relaxed); }
+
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{ 0 };
+        LogLevel level = LogLevel::Info;
+        std::string line;
+    };
+
+    void Run();
+    size_t Drain();
+    bool Pop(LogLevel& level, std::string& line);
+    void QueueConsole(LogLevel level, std::string line);
+    void WriteFile(LogLevel level, const std::string& line);
+    void Rotate();
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> enqueuePos_{ 0 };
+    alignas(64) uint64_t dequeuePos_ = 0;  // Flusher only
+    std::atomic<uint64_t> dropped_{ 0 };
+    uint64_t droppedReported_ = 0;         // Flusher only
+    std::atomic<int> producers_{ 0 };      // Inside Submit past the running check
+    std::atomic<bool> running_{ false };
+    std::atomic<bool> stopping_{ false };
+    std::atomic<LogLevel> level_{ LogLevel::Info };
+
+    Sink console_;
+    std::thread flusher_;
+
+    // Console lines: the flusher appends, DrainConsole swaps the batch out
+    std::mutex consoleMutex_;
+    std::vector<std::pair<LogLevel, std::string>> consolePending_;
+    std::vector<std::pair<LogLevel, std::string>> consoleBatch_;  // Owner thread only
+
+    // File output: SetFile records the request, the flusher applies it
+    std::mutex fileMutex_;
+    std::filesystem::path requestedFile_;
+    std::atomic<bool> fileChanged_{ false };
+    std::filesystem::path filePath_;       // Flusher only from here down
+    std::ofstream file_;
+    uintmax_t fileBytes_ = 0;
+};
+
+// The plugin's logger, used by LOG (logging.h)
+AsyncLogger& GlobalLogger();
@@ -0,0 +1,833 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "AllocTracker.h"
+#include "CatalogArena.h"
+#include "CatalogIO.h"
+#include "FontAtlasBake.h"
+#include "MatchStatSampler.h"
+#include "PackFilter.h"
+#include "PostMatchLayout.h"
+#include "ShuffleScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+namespace
+{
+    // GenerateSyntheticTrainingFile writes every 500th line malformed
+    constexpr size_t kMalformedTrainingEvery = 500;
+
+    const char* const kDifficulties[] = {
+        "Bronze", "Silver", "Gold", "Platinum", "Diamond", "Champion", "Grand Champion", "Supersonic Legend"
+    };
+    const char* const kTags[] = {
+        "Aerial", "Air Dribble", "Backboard", "Ceiling", "Defense", "Dribble", "Flick", "Ground",
+        "Kickoff", "Musty", "Offense", "Passing", "Redirect", "Saves", "Shooting", "Wall"
+    };
+    const char* const kWords[] = {
+        "Aerial", "Basics", "Challenge", "Double", "Flip", "Reset", "Redirects", "Shots",
+        "Speed", "Striker", "Tap", "Wall", "Warmup", "Power", "Air", "Roll"
+    };
+
+    template <typename Fn>
+    double BestMillis(int iterations, Fn&& fn)
+    {
+        double best = 0.0;
+        for (int i = 0; i < std::max(1, iterations); ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = (i == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+    double MillisSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Stands in for ImDrawList: consumes every call so none is optimized out
+    struct CountingDrawSink {
+        size_t calls = 0;
+        size_t chars = 0;
+        uint32_t colorHash = 0;
+
+        void Rect(const OverlayDrawItem& item, uint32_t color) { ++calls; colorHash ^= color + static_cast<uint32_t>(item.x1); }
+        void Text(const OverlayDrawItem& item, const char* begin, const char* end, uint32_t color)
+        {
+            ++calls;
+            chars += static_cast<size_t>(end - begin);
+            colorHash ^= color + static_cast<uint32_t>(item.y0);
+        }
+    };
+
+    uint32_t LegacyColor(float r, float g, float b, float a)
+    {
+        return PostMatchLayout::PackRgb(r, g, b) | (PostMatchLayout::AlphaByte(a) << 24);
+    }
+
+    void LegacyText(CountingDrawSink& sink, float x, float y, float size, uint32_t color, const std::string& text)
+    {
+        OverlayDrawItem item;
+        item.kind = OverlayDrawKind::Text;
+        item.x0 = x;
+        item.y0 = y;
+        item.size = size;
+        sink.Text(item, text.data(), text.data() + text.size(), color);
+    }
+
+    void LegacyRect(CountingDrawSink& sink, float x0, float y0, float x1, float y1, uint32_t color)
+    {
+        OverlayDrawItem item;
+        item.x0 = x0;
+        item.y0 = y0;
+        item.x1 = x1;
+        item.y1 = y1;
+        sink.Rect(item, color);
+    }
+
+    // The per-frame work RenderPostMatchOverlay did before PostMatchLayout
+    void LegacyOverlayFrame(const PostMatchInfo& info, const PostMatchLayoutStyle& style, float alpha, CountingDrawSink& sink)
+    {
+        LegacyRect(sink, 0, 0, style.width, style.height, LegacyColor(0, 0, 0, style.backgroundAlpha * alpha));
+        LegacyRect(sink, 0, 0, style.width, 34.0f, LegacyColor(0, 0, 0, style.headerAlpha * alpha));
+        const uint32_t titleColor = LegacyColor(1, 1, 1, alpha);
+        std::string title = "MATCH COMPLETE";
+        if (info.overtime) title += " - OVERTIME";
+        LegacyText(sink, 12, 8, style.teamHeaderFontSize, titleColor, title);
+        std::string matchInfo = info.playlist + " | " + info.myTeamName + " " +
+            std::to_string(info.myScore) + " - " + std::to_string(info.oppScore) + " " + info.oppTeamName;
+        LegacyText(sink, 12, 45, style.headerFontSize, titleColor, matchInfo);
+
+        float contentY = 70.0f;
+        if (style.showColumnHeaders) {
+            const uint32_t headerColor = LegacyColor(0.7f, 0.7f, 0.7f, alpha);
+            const std::pair<float, const char*> columns[] = {
+                { style.nameColumnX, "Player" }, { style.scoreColumnX, "Score" }, { style.goalsColumnX, "Goals" },
+                { style.assistsColumnX, "Assists" }, { style.savesColumnX, "Saves" }, { style.shotsColumnX, "Shots" },
+                { style.pingColumnX, "Ping" },
+            };
+            for (const auto& [x, label] : columns) LegacyText(sink, x, contentY, style.headerFontSize, headerColor, label);
+            contentY += style.playerRowHeight;
+        }
+
+        for (int teamIdx = 0; teamIdx <= 1; teamIdx++) {
+            bool isMyTeam = false;
+            for (const auto& p : info.Players()) {
+                if (p.isLocal && p.teamIndex == teamIdx) {
+                    isMyTeam = true;
+                    break;
+                }
+            }
+            std::string teamName = isMyTeam ? info.myTeamName : info.oppTeamName;
+            const int teamScore = isMyTeam ? info.myScore : info.oppScore;
+
+            const float h = teamIdx == 0 ? style.blueTeamHue : style.orangeTeamHue;
+            const float sat = teamIdx == 0 ? style.blueTeamSat : style.orangeTeamSat;
+            const float v = teamIdx == 0 ? style.blueTeamVal : style.orangeTeamVal;
+            const float c = v * sat;
+            const float x = c * (1 - std::fabs(std::fmod(h / 60.0f, 2.0f) - 1));
+            const float m = v - c;
+            const float r = h < 60 || h >= 300 ? c : (h < 120 ? x : (h >= 240 ? x : 0));
+            const float g = h < 60 ? x : (h < 180 ? c : (h < 240 ? x : 0));
+            const float b = h < 120 ? 0 : (h < 180 ? x : (h < 300 ? c : x));
+            const uint32_t teamColor = LegacyColor(r + m, g + m, b + m, alpha);
+
+            std::string teamHeader = teamName;
+            if (style.showTeamScores) teamHeader += " - " + std::to_string(teamScore);
+            LegacyRect(sink, style.sectionPadding, contentY, style.width - style.sectionPadding, contentY + style.teamHeaderHeight, teamColor);
+            LegacyText(sink, style.nameColumnX, contentY + 4.0f, style.teamHeaderFontSize, titleColor, teamHeader);
+            contentY += style.teamHeaderHeight + 4.0f;
+
+            for (const auto& player : info.Players()) {
+                if (player.teamIndex != teamIdx) continue;
+                const uint32_t playerColor = player.isMVP && style.showMvpGlow ? LegacyColor(1.f, 0.84f, 0.f, alpha) : titleColor;
+                if (player.isMVP) {
+                    LegacyText(sink, style.nameColumnX - 20.0f, contentY, style.mainFontSize * style.mvpCheckmarkSize,
+                        LegacyColor(1.f, 0.84f, 0.f, alpha), "\xE2\x98\x85");
+                }
+                LegacyText(sink, style.nameColumnX, contentY, style.mainFontSize, playerColor, player.name);
+                LegacyText(sink, style.scoreColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.score));
+                LegacyText(sink, style.goalsColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.goals));
+                LegacyText(sink, style.assistsColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.assists));
+                LegacyText(sink, style.savesColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.saves));
+                LegacyText(sink, style.shotsColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.shots));
+                LegacyText(sink, style.pingColumnX, contentY, style.mainFontSize, playerColor, std::to_string(player.ping));
+                contentY += style.playerRowHeight;
+            }
+            contentY += style.teamSectionSpacing;
+        }
+    }
+
+    // Full 4v4 result with long-ish names (past the small-string buffer)
+    PostMatchInfo SampleOverlayMatch()
+    {
+        PostMatchInfo info;
+        info.sequence = 1;
+        info.active = true;
+        info.myTeamName = "Blue Team Supersonic";
+        info.oppTeamName = "Orange Team Grand Champs";
+        info.playlist = "Ranked Chaos 4v4";
+        info.myScore = 5;
+        info.oppScore = 4;
+        info.overtime = true;
+        info.playerCount = kMaxPostMatchPlayers;
+        for (size_t i = 0; i < info.playerCount; ++i) {
+            PostMatchPlayerRow& row = info.rows[i];
+            row.teamIndex = static_cast<int>(i % 2);
+            row.isLocal = i == 0;
+            row.name = "Player Number " + std::to_string(i + 1) + " Long Name";
+            row.score = 1000 - static_cast<int>(i) * 90;
+            row.goals = static_cast<int>(i % 3);
+            row.assists = static_cast<int>(i % 2);
+            row.saves = static_cast<int>(i % 4);
+            row.shots = static_cast<int>(i % 5) + 1;
+            row.ping = 40 + static_cast<int>(i) * 7;
+            row.isMVP = i < 2;
+        }
+        return info;
+    }
+
+    PostMatchLayoutStyle SampleOverlayStyle()
+    {
+        PostMatchLayoutStyle style;
+        style.width = 880.0f;
+        style.height = 400.0f;
+        style.teamHeaderHeight = 28.0f;
+        style.playerRowHeight = 24.0f;
+        style.teamSectionSpacing = 12.0f;
+        style.sectionPadding = 8.0f;
+        style.nameColumnX = 50.0f;
+        style.scoreColumnX = 230.0f;
+        style.goalsColumnX = 290.0f;
+        style.assistsColumnX = 350.0f;
+        style.savesColumnX = 410.0f;
+        style.shotsColumnX = 470.0f;
+        style.pingColumnX = 530.0f;
+        style.mainFontSize = 14.0f;
+        style.headerFontSize = 12.0f;
+        style.teamHeaderFontSize = 16.0f;
+        style.blueTeamHue = 240.0f;
+        style.blueTeamSat = 0.8f;
+        style.blueTeamVal = 0.6f;
+        style.orangeTeamHue = 25.0f;
+        style.orangeTeamSat = 0.9f;
+        style.orangeTeamVal = 0.7f;
+        style.backgroundAlpha = 0.4f;
+        style.headerAlpha = 0.8f;
+        style.mvpCheckmarkSize = 1.2f;
+        style.showMvpGlow = true;
+        style.showTeamScores = true;
+        style.showColumnHeaders = true;
+        return style;
+    }
+
+    // Mirrors LoadPrejumpPacksFromFile: every field of the copy lives in resource
+    void BuildCatalog(const std::vector<TrainingEntry>& source, std::pmr::memory_resource* resource, std::vector<TrainingEntry>& out)
+    {
+        out.clear();
+        out.reserve(source.size());
+        for (const auto& src : source) {
+            TrainingEntry entry(resource);
+            entry.code = src.code;
+            entry.name = src.name;
+            entry.creator = src.creator;
+            entry.creatorSlug = src.creatorSlug;
+            entry.difficulty = src.difficulty;
+            entry.tags.reserve(src.tags.size());
+            for (const auto& tag : src.tags) {
+                entry.tags.emplace_back(tag);
+            }
+            entry.shotCount = src.shotCount;
+            entry.likes = src.likes;
+            entry.plays = src.plays;
+            out.push_back(std::move(entry));
+        }
+    }
+}
+
+std::vector<TrainingEntry> GenerateSyntheticPacks(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> word(0, static_cast<int>(std::size(kWords)) - 1);
+    std::uniform_int_distribution<int> difficulty(0, static_cast<int>(std::size(kDifficulties)) - 1);
+    std::uniform_int_distribution<int> tag(0, static_cast<int>(std::size(kTags)) - 1);
+    std::uniform_int_distribution<int> tagCount(0, 4);
+    std::uniform_int_distribution<int> shots(1, 50);
+    std::uniform_int_distribution<int> likes(0, 5000);
+    std::uniform_int_distribution<uint32_t> hex(0, 0xFFFF);
+
+    std::vector<TrainingEntry> packs;
+    packs.reserve(count);
+    char codeBuf[24];
+    for (size_t i = 0; i < count; ++i) {
+        TrainingEntry entry;
+        std::snprintf(codeBuf, sizeof(codeBuf), "%04X-%04X-%04X-%04X", hex(rng), hex(rng), hex(rng), hex(rng));
+        entry.code = codeBuf;
+        entry.name = std::string(kWords[word(rng)]) + " " + kWords[word(rng)] + " " + std::to_string(i % 1000);
+        entry.creator = std::string("creator") + std::to_string(i % 997);
+        entry.creatorSlug = entry.creator;
+        entry.difficulty = kDifficulties[difficulty(rng)];
+        const int tags = tagCount(rng);
+        for (int t = 0; t < tags; ++t) {
+            entry.tags.emplace_back(kTags[tag(rng)]);
+        }
+        entry.shotCount = shots(rng);
+        entry.likes = likes(rng);
+        entry.plays = entry.likes * 10 + likes(rng);
+        packs.push_back(std::move(entry));
+    }
+    return packs;
+}
+
+std::string GenerateSyntheticTrainingFile(size_t count, uint32_t seed)
+{
+    const auto packs = GenerateSyntheticPacks(count, seed);
+    std::string text;
+    text.reserve(count * 48);
+    for (size_t i = 0; i < packs.size(); ++i) {
+        const auto& pack = packs[i];
+        if (i % kMalformedTrainingEvery == kMalformedTrainingEvery - 1) {
+            text += "not a pack line\n";
+        } else if (i % 50 == 49) {
+            text.append(pack.code).append(",").append(pack.name).append(" (").append(std::to_string(pack.shotCount)).append(")\n");
+        } else {
+            text.append(pack.code).append(",").append(pack.name).append(",Shots:").append(std::to_string(pack.shotCount)).append("\n");
+        }
+    }
+    return text;
+}
+
+std::string GenerateSyntheticPrejumpJson(size_t count, uint32_t seed)
+{
+    const auto packs = GenerateSyntheticPacks(count, seed);
+    nlohmann::json rows = nlohmann::json::array();
+    for (const auto& pack : packs) {
+        nlohmann::json row;
+        row["code"] = std::string(pack.code);
+        row["name"] = std::string(pack.name);
+        row["creator"] = std::string(pack.creator);
+        row["creatorSlug"] = std::string(pack.creatorSlug);
+        row["difficulty"] = std::string(pack.difficulty);
+        row["shotCount"] = pack.shotCount;
+        row["staffComments"] = "";
+        row["notes"] = std::string(pack.name) + " by " + std::string(pack.creator) + ". Reset after every attempt.";
+        row["videoUrl"] = "";
+        row["likes"] = pack.likes;
+        row["plays"] = pack.plays;
+        row["status"] = 1;
+        nlohmann::json tags = nlohmann::json::array();
+        for (const auto& tag : pack.tags) tags.push_back(std::string(tag));
+        row["tags"] = std::move(tags);
+        rows.push_back(std::move(row));
+    }
+    nlohmann::json file;
+    file["packs"] = std::move(rows);
+    return file.dump(2);
+}
+
+size_t GenerateSyntheticWorkshopTree(const std::filesystem::path& root, size_t folders, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> word(0, static_cast<int>(std::size(kWords)) - 1);
+    std::error_code ec;
+    size_t maps = 0;
+    for (size_t i = 0; i < folders; ++i) {
+        const std::string name = std::string(kWords[word(rng)]) + "_" + kWords[word(rng)] + "_" + std::to_string(i);
+        const std::filesystem::path dir = root / name;
+        std::filesystem::create_directories(dir, ec);
+        if (ec) return maps;
+        // Workshop downloads carry a preview and notes next to the map,
+        // and the scan stops at the first .upk it meets
+        std::ofstream(dir / "preview.jpg");
+        std::ofstream(dir / "README.txt");
+        if (i % 10 != 9) {
+            std::ofstream(dir / (name + ".upk"));
+            ++maps;
+        }
+    }
+    return maps;
+}
+
+std::vector<BenchmarkResult> RunFilterScalingBenchmark(const std::vector<size_t>& sizes, size_t maxThreads, int iterations)
+{
+    std::vector<BenchmarkResult> results;
+    maxThreads = std::max<size_t>(1, maxThreads);
+
+    // 1, 2, 4, ... plus maxThreads itself when it is not a power of two
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    // Representative browser query: free-text search plus a shot floor,
+    // sorted by likes so the merge phase has real work to do
+    PackFilterCriteria criteria;
+    criteria.query = std::make_shared<const PackQuery>(PackQuery::Compile("wall shots>=10"));
+    criteria.sortColumn = 4;
+    criteria.sortAscending = false;
+
+    for (size_t size : sizes) {
+        const auto packs = GenerateSyntheticPacks(size);
+        double singleThreadMs = 0.0;
+
+        for (size_t threads : threadCounts) {
+            PackFilterEngine engine(threads);
+            engine.SetParallelThreshold(threads == 1 ? static_cast<size_t>(-1) : 0);
+
+            size_t matched = 0;
+            const double ms = BestMillis(iterations, [&]() { matched = engine.Run(packs, criteria).size(); });
+            (void)matched;
+
+            if (threads == 1) singleThreadMs = ms;
+
+            BenchmarkResult r;
+            r.name = "filter";
+            r.items = size;
+            r.threads = threads;
+            r.millis = ms;
+            r.itemsPerSec = ms > 0.0 ? static_cast<double>(size) * 1000.0 / ms : 0.0;
+            r.speedup = ms > 0.0 ? singleThreadMs / ms : 1.0;
+            results.push_back(r);
+        }
+    }
+    return results;
+}
+
+std::string FormatBenchmarkResult(const BenchmarkResult& result)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%-10s %9zu items %3zu thr %10.3f ms %8.2fM/s %6.2fx",
+        result.name.c_str(), result.items, result.threads, result.millis,
+        result.itemsPerSec / 1.0e6, result.speedup);
+    return buf;
+}
+
+// #detailed comments: RunCatalogAllocationBenchmark
+// Purpose: Before/after numbers for the catalog arena. The "heap" row
+// allocates each string from a counting wrapper around the default heap,
+// which is what a catalog of plain TrainingEntry values does; its live
+// block count is the number of separate heap blocks a reload has to free.
+// The "arena" row builds the same catalog in a CatalogArena sized like a
+// catalog file (~256 bytes of JSON per pack) and frees it with Release().
+std::vector<CatalogBenchmarkResult> RunCatalogAllocationBenchmark(size_t packCount, int iterations)
+{
+    const auto source = GenerateSyntheticPacks(packCount);
+    std::vector<TrainingEntry> catalog;
+
+    CatalogBenchmarkResult heapRow;
+    heapRow.mode = "heap";
+    heapRow.packs = packCount;
+    for (int i = 0; i < std::max(1, iterations); ++i) {
+        CountingResource heap;
+        auto start = std::chrono::steady_clock::now();
+        BuildCatalog(source, &heap, catalog);
+        const double buildMs = MillisSince(start);
+        heapRow.heapAllocations = heap.GetAllocationCount();
+        heapRow.bytesRequested = heap.GetBytesAllocated();
+        heapRow.bytesReserved = heap.GetLiveBytes();
+
+        start = std::chrono::steady_clock::now();
+        catalog.clear();
+        const double teardownMs = MillisSince(start);
+
+        heapRow.buildMillis = (i == 0) ? buildMs : std::min(heapRow.buildMillis, buildMs);
+        heapRow.teardownMillis = (i == 0) ? teardownMs : std::min(heapRow.teardownMillis, teardownMs);
+    }
+
+    CatalogBenchmarkResult arenaRow;
+    arenaRow.mode = "arena";
+    arenaRow.packs = packCount;
+    for (int i = 0; i < std::max(1, iterations); ++i) {
+        CatalogArena arena(CatalogArena::SizeForFile(static_cast<uintmax_t>(packCount) * 256));
+        auto start = std::chrono::steady_clock::now();
+        BuildCatalog(source, arena.Resource(), catalog);
+        const double buildMs = MillisSince(start);
+        const CatalogArenaStats stats = arena.GetStats();
+        arenaRow.heapAllocations = stats.blocks;
+        arenaRow.bytesRequested = stats.bytesRequested;
+        arenaRow.bytesReserved = stats.bytesReserved;
+
+        start = std::chrono::steady_clock::now();
+        catalog.clear();
+        arena.Release();
+        const double teardownMs = MillisSince(start);
+
+        arenaRow.buildMillis = (i == 0) ? buildMs : std::min(arenaRow.buildMillis, buildMs);
+        arenaRow.teardownMillis = (i == 0) ? teardownMs : std::min(arenaRow.teardownMillis, teardownMs);
+    }
+
+    return { heapRow, arenaRow };
+}
+
+std::string FormatCatalogBenchmarkResult(const CatalogBenchmarkResult& result)
+{
+    char buf[200];
+    std::snprintf(buf, sizeof(buf), "%-6s %9zu packs build %9.3f ms free %9.3f ms %9zu heap allocs %8.1f KB used %8.1f KB held",
+        result.mode.c_str(), result.packs, result.buildMillis, result.teardownMillis, result.heapAllocations,
+        result.bytesRequested / 1024.0, result.bytesReserved / 1024.0);
+    return buf;
+}
+
+// #detailed comments: RunCatalogIOBenchmark
+// Purpose: Numbers for the load paths SuiteSpot runs at startup and on
+// every scrape. Each read row parses the same text every iteration into
+// reused containers, as a reload does; the Prejump row builds a fresh
+// arena per iteration and so includes its teardown.
+std::vector<BenchmarkResult> RunCatalogIOBenchmark(size_t packCount, int iterations)
+{
+    std::vector<BenchmarkResult> results;
+    const auto addRow = [&](const char* name, size_t items, double ms, bool ok) {
+        BenchmarkResult r;
+        r.name = ok ? name : "MISMATCH";
+        r.items = items;
+        r.millis = ms;
+        r.itemsPerSec = ms > 0.0 ? static_cast<double>(items) * 1000.0 / ms : 0.0;
+        results.push_back(r);
+    };
+
+    // The generated malformed lines must be skipped and nothing else
+    const std::string trainingText = GenerateSyntheticTrainingFile(packCount);
+    const size_t malformed = packCount / kMalformedTrainingEvery;
+    std::vector<TrainingEntry> rows;
+    CatalogReadReport report;
+    double ms = BestMillis(iterations, [&]() {
+        std::istringstream in(trainingText);
+        report = ReadTrainingMaps(in, rows);
+    });
+    addRow("train-load", rows.size(), ms, report.skipped == malformed && rows.size() == packCount - malformed);
+
+    std::string written;
+    ms = BestMillis(iterations, [&]() {
+        std::ostringstream out;
+        WriteTrainingMaps(out, rows);
+        written = std::move(out).str();
+    });
+    std::vector<TrainingEntry> reread;
+    {
+        std::istringstream in(written);
+        ReadTrainingMaps(in, reread);
+    }
+    addRow("train-save", rows.size(), ms, reread.size() == rows.size());
+
+    TrainingCodeIndex index;
+    index.Reindex(TrainingCodeSource::Training, rows);
+    ShuffleBag bag(index);
+    for (const auto& row : rows) {
+        if (const auto code = TrainingCode::Parse(row.code)) bag.Add(*code, row.name);
+    }
+    std::string bagText;
+    ms = BestMillis(iterations, [&]() {
+        std::ostringstream out;
+        WriteShuffleBag(out, bag);
+        bagText = std::move(out).str();
+    });
+    addRow("bag-save", bag.Size(), ms, static_cast<size_t>(std::count(bagText.begin(), bagText.end(), '\n')) == bag.Size());
+
+    ShuffleBag loaded(index);
+    size_t added = 0;
+    ms = BestMillis(iterations, [&]() {
+        loaded.Clear();
+        std::istringstream in(bagText);
+        added = ReadShuffleBag(in, loaded);
+    });
+    addRow("bag-load", bag.Size(), ms, added == bag.Size());
+
+    const std::string prejumpJson = GenerateSyntheticPrejumpJson(packCount);
+    size_t packs = 0;
+    ms = BestMillis(iterations, [&]() {
+        CatalogArena arena(CatalogArena::SizeForFile(prejumpJson.size()));
+        std::vector<TrainingEntry> catalog;
+        std::istringstream in(prejumpJson);
+        ReadPrejumpPacks(in, arena, catalog);
+        packs = catalog.size();
+    });
+    addRow("prejump", packCount, ms, packs == packCount);
+
+    return results;
+}
+
+std::vector<BenchmarkResult> RunWorkshopDiscoveryBenchmark(const std::filesystem::path& root, size_t folders, int iterations)
+{
+    std::vector<BenchmarkResult> results;
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    const size_t maps = GenerateSyntheticWorkshopTree(root, folders);
+
+    size_t found = 0;
+    const double ms = BestMillis(iterations, [&]() { found = DiscoverWorkshopMaps({ root }).size(); });
+    std::filesystem::remove_all(root, ec);
+
+    BenchmarkResult r;
+    r.name = found == maps ? "workshop" : "MISMATCH";
+    r.items = folders;
+    r.millis = ms;
+    r.itemsPerSec = ms > 0.0 ? static_cast<double>(folders) * 1000.0 / ms : 0.0;
+    results.push_back(r);
+    return results;
+}
+
+// #detailed comments: RunShuffleBenchmark
+// Purpose: Cost of a full pass over a large bag. Every scheduler row draws
+// bagSize packs through Next(), so it includes building one rotation; the
+// draws are checked for repeats, which must never happen within a
+// rotation. The "legacy" row is the old mt19937 draw with replacement and
+// is only there for scale (it repeats packs freely).
+std::vector<BenchmarkResult> RunShuffleBenchmark(size_t bagSize, int iterations)
+{
+    std::vector<BenchmarkResult> results;
+    const auto packs = GenerateSyntheticPacks(bagSize);
+
+    TrainingCodeIndex index;
+    index.Reindex(TrainingCodeSource::Prejump, packs);
+    ShuffleBag bag(index);
+    for (const auto& pack : packs) {
+        if (const auto code = TrainingCode::Parse(pack.code)) bag.Add(*code, pack.name);
+    }
+    const size_t draws = bag.Size();
+
+    const auto addRow = [&](const char* name, double ms) {
+        BenchmarkResult r;
+        r.name = name;
+        r.items = draws;
+        r.millis = ms;
+        r.itemsPerSec = ms > 0.0 ? static_cast<double>(draws) * 1000.0 / ms : 0.0;
+        results.push_back(r);
+    };
+
+    std::mt19937 legacyRng(1);
+    size_t sink = 0;
+    addRow("legacy", BestMillis(iterations, [&]() {
+        std::uniform_int_distribution<int> dist(0, static_cast<int>(draws) - 1);
+        for (size_t i = 0; i < draws; ++i) sink += bag[dist(legacyRng)].code.Value() & 1;
+    }));
+
+    const ShuffleScheduler::PackLookup lookup = [&](TrainingCode code) -> const TrainingEntry* {
+        const int row = index.IndexOf(TrainingCodeSource::Prejump, code);
+        return row >= 0 ? &packs[row] : nullptr;
+    };
+    const std::pair<const char*, ShuffleScheduler::WeightMode> modes[] = {
+        { "rotation", ShuffleScheduler::WeightMode::Uniform },
+        { "weighted", ShuffleScheduler::WeightMode::Likes },
+    };
+    std::vector<TrainingCode> drawn;
+    drawn.reserve(draws);
+    for (const auto& [name, mode] : modes) {
+        const double ms = BestMillis(iterations, [&]() {
+            ShuffleScheduler scheduler;
+            scheduler.SetWeightMode(mode);
+            drawn.clear();
+            for (size_t i = 0; i < draws; ++i) {
+                if (const auto code = scheduler.Next(bag, lookup)) drawn.push_back(*code);
+            }
+        });
+        const std::unordered_set<TrainingCode, TrainingCodeHash> distinct(drawn.begin(), drawn.end());
+        addRow(distinct.size() == draws ? name : "REPEATED", ms);
+    }
+
+    std::vector<double> weights(draws);
+    for (size_t i = 0; i < draws; ++i) weights[i] = 1.0 + static_cast<double>(packs[i].likes);
+    AliasTable table;
+    table.Build(weights);
+    std::mt19937_64 aliasRng(1);
+    addRow("alias", BestMillis(iterations, [&]() {
+        for (size_t i = 0; i < draws; ++i) sink += table.Sample(aliasRng);
+    }));
+
+    (void)sink;
+    return results;
+}
+
+// #detailed comments: RunOverlayFrameBenchmark
+// Purpose: Before/after numbers for the retained overlay. Both rows sweep
+// the fade alpha across frames like a real fade-in; the retained row
+// builds its layout once up front (as the renderer does once per match).
+std::vector<BenchmarkResult> RunOverlayFrameBenchmark(size_t frames, int iterations)
+{
+    const PostMatchInfo info = SampleOverlayMatch();
+    const PostMatchLayoutStyle style = SampleOverlayStyle();
+    frames = std::max<size_t>(1, frames);
+
+    std::vector<BenchmarkResult> results;
+    const auto addRow = [&](const char* name, double ms) {
+        BenchmarkResult r;
+        r.name = name;
+        r.items = frames;
+        r.millis = ms;
+        r.itemsPerSec = ms > 0.0 ? static_cast<double>(frames) * 1000.0 / ms : 0.0;
+        r.speedup = (!results.empty() && ms > 0.0) ? results.front().millis / ms : 1.0;
+        results.push_back(r);
+    };
+
+    CountingDrawSink legacySink;
+    addRow("legacy", BestMillis(iterations, [&]() {
+        for (size_t f = 0; f < frames; ++f) {
+            LegacyOverlayFrame(info, style, static_cast<float>(f % 256) / 255.0f, legacySink);
+        }
+    }));
+
+    PostMatchLayout layout;
+    layout.Build(info, style);
+    CountingDrawSink retainedSink;
+    addRow("retained", BestMillis(iterations, [&]() {
+        for (size_t f = 0; f < frames; ++f) {
+            if (!layout.IsCurrent(info.sequence, style)) layout.Build(info, style);
+            layout.Emit(static_cast<float>(f % 256) / 255.0f, retainedSink);
+        }
+    }));
+
+    // Both paths must issue the same draw calls
+    if (legacySink.calls != retainedSink.calls || legacySink.chars != retainedSink.chars) {
+        results.back().name = "MISMATCH";
+    }
+
+    CountingDrawSink rebuildSink;
+    addRow("rebuild", BestMillis(iterations, [&]() {
+        for (size_t f = 0; f < frames; ++f) {
+            layout.Build(info, style);
+            layout.Emit(static_cast<float>(f % 256) / 255.0f, rebuildSink);
+        }
+    }));
+    return results;
+}
+
+// #detailed comments: RunFontAtlasBenchmark
+// Purpose: Before/after numbers for SDF text. The multi-size bitmap row is
+// the cost of crisp text without SDF: every distinct overlay size becomes
+// its own ImFont in the atlas. SDF rows bake once at 32px (4px range) and
+// 24px (3px range); either can be drawn at any overlay size.
+std::vector<FontAtlasBenchmarkResult> RunFontAtlasBenchmark(const std::vector<uint8_t>& ttf,
+    const std::vector<float>& overlaySizes, int iterations)
+{
+    std::vector<float> sizes;
+    for (const float size : overlaySizes) {
+        if (size > 0.0f && std::find(sizes.begin(), sizes.end(), size) == sizes.end()) sizes.push_back(size);
+    }
+    if (sizes.empty()) sizes.push_back(14.0f);
+
+    std::vector<FontAtlasBenchmarkResult> results;
+    const auto addRow = [&](const char* mode, const std::function<bool(FontAtlasBake&, std::string&)>& bake) {
+        FontAtlasBenchmarkResult row;
+        row.mode = mode;
+        FontAtlasBake atlas;
+        bool ok = true;
+        row.bakeMillis = BestMillis(iterations, [&]() { ok = bake(atlas, row.error) && ok; });
+        if (ok) {
+            row.sizes = atlas.sizes.size();
+            row.glyphs = atlas.glyphs.size();
+            row.width = atlas.width;
+            row.height = atlas.height;
+            row.alpha8Bytes = atlas.Alpha8Bytes();
+            row.rgba32Bytes = atlas.Rgba32Bytes();
+        }
+        results.push_back(row);
+    };
+
+    const std::vector<float> single = { sizes.front() };
+    addRow("bitmap", [&](FontAtlasBake& atlas, std::string& error) {
+        return BakeBitmapAtlas(ttf, single, 3, 1, atlas, error);
+    });
+    if (sizes.size() > 1) {
+        addRow("bitmap", [&](FontAtlasBake& atlas, std::string& error) {
+            return BakeBitmapAtlas(ttf, sizes, 3, 1, atlas, error);
+        });
+    }
+    addRow("sdf", [&](FontAtlasBake& atlas, std::string& error) {
+        return BakeSdfAtlas(ttf, 32.0f, 4, atlas, error);
+    });
+    addRow("sdf", [&](FontAtlasBake& atlas, std::string& error) {
+        return BakeSdfAtlas(ttf, 24.0f, 3, atlas, error);
+    });
+    return results;
+}
+
+std::string FormatFontAtlasBenchmarkResult(const FontAtlasBenchmarkResult& result)
+{
+    char buf[200];
+    if (!result.error.empty()) {
+        std::snprintf(buf, sizeof(buf), "%-6s failed: %s", result.mode.c_str(), result.error.c_str());
+    } else {
+        std::snprintf(buf, sizeof(buf), "%-6s %2zu sizes %4zu glyphs %4dx%-5d %8.1f KB alpha8 %8.1f KB rgba32 %9.3f ms bake",
+            result.mode.c_str(), result.sizes, result.glyphs, result.width, result.height,
+            result.alpha8Bytes / 1024.0, result.rgba32Bytes / 1024.0, result.bakeMillis);
+    }
+    return buf;
+}
+
+// #detailed comments: RunRenderAllocationBenchmark
+// Purpose: Allocation regressions in render paths as numbers. Each row
+// runs its path once to warm up (first-use capacity is not a per-frame
+// cost), then counts the calling thread's allocations over frames runs.
+// The legacy overlay row shows what the retained path removed; the
+// retained overlay and the timeline rebuild must stay at zero.
+std::vector<AllocationBenchmarkResult> RunRenderAllocationBenchmark(size_t frames)
+{
+    std::vector<AllocationBenchmarkResult> results;
+    if (!AllocTrackingEnabled()) return results;
+    frames = std::max<size_t>(1, frames);
+
+    const auto addRow = [&](const char* name, double budget, const std::function<void(size_t)>& frame) {
+        frame(0);
+        const AllocCounters before = ThreadAllocCounters();
+        for (size_t f = 0; f < frames; ++f) frame(f);
+        const AllocCounters used = ThreadAllocCounters() - before;
+
+        AllocationBenchmarkResult r;
+        r.name = name;
+        r.frames = frames;
+        r.allocsPerFrame = static_cast<double>(used.allocations) / frames;
+        r.bytesPerFrame = static_cast<double>(used.bytes) / frames;
+        r.budget = budget;
+        results.push_back(r);
+    };
+
+    const PostMatchInfo info = SampleOverlayMatch();
+    const PostMatchLayoutStyle style = SampleOverlayStyle();
+    CountingDrawSink sink;
+    addRow("overlay legacy", -1.0, [&](size_t f) {
+        LegacyOverlayFrame(info, style, static_cast<float>(f % 256) / 255.0f, sink);
+    });
+
+    PostMatchLayout layout;
+    layout.Build(info, style);
+    addRow("overlay retained", 0.0, [&](size_t f) {
+        if (!layout.IsCurrent(info.sequence, style)) layout.Build(info, style);
+        layout.Emit(static_cast<float>(f % 256) / 255.0f, sink);
+    });
+    addRow("overlay rebuild", -1.0, [&](size_t) { layout.Build(info, style); });
+
+    // A five-minute session sampled every second
+    std::vector<StatSample> samples(300);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i].t = static_cast<float>(i);
+        samples[i].playerCount = static_cast<uint8_t>(info.playerCount);
+        for (size_t p = 0; p < samples[i].playerCount && p < samples[i].players.size(); ++p) {
+            samples[i].players[p].team = static_cast<int8_t>(p % 2);
+            samples[i].players[p].score = static_cast<int16_t>(i * (p + 1) / 10);
+        }
+    }
+    StatTimelineSeries series;
+    addRow("timeline rebuild", 0.0, [&](size_t) { series.Build(samples); });
+
+    return results;
+}
+
+std::string FormatAllocationBenchmarkResult(const AllocationBenchmarkResult& result)
+{
+    char budget[32] = "-";
+    if (result.budget >= 0.0) std::snprintf(budget, sizeof(budget), "%.0f", result.budget);
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%-16s %7zu frames %9.2f allocs %10.0f B/frame  budget %-4s %s",
+        result.name.c_str(), result.frames, result.allocsPerFrame, result.bytesPerFrame, budget,
+        result.Passed() ? "ok" : "FAIL");
+    return buf;
+}
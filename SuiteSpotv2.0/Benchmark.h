@@ -0,0 +1,133 @@
+#pragma once
+
+#include "MapList.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Benchmark: Synthetic workloads for SuiteSpot's data paths
+//
+// Purpose: Measures catalog-scale operations against generated data so
+// regressions show up as numbers rather than dropped frames. Benchmarks are
+// triggered from console notifiers (see SuiteSpot::onLoad) and report one
+// result row per configuration through the returned vector.
+//
+// Threading: Benchmarks run on the calling thread (and the worker pools they
+// create). They allocate large catalogs, so run them from the console, not
+// from render callbacks.
+struct BenchmarkResult {
+    std::string name;        // Workload name, e.g. "filter"
+    size_t items = 0;        // Catalog size (or draws, rows, ...) per iteration
+    size_t threads = 1;      // Threads used by the measured path
+    double millis = 0.0;     // Best wall time per iteration
+    double itemsPerSec = 0.0;
+    double speedup = 1.0;    // Relative to the single-thread row of the same size
+};
+
+// One catalog build/teardown measurement (see RunCatalogAllocationBenchmark)
+struct CatalogBenchmarkResult {
+    std::string mode;              // "heap" (one allocation per string) or "arena"
+    size_t packs = 0;
+    double buildMillis = 0.0;      // Best time to build the catalog
+    double teardownMillis = 0.0;   // Best time to free it
+    size_t heapAllocations = 0;    // Heap allocations made by one build
+    size_t bytesRequested = 0;     // Bytes the strings and tag arrays asked for
+    size_t bytesReserved = 0;      // Heap bytes the built catalog holds
+};
+
+// One font atlas bake (see RunFontAtlasBenchmark)
+struct FontAtlasBenchmarkResult {
+    std::string mode;          // "bitmap" or "sdf"
+    size_t sizes = 0;          // Pixel sizes baked into the atlas
+    size_t glyphs = 0;
+    int width = 0;
+    int height = 0;
+    size_t alpha8Bytes = 0;    // Atlas as baked
+    size_t rgba32Bytes = 0;    // Atlas as the renderer uploads it
+    double bakeMillis = 0.0;   // Best rasterize + pack time
+    std::string error;         // Set when the bake failed
+};
+
+// Heap use of one render path (see RunRenderAllocationBenchmark)
+struct AllocationBenchmarkResult {
+    std::string name;
+    size_t frames = 0;
+    double allocsPerFrame = 0.0;
+    double bytesPerFrame = 0.0;
+    double budget = -1.0;  // Most allocations per frame allowed; negative = reported only
+
+    bool Passed() const { return budget < 0.0 || allocsPerFrame <= budget; }
+};
+
+// Deterministic catalog of count packs with realistic field spread
+// (difficulties, 0-4 tags from a fixed vocabulary, engagement counts)
+std::vector<TrainingEntry> GenerateSyntheticPacks(size_t count, uint32_t seed = 1);
+
+// The same kind of catalog as the files SuiteSpot reads, for CatalogIO.
+// The training file mixes in legacy "name (N)" lines (every 50th) and
+// malformed lines (every 500th) so the slow paths are part of the mix.
+std::string GenerateSyntheticTrainingFile(size_t count, uint32_t seed = 1);
+// prejump_packs.json in the scraper's layout
+std::string GenerateSyntheticPrejumpJson(size_t count, uint32_t seed = 1);
+// folders workshop folders under root, each holding a .upk among other
+// files; every 10th folder has no map. Returns the number of maps created.
+size_t GenerateSyntheticWorkshopTree(const std::filesystem::path& root, size_t folders, uint32_t seed = 1);
+
+// Filter + sort throughput for 1..maxThreads threads at each catalog size
+std::vector<BenchmarkResult> RunFilterScalingBenchmark(const std::vector<size_t>& sizes, size_t maxThreads, int iterations = 3);
+
+// "filter      100000 packs  4 thr    12.31 ms   8.1M/s  3.52x"
+std::string FormatBenchmarkResult(const BenchmarkResult& result);
+
+// Builds and frees a packCount catalog with per-string heap allocation and
+// with a CatalogArena; heap block counts stand in for heap fragmentation
+std::vector<CatalogBenchmarkResult> RunCatalogAllocationBenchmark(size_t packCount, int iterations = 3);
+
+std::string FormatCatalogBenchmarkResult(const CatalogBenchmarkResult& result);
+
+// Parse and write cost of SuiteSpot's catalog files for packCount packs:
+// training file read/write, shuffle bag read/write and the Prejump JSON
+// load into an arena. Files are in memory, so disk speed is not measured.
+// items counts the packs each row handles; the training file's malformed
+// lines are expected to be skipped and are not counted, so train-load and
+// train-save report the same number. A row whose output does not
+// round-trip, or that skips any other line, is renamed MISMATCH.
+std::vector<BenchmarkResult> RunCatalogIOBenchmark(size_t packCount, int iterations = 3);
+
+// Workshop discovery over a generated tree of folders under root, which
+// is created for the run and removed afterwards. items counts folders.
+std::vector<BenchmarkResult> RunWorkshopDiscoveryBenchmark(const std::filesystem::path& root, size_t folders, int iterations = 3);
+
+// Shuffle draws over a bagSize bag: the legacy uniform draw with
+// replacement, then ShuffleScheduler rotations (uniform and likes-weighted)
+// and raw AliasTable sampling. items counts draws per iteration.
+std::vector<BenchmarkResult> RunShuffleBenchmark(size_t bagSize, int iterations = 3);
+
+// Per-frame cost of the post-match overlay for a full 4v4 result: the old
+// immediate path (strings, to_string, HSV per frame) against the retained
+// PostMatchLayout. Draw calls go to a counting sink, so only the overlay's
+// own CPU work is measured. A third row rebuilds the layout every frame,
+// which is the retained path's worst case. items counts frames.
+std::vector<BenchmarkResult> RunOverlayFrameBenchmark(size_t frames, int iterations = 3);
+
+// Atlas memory and bake time for the overlay's text: one bitmap size (what
+// AddText scales today), one bitmap size per overlay size (crisp text the
+// ImGui way), and single-size SDF atlases that serve every size
+std::vector<FontAtlasBenchmarkResult> RunFontAtlasBenchmark(const std::vector<uint8_t>& ttf,
+    const std::vector<float>& overlaySizes, int iterations = 3);
+
+std::string FormatFontAtlasBenchmarkResult(const FontAtlasBenchmarkResult& result);
+
+// Heap allocations per frame of the render paths that run without ImGui:
+// the overlay (legacy, retained, and a layout rebuild) and the timeline
+// series rebuild. Counted by AllocTracker on the calling thread, after one
+// warm-up frame. Paths that are meant to be allocation-free carry a budget
+// of zero, so a regression fails its row. Empty unless
+// SUITESPOT_ALLOC_TRACKING; the ImGui panels are measured in game through
+// the profiler window instead.
+std::vector<AllocationBenchmarkResult> RunRenderAllocationBenchmark(size_t frames);
+
+// "overlay retained    1000 frames      0.00 allocs          0 B/frame  budget 0    ok"
+std::string FormatAllocationBenchmarkResult(const AllocationBenchmarkResult& result);
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include "BulkImport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+
+namespace
+{
+    // Lines per parse chunk; inputs with fewer lines are parsed inline
+    constexpr size_t kChunkLines = 4096;
+
+    std::string_view TrimView(std::string_view s)
+    {
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+        return s;
+    }
+
+    // "Shots:12", "shots: 12" or a bare "12"
+    int ParseShots(std::string_view field)
+    {
+        field = TrimView(field);
+        if (field.size() >= 6 && std::equal(field.begin(), field.begin() + 6, "shots:",
+                [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+            field = TrimView(field.substr(6));
+        }
+        int shots = 0;
+        for (char c : field) {
+            if (c < '0' || c > '9') return 0;
+            shots = std::min(shots * 10 + (c - '0'), 100000);
+        }
+        return shots;
+    }
+
+    struct ChunkResult {
+        std::vector<BulkImportEntry> entries;
+        std::vector<int> invalidLines;
+        size_t lines = 0;
+    };
+
+    void ParseLines(std::string_view text, const std::vector<size_t>& starts, size_t first, size_t last, ChunkResult& out)
+    {
+        for (size_t i = first; i < last; ++i) {
+            const size_t begin = starts[i];
+            const size_t end = (i + 1 < starts.size()) ? starts[i + 1] - 1 : text.size();
+            std::string_view line = TrimView(text.substr(begin, end - begin));
+            if (line.empty() || line.front() == '#') continue;
+            ++out.lines;
+
+            const auto comma = line.find(',');
+            const auto code = TrainingCode::Parse(line.substr(0, comma));
+            if (!code) {
+                out.invalidLines.push_back(static_cast<int>(i + 1));
+                continue;
+            }
+
+            BulkImportEntry entry;
+            entry.code = *code;
+            entry.line = static_cast<int>(i + 1);
+            if (comma != std::string_view::npos) {
+                std::string_view rest = line.substr(comma + 1);
+                const auto shotsComma = rest.find(',');
+                entry.name = std::string(TrimView(rest.substr(0, shotsComma)));
+                if (shotsComma != std::string_view::npos) entry.shots = ParseShots(rest.substr(shotsComma + 1));
+            }
+            out.entries.push_back(std::move(entry));
+        }
+    }
+}
+
+// #detailed comments: ParseBulkImport
+// Purpose: Split text into lines, parse them in chunks (in parallel when a
+// pool is given and the input is large), then merge the chunks in order,
+// keeping the first occurrence of each code.
+BulkImportResult ParseBulkImport(std::string_view text, WorkerPool* pool)
+{
+    std::vector<size_t> starts;
+    starts.push_back(0);
+    for (const char* p = text.data(), *end = text.data() + text.size();
+         (p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr; ++p) {
+        starts.push_back(static_cast<size_t>(p - text.data()) + 1);
+    }
+
+    const size_t chunkCount = (starts.size() + kChunkLines - 1) / kChunkLines;
+    std::vector<ChunkResult> chunks(chunkCount);
+    const auto parseChunk = [&](size_t chunk) {
+        const size_t first = chunk * kChunkLines;
+        ParseLines(text, starts, first, std::min(first + kChunkLines, starts.size()), chunks[chunk]);
+    };
+    if (pool && chunkCount > 1) {
+        pool->ParallelFor(chunkCount, parseChunk);
+    } else {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) parseChunk(chunk);
+    }
+
+    BulkImportResult result;
+    std::unordered_set<TrainingCode, TrainingCodeHash> seen;
+    for (auto& chunk : chunks) {
+        result.lines += chunk.lines;
+        result.invalid += chunk.invalidLines.size();
+        for (int line : chunk.invalidLines) {
+            if (result.invalidLines.size() >= BulkImportResult::kMaxReportedLines) break;
+            result.invalidLines.push_back(line);
+        }
+        for (auto& entry : chunk.entries) {
+            if (!seen.insert(entry.code).second) {
+                ++result.duplicates;
+                continue;
+            }
+            result.entries.push_back(std::move(entry));
+        }
+    }
+    return result;
+}
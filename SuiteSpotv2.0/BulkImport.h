@@ -0,0 +1,51 @@
+#pragma once
+
+#include "TrainingCode.h"
+#include "WorkerPool.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One valid line of a bulk import
+struct BulkImportEntry {
+    TrainingCode code;
+    std::string name;  // empty when the line only had a code
+    int shots = 0;     // 0 when the line had no shot count
+    int line = 0;      // 1-based line in the source text
+};
+
+// What ParseBulkImport found; nothing has been applied yet
+struct BulkImportResult {
+    static constexpr size_t kMaxReportedLines = 10;
+
+    std::vector<BulkImportEntry> entries;  // first occurrence of each code, in source order
+    size_t lines = 0;                      // lines that were not blank or comments
+    size_t invalid = 0;                    // lines whose code does not parse
+    size_t duplicates = 0;                 // lines repeating an earlier code
+    std::vector<int> invalidLines;         // first kMaxReportedLines invalid line numbers
+};
+
+// BulkImport: Parser for pasted or file-based lists of training packs
+//
+// Purpose: Backs the bulk console commands (ss_bag_add, ss_bag_import,
+// ss_training_import). Parsing and validation are separated from applying
+// so a command can check thousands of lines first and then change the bag
+// or training list once, with a single save.
+//
+// Accepted lines use the training file layout, with everything after the
+// code optional:
+//   555F-7503-BBB9-E1E3,Wall Shots,Shots:10
+//   555f7503bbb9e1e3, Wall Shots
+//   555F-7503-BBB9-E1E3
+// Blank lines and lines starting with '#' are skipped. Codes are accepted
+// in any form TrainingCode::Parse accepts.
+//
+// Large inputs are split into line chunks and parsed on the pool; the
+// merge that drops duplicate codes runs afterwards on the calling thread,
+// so the result is identical to a serial parse.
+//
+// Usage Example:
+//   BulkImportResult parsed = ParseBulkImport(fileText, &pool);
+//   for (const auto& entry : parsed.entries) bag.Add(entry.code, entry.name);
+BulkImportResult ParseBulkImport(std::string_view text, WorkerPool* pool = nullptr);
@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "CatalogArena.h"
+
+#include <algorithm>
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void* p = upstream_->allocate(bytes, alignment);
+    ++allocations_;
+    ++liveBlocks_;
+    bytes_ += bytes;
+    liveBytes_ += bytes;
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    upstream_->deallocate(p, bytes, alignment);
+    if (liveBlocks_ > 0) --liveBlocks_;
+    liveBytes_ -= std::min(liveBytes_, bytes);
+}
+
+CatalogArena::CatalogArena(size_t initialBytes)
+    : heap_(std::pmr::new_delete_resource())
+    , arena_(std::max<size_t>(initialBytes, 1), &heap_)
+    , front_(&arena_)
+{
+}
+
+void CatalogArena::Release()
+{
+    arena_.release();
+    front_.ResetCounters();
+}
+
+CatalogArenaStats CatalogArena::GetStats() const
+{
+    CatalogArenaStats stats;
+    stats.allocations = front_.GetAllocationCount();
+    stats.bytesRequested = front_.GetBytesAllocated();
+    stats.blocks = heap_.GetLiveBlocks();
+    stats.bytesReserved = heap_.GetLiveBytes();
+    return stats;
+}
+
+size_t CatalogArena::SizeForFile(uintmax_t fileBytes)
+{
+    // Small catalogs still get a useful first block; huge files are capped
+    // and the arena grows geometrically from there
+    constexpr uintmax_t kMinBytes = 64 * 1024;
+    constexpr uintmax_t kMaxBytes = 256ull * 1024 * 1024;
+    return static_cast<size_t>(std::clamp(fileBytes, kMinBytes, kMaxBytes));
+}
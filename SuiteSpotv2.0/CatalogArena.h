@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// CountingResource: Pass-through memory resource that counts traffic
+//
+// Purpose: Wraps another resource and records how many allocations it
+// served and how many are still live. Used to measure the catalog arena
+// and, wrapped around the plain heap, to measure the old per-string
+// allocation pattern for comparison.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    size_t GetAllocationCount() const { return allocations_; }
+    size_t GetBytesAllocated() const { return bytes_; }
+    size_t GetLiveBlocks() const { return liveBlocks_; }
+    size_t GetLiveBytes() const { return liveBytes_; }
+    void ResetCounters() { allocations_ = 0; bytes_ = 0; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    size_t allocations_ = 0;
+    size_t bytes_ = 0;
+    size_t liveBlocks_ = 0;
+    size_t liveBytes_ = 0;
+};
+
+struct CatalogArenaStats {
+    size_t allocations = 0;     // individual string/array requests served
+    size_t bytesRequested = 0;  // sum of those requests
+    size_t blocks = 0;          // large blocks currently held from the heap
+    size_t bytesReserved = 0;   // total size of those blocks
+};
+
+// CatalogArena: Monotonic arena for one loaded catalog
+//
+// Purpose: Every string and tag array of a catalog is carved out of a few
+// large heap blocks instead of one heap allocation each. Individual frees
+// are no-ops; the whole catalog is returned to the heap in one Release()
+// (or when the arena is destroyed), so a reload no longer walks and frees
+// tens of thousands of small blocks on the game process heap.
+//
+// Lifetime: entries built on Resource() must be destroyed before the
+// arena. Copies of those entries are safe to keep, since TrainingEntry
+// copies allocate from the default heap (see MapList.h).
+//
+// Usage Example:
+//   auto arena = std::make_unique<CatalogArena>(CatalogArena::SizeForFile(bytes));
+//   TrainingEntry entry(arena->Resource());
+//   entry.name = "Wall Reads";   // stored in the arena
+class CatalogArena
+{
+public:
+    explicit CatalogArena(size_t initialBytes);
+
+    CatalogArena(const CatalogArena&) = delete;
+    CatalogArena& operator=(const CatalogArena&) = delete;
+
+    std::pmr::memory_resource* Resource() { return &front_; }
+
+    // Returns every block to the heap at once
+    void Release();
+
+    CatalogArenaStats GetStats() const;
+
+    // First block size for a catalog file of fileBytes: the JSON text is
+    // a close upper bound on the string payload it produces
+    static size_t SizeForFile(uintmax_t fileBytes);
+
+private:
+    CountingResource heap_;                      // counts blocks taken from the heap
+    std::pmr::monotonic_buffer_resource arena_;  // bump allocator over heap_
+    CountingResource front_;                     // counts requests served by arena_
+};
@@ -0,0 +1,359 @@
+#include "pch.h"
+#include "CatalogIO.h"
+#include "CatalogArena.h"
+#include "ShuffleBag.h"
+#include "TrainingCode.h"
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+
+// #detailed comments: CatalogIO helpers
+// Moved here with the parsers from SuiteSpot.cpp's helper namespace and
+// kept internal for the same reason: the trimming and legacy shot-count
+// rules are what existing user files were written against. Maintain
+// exact semantics.
+namespace
+{
+    std::string Trim(const std::string& value)
+    {
+        const auto first = value.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos)
+        {
+            return {};
+        }
+        const auto last = value.find_last_not_of(" \t\r\n");
+        return value.substr(first, last - first + 1);
+    }
+
+    int CaseInsensitiveCompare(std::string_view a, std::string_view b)
+    {
+        const size_t len = std::min(a.size(), b.size());
+        for (size_t i = 0; i < len; ++i)
+        {
+            const unsigned char ca = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(a[i])));
+            const unsigned char cb = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(b[i])));
+            if (ca < cb) return -1;
+            if (ca > cb) return 1;
+        }
+
+        if (a.size() < b.size()) return -1;
+        if (a.size() > b.size()) return 1;
+        return 0;
+    }
+
+    bool StartsWithCaseInsensitive(const std::string& value, const std::string& prefix)
+    {
+        if (value.size() < prefix.size()) return false;
+        for (size_t i = 0; i < prefix.size(); ++i)
+        {
+            if (std::tolower(static_cast<unsigned char>(value[i])) != std::tolower(static_cast<unsigned char>(prefix[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int ParseTrailingShots(const std::string& nameField)
+    {
+        // Legacy format: "Name (#)" or "Name( # )"
+        const auto openPos = nameField.find_last_of('(');
+        const auto closePos = nameField.find_last_of(')');
+        if (openPos == std::string::npos || closePos == std::string::npos || closePos <= openPos) {
+            return 0;
+        }
+        std::string inside = Trim(nameField.substr(openPos + 1, closePos - openPos - 1));
+        // Expect something like "12" or "Shots:12" but in legacy it was just number.
+        if (StartsWithCaseInsensitive(inside, "shots")) {
+            auto colonPos = inside.find(':');
+            if (colonPos != std::string::npos) {
+                inside = Trim(inside.substr(colonPos + 1));
+            }
+        }
+        try {
+            return std::max(0, std::stoi(inside));
+        } catch (...) {
+            return 0;
+        }
+    }
+
+    std::string LineNote(size_t lineNum, const std::string& text)
+    {
+        return "line " + std::to_string(lineNum) + ": " + text;
+    }
+
+    // Copies a string field into target when present and a string
+    template <typename Target>
+    void ReadStringField(const nlohmann::json& pack, const char* key, Target& target)
+    {
+        const auto it = pack.find(key);
+        if (it != pack.end() && it->is_string()) {
+            target = it->template get_ref<const std::string&>();
+        }
+    }
+
+    void ReadIntField(const nlohmann::json& pack, const char* key, int& target)
+    {
+        const auto it = pack.find(key);
+        if (it != pack.end() && it->is_number()) {
+            target = it->get<int>();
+        }
+    }
+}
+
+void SortTrainingRows(std::vector<TrainingEntry>& rows)
+{
+    std::stable_sort(rows.begin(), rows.end(),
+        [](const TrainingEntry& lhs, const TrainingEntry& rhs)
+        {
+            return CaseInsensitiveCompare(lhs.name, rhs.name) < 0;
+        });
+}
+
+// #detailed comments: ReadTrainingMaps
+// Purpose: The permissive training-file parser. Lines are split on commas
+// and each part trimmed. With only two parts, a trailing "(N)" on the name
+// is the legacy shot count: it is stripped from the name and flagged so
+// the caller can rewrite the file. A bad line is skipped with a note rather
+// than failing the load, so one damaged line never empties the list.
+CatalogReadReport ReadTrainingMaps(std::istream& in, std::vector<TrainingEntry>& rows)
+{
+    CatalogReadReport report;
+    rows.clear();
+
+    std::string line;
+    size_t lineNum = 0;
+    std::vector<std::string> parts;
+    while (std::getline(in, line)) {
+        lineNum++;
+        if (line.empty()) continue;
+        ++report.lines;
+
+        // Expected format: code, Name, Shots:#  (shots optional for backward compatibility)
+        parts.clear();
+        size_t start = 0;
+        while (start <= line.size())
+        {
+            const auto commaPos = line.find(',', start);
+            if (commaPos == std::string::npos)
+            {
+                parts.push_back(Trim(line.substr(start)));
+                break;
+            }
+            parts.push_back(Trim(line.substr(start, commaPos - start)));
+            start = commaPos + 1;
+        }
+
+        if (parts.size() < 2) {
+            report.problems.push_back(LineNote(lineNum, "malformed entry '" + line + "' - expected 'code,name'"));
+            ++report.skipped;
+            continue;
+        }
+
+        std::string code = TrainingCode::Normalize(parts[0]);
+        std::string name = parts[1];
+        int shots = 0;
+
+        if (code.empty()) {
+            report.problems.push_back(LineNote(lineNum, "invalid training code '" + parts[0] + "'"));
+            ++report.skipped;
+            continue;
+        }
+
+        // Legacy: shots embedded in name "(#)" when only 2 parts existed.
+        if (parts.size() == 2) {
+            shots = ParseTrailingShots(name);
+            if (shots > 0) {
+                report.sawLegacyFormat = true;
+            }
+            // strip trailing "(#)" from name if present
+            const auto openPos = name.find_last_of('(');
+            const auto closePos = name.find_last_of(')');
+            if (openPos != std::string::npos && closePos != std::string::npos && closePos > openPos) {
+                name = Trim(name.substr(0, openPos));
+            }
+        }
+
+        if (parts.size() >= 3) {
+            const std::string& shotsPart = parts[2];
+            if (StartsWithCaseInsensitive(shotsPart, "shots:")) {
+                auto valStr = Trim(shotsPart.substr(6));
+                try {
+                    shots = std::stoi(valStr);
+                } catch (const std::invalid_argument&) {
+                    report.problems.push_back(LineNote(lineNum, "invalid shot count '" + valStr + "'"));
+                    shots = 0;
+                } catch (const std::out_of_range&) {
+                    report.problems.push_back(LineNote(lineNum, "shot count out of range '" + valStr + "'"));
+                    shots = 0;
+                }
+            }
+        }
+
+        if (!name.empty()) {
+            TrainingEntry entry(code, name);
+            entry.shotCount = shots;
+            rows.push_back(std::move(entry));
+        } else {
+            report.problems.push_back(LineNote(lineNum, "empty name"));
+            ++report.skipped;
+        }
+    }
+
+    SortTrainingRows(rows);
+    return report;
+}
+
+void WriteTrainingMaps(std::ostream& out, const std::vector<TrainingEntry>& rows)
+{
+    // Sort row pointers rather than copying every entry
+    std::vector<const TrainingEntry*> sorted;
+    sorted.reserve(rows.size());
+    for (const auto& e : rows) sorted.push_back(&e);
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const TrainingEntry* lhs, const TrainingEntry* rhs)
+        {
+            return CaseInsensitiveCompare(lhs->name, rhs->name) < 0;
+        });
+    for (const TrainingEntry* e : sorted) {
+        out << e->code << "," << e->name << ",Shots:" << e->shotCount << "\n";
+    }
+}
+
+size_t ReadShuffleBag(std::istream& in, ShuffleBag& bag)
+{
+    size_t added = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        auto pos = line.find(',');
+        if (pos == std::string::npos) continue;
+        const auto code = TrainingCode::Parse(std::string_view(line).substr(0, pos));
+        std::string name = Trim(line.substr(pos + 1));
+        if (code && !name.empty() && bag.Add(*code, name)) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+void WriteShuffleBag(std::ostream& out, const ShuffleBag& bag)
+{
+    for (const auto& item : bag.Items()) {
+        out << item.code.ToString() << "," << item.name << "\n";
+    }
+}
+
+// #detailed comments: ReadPrejumpPacks
+// Purpose: Builds one TrainingEntry per pack that has a valid code and a
+// name, reading optional metadata only when its type matches, so a
+// scraper change in one field does not drop the pack. Entries are built
+// directly in the arena; the DOM itself is transient.
+CatalogReadReport ReadPrejumpPacks(std::istream& in, CatalogArena& arena, std::vector<TrainingEntry>& rows)
+{
+    CatalogReadReport report;
+    rows.clear();
+    try {
+        nlohmann::json jsonData;
+        in >> jsonData;
+
+        const auto packs = jsonData.find("packs");
+        if (packs == jsonData.end() || !packs->is_array()) {
+            report.error = "invalid file format - missing 'packs' array";
+            return report;
+        }
+
+        rows.reserve(packs->size());
+        for (const auto& pack : *packs) {
+            ++report.lines;
+            if (!pack.is_object()) {
+                ++report.skipped;
+                continue;
+            }
+            TrainingEntry entry(arena.Resource());
+
+            // Required fields; invalid codes normalize to empty
+            if (const auto code = pack.find("code"); code != pack.end() && code->is_string()) {
+                entry.code = TrainingCode::Normalize(code->get_ref<const std::string&>());
+            }
+            ReadStringField(pack, "name", entry.name);
+            if (entry.code.empty() || entry.name.empty()) {
+                ++report.skipped;
+                continue;
+            }
+
+            // Optional Prejump metadata
+            ReadStringField(pack, "creator", entry.creator);
+            ReadStringField(pack, "creatorSlug", entry.creatorSlug);
+            ReadStringField(pack, "difficulty", entry.difficulty);
+            ReadIntField(pack, "shotCount", entry.shotCount);
+            ReadStringField(pack, "staffComments", entry.staffComments);
+            ReadStringField(pack, "notes", entry.notes);
+            ReadStringField(pack, "videoUrl", entry.videoUrl);
+            ReadIntField(pack, "likes", entry.likes);
+            ReadIntField(pack, "plays", entry.plays);
+            ReadIntField(pack, "status", entry.status);
+
+            if (const auto tags = pack.find("tags"); tags != pack.end() && tags->is_array()) {
+                for (const auto& tag : *tags) {
+                    if (tag.is_string()) {
+                        entry.tags.emplace_back(tag.get_ref<const std::string&>());
+                    }
+                }
+            }
+
+            rows.push_back(std::move(entry));
+        }
+    } catch (const std::exception& e) {
+        rows.clear();
+        report.error = e.what();
+    }
+    return report;
+}
+
+std::vector<WorkshopEntry> DiscoverWorkshopMaps(const std::vector<std::filesystem::path>& roots)
+{
+    std::vector<WorkshopEntry> maps;
+    std::unordered_set<std::string> seen;
+    std::error_code ec;
+    for (const auto& root : roots) {
+        if (root.empty()) continue;
+        if (!std::filesystem::exists(root, ec) || !std::filesystem::is_directory(root, ec)) continue;
+        for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+            if (ec) { ec.clear(); continue; }
+            if (!entry.is_directory(ec)) continue;
+
+            // Look for any .upk file in the directory
+            std::string foundMapFile;
+            for (const auto& file : std::filesystem::directory_iterator(entry.path(), ec)) {
+                if (ec) { ec.clear(); continue; }
+                if (!file.is_regular_file(ec)) continue;
+                if (file.path().extension() == ".upk") {
+                    foundMapFile = file.path().string();
+                    break;
+                }
+            }
+
+            if (!foundMapFile.empty() && seen.insert(foundMapFile).second) {
+                maps.push_back({ std::move(foundMapFile), entry.path().filename().string() });
+            }
+        }
+    }
+
+    std::sort(maps.begin(), maps.end(),
+        [](const WorkshopEntry& lhs, const WorkshopEntry& rhs)
+        {
+            const int cmp = CaseInsensitiveCompare(lhs.name, rhs.name);
+            if (cmp == 0)
+            {
+                return lhs.filePath < rhs.filePath;
+            }
+            return cmp < 0;
+        });
+    return maps;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "MapList.h"
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class CatalogArena;
+class ShuffleBag;
+
+// Outcome of reading one catalog file
+struct CatalogReadReport {
+    size_t lines = 0;                    // Non-empty lines (training file) or packs (Prejump) seen
+    size_t skipped = 0;                  // Rows dropped as malformed
+    bool sawLegacyFormat = false;        // Training file had "Name (N)" shot counts; rewrite it
+    std::vector<std::string> problems;   // One "line N: ..." note per dropped row or bad field
+    std::string error;                   // Set when the file as a whole could not be read
+
+    bool Ok() const { return error.empty(); }
+};
+
+// CatalogIO: SuiteSpot's file formats, without the plugin
+//
+// Purpose: The parsers and writers for SuiteTraining's files and the
+// workshop scan, on plain streams and paths so they build outside the game
+// (the headless benchmark in CMakeLists.txt links them). SuiteSpot owns
+// paths, logging and reindexing; these functions only turn bytes into rows
+// and back. Nothing here logs: problems come back in the report and the
+// caller decides what is worth a log line.
+//
+// Threading: No shared state; each call touches only its arguments.
+//
+// Usage Example:
+//   std::ifstream in(GetTrainingFilePath());
+//   const CatalogReadReport report = ReadTrainingMaps(in, RLTraining);
+//   for (const auto& problem : report.problems) DEBUGLOG("SuiteSpot: {}", problem);
+
+// The training list's order: case-insensitive by name, stable
+void SortTrainingRows(std::vector<TrainingEntry>& rows);
+
+// SuiteSpotTrainingMaps.txt: "code,name,Shots:N" lines; legacy "code,name (N)"
+// lines are accepted and flagged. Replaces rows with the valid lines, sorted.
+CatalogReadReport ReadTrainingMaps(std::istream& in, std::vector<TrainingEntry>& rows);
+// Writes rows sorted, in the canonical format
+void WriteTrainingMaps(std::ostream& out, const std::vector<TrainingEntry>& rows);
+
+// SuiteShuffleBag.txt: "code,name" lines. Adds every valid line to bag
+// (which the caller clears first) and returns how many were added.
+size_t ReadShuffleBag(std::istream& in, ShuffleBag& bag);
+void WriteShuffleBag(std::ostream& out, const ShuffleBag& bag);
+
+// prejump_packs.json as written by the scraper. Every string is allocated
+// from arena, which must outlive rows. On error (bad JSON, no "packs"
+// array) rows is left empty and report.error says why.
+CatalogReadReport ReadPrejumpPacks(std::istream& in, CatalogArena& arena, std::vector<TrainingEntry>& rows);
+
+// One entry per folder under each root that holds a .upk, first .upk wins.
+// Missing roots are skipped; a path found under two roots is kept once.
+// Sorted case-insensitively by folder name, then by path.
+std::vector<WorkshopEntry> DiscoverWorkshopMaps(const std::vector<std::filesystem::path>& roots);
@@ -0,0 +1,227 @@
+#include "pch.h"
+#include "FontAtlasBake.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Private copies of the vendored stb libraries, configured like
+// imgui_draw.cpp's (static, so they cannot clash with ImGui's own)
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "IMGUI/imstb_rectpack.h"
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "IMGUI/imstb_truetype.h"
+
+namespace
+{
+    constexpr int kGlyphPadding = 1;          // ImFontAtlas::TexGlyphPadding
+    constexpr int kMaxAtlasHeight = 1024 * 32;
+    constexpr uint8_t kSdfOnEdge = 128;
+
+    bool InitFont(const std::vector<uint8_t>& ttf, stbtt_fontinfo& info, std::string& error)
+    {
+        const int offset = ttf.empty() ? -1 : stbtt_GetFontOffsetForIndex(ttf.data(), 0);
+        if (offset < 0 || !stbtt_InitFont(&info, ttf.data(), offset)) {
+            error = "not a TrueType font";
+            return false;
+        }
+        return true;
+    }
+
+    // #detailed comments: PackRects
+    // Purpose: ImFontAtlasBuildWithStbTruetype's layout. The width comes
+    // from the total glyph area (512..4096), rects are packed top-down and
+    // the height is the used height rounded up to a power of two.
+    bool PackRects(std::vector<stbrp_rect>& rects, int& width, int& height, std::string& error)
+    {
+        size_t area = 0;
+        for (const auto& r : rects) area += static_cast<size_t>(r.w) * r.h;
+        const float side = std::sqrt(static_cast<float>(area)) + 1.0f;
+        width = side >= 4096 * 0.7f ? 4096 : side >= 2048 * 0.7f ? 2048 : side >= 1024 * 0.7f ? 1024 : 512;
+
+        std::vector<stbrp_node> nodes(width);
+        stbrp_context context;
+        stbrp_init_target(&context, width, kMaxAtlasHeight, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        int used = 1;
+        for (const auto& r : rects) {
+            if (!r.was_packed) {
+                error = "atlas overflow";
+                return false;
+            }
+            used = std::max(used, r.y + r.h);
+        }
+        height = 1;
+        while (height < used) height <<= 1;
+        return true;
+    }
+}
+
+const FontBakeGlyph* FontAtlasBake::Find(uint32_t codepoint, float size) const
+{
+    for (const auto& glyph : glyphs) {
+        if (glyph.codepoint == codepoint && glyph.size == size) return &glyph;
+    }
+    return nullptr;
+}
+
+const std::vector<uint32_t>& FontBakeCodepoints()
+{
+    static const std::vector<uint32_t> codepoints = [] {
+        std::vector<uint32_t> list;
+        for (uint32_t c = 0x20; c <= 0x7E; ++c) list.push_back(c);
+        list.push_back(0x2605);
+        return list;
+    }();
+    return codepoints;
+}
+
+// #detailed comments: BakeBitmapAtlas
+// Purpose: What ImGui would build if the overlay added one font per size.
+// Each glyph's rect is oversampled (3x1 by default) and prefiltered like
+// stbtt_PackFontRangesRenderIntoRects. Codepoints the font lacks are
+// skipped rather than baked as the missing-glyph box.
+bool BakeBitmapAtlas(const std::vector<uint8_t>& ttf, const std::vector<float>& sizes,
+                     int oversampleH, int oversampleV, FontAtlasBake& out, std::string& error)
+{
+    out = FontAtlasBake();
+    out.mode = FontAtlasBake::Mode::Bitmap;
+    out.sizes = sizes;
+
+    stbtt_fontinfo info;
+    if (!InitFont(ttf, info, error)) return false;
+    oversampleH = std::clamp(oversampleH, 1, 8);
+    oversampleV = std::clamp(oversampleV, 1, 8);
+
+    struct Pending { int glyphIndex; float scale; };
+    std::vector<Pending> pending;
+    std::vector<stbrp_rect> rects;
+    for (const float size : sizes) {
+        const float scale = stbtt_ScaleForPixelHeight(&info, size);
+        for (const uint32_t cp : FontBakeCodepoints()) {
+            const int glyphIndex = stbtt_FindGlyphIndex(&info, static_cast<int>(cp));
+            if (glyphIndex == 0) continue;
+
+            int advance = 0, bearing = 0, x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+            stbtt_GetGlyphHMetrics(&info, glyphIndex, &advance, &bearing);
+            stbtt_GetGlyphBitmapBoxSubpixel(&info, glyphIndex, scale * oversampleH, scale * oversampleV, 0.0f, 0.0f, &x0, &y0, &x1, &y1);
+
+            FontBakeGlyph glyph;
+            glyph.codepoint = cp;
+            glyph.size = size;
+            glyph.advance = advance * scale;
+            if (x1 > x0 && y1 > y0) {
+                glyph.w = x1 - x0 + oversampleH - 1;
+                glyph.h = y1 - y0 + oversampleV - 1;
+                glyph.xoff = static_cast<float>(x0) / oversampleH;
+                glyph.yoff = static_cast<float>(y0) / oversampleV;
+
+                stbrp_rect rect = {};
+                rect.id = static_cast<int>(out.glyphs.size());
+                rect.w = static_cast<stbrp_coord>(glyph.w + kGlyphPadding);
+                rect.h = static_cast<stbrp_coord>(glyph.h + kGlyphPadding);
+                rects.push_back(rect);
+            }
+            out.glyphs.push_back(glyph);
+            pending.push_back({ glyphIndex, scale });
+        }
+    }
+
+    if (!PackRects(rects, out.width, out.height, error)) return false;
+    out.pixels.assign(out.Alpha8Bytes(), 0);
+    for (const auto& rect : rects) {
+        FontBakeGlyph& glyph = out.glyphs[rect.id];
+        const Pending& p = pending[rect.id];
+        glyph.x = rect.x;
+        glyph.y = rect.y;
+
+        float subX = 0.0f, subY = 0.0f;
+        stbtt_MakeGlyphBitmapSubpixelPrefilter(&info, &out.pixels[static_cast<size_t>(glyph.y) * out.width + glyph.x],
+            glyph.w, glyph.h, out.width, p.scale * oversampleH, p.scale * oversampleV, 0.0f, 0.0f,
+            oversampleH, oversampleV, &subX, &subY, p.glyphIndex);
+        glyph.xoff += subX;
+        glyph.yoff += subY;
+    }
+    return true;
+}
+
+// #detailed comments: BakeSdfAtlas
+// Purpose: One size for every overlay size. pixelDistScale spreads the
+// padding range over the full byte: the outline sits at 128, one baked
+// pixel inside adds 128 / padding, and texels padding pixels outside
+// reach 0.
+bool BakeSdfAtlas(const std::vector<uint8_t>& ttf, float bakeSize, int padding,
+                  FontAtlasBake& out, std::string& error)
+{
+    out = FontAtlasBake();
+    out.mode = FontAtlasBake::Mode::Sdf;
+    out.sizes = { bakeSize };
+    out.bakeSize = bakeSize;
+    out.padding = std::clamp(padding, 1, 32);
+    out.onEdge = kSdfOnEdge;
+    out.pixelDistScale = static_cast<float>(kSdfOnEdge) / out.padding;
+
+    stbtt_fontinfo info;
+    if (!InitFont(ttf, info, error)) return false;
+    const float scale = stbtt_ScaleForPixelHeight(&info, bakeSize);
+
+    std::vector<unsigned char*> bitmaps;
+    std::vector<stbrp_rect> rects;
+    for (const uint32_t cp : FontBakeCodepoints()) {
+        const int glyphIndex = stbtt_FindGlyphIndex(&info, static_cast<int>(cp));
+        if (glyphIndex == 0) continue;
+
+        int advance = 0, bearing = 0, w = 0, h = 0, xoff = 0, yoff = 0;
+        stbtt_GetGlyphHMetrics(&info, glyphIndex, &advance, &bearing);
+        unsigned char* bitmap = stbtt_GetGlyphSDF(&info, scale, glyphIndex, out.padding, out.onEdge,
+                                                  out.pixelDistScale, &w, &h, &xoff, &yoff);
+
+        FontBakeGlyph glyph;
+        glyph.codepoint = cp;
+        glyph.size = bakeSize;
+        glyph.advance = advance * scale;
+        if (bitmap) {
+            glyph.w = w;
+            glyph.h = h;
+            glyph.xoff = static_cast<float>(xoff);
+            glyph.yoff = static_cast<float>(yoff);
+
+            stbrp_rect rect = {};
+            rect.id = static_cast<int>(out.glyphs.size());
+            rect.w = static_cast<stbrp_coord>(w + kGlyphPadding);
+            rect.h = static_cast<stbrp_coord>(h + kGlyphPadding);
+            rects.push_back(rect);
+        }
+        out.glyphs.push_back(glyph);
+        bitmaps.push_back(bitmap);
+    }
+
+    const bool packed = PackRects(rects, out.width, out.height, error);
+    if (packed) {
+        out.pixels.assign(out.Alpha8Bytes(), 0);
+        for (const auto& rect : rects) {
+            FontBakeGlyph& glyph = out.glyphs[rect.id];
+            glyph.x = rect.x;
+            glyph.y = rect.y;
+            const unsigned char* src = bitmaps[rect.id];
+            for (int row = 0; row < glyph.h; ++row) {
+                std::copy_n(src + static_cast<size_t>(row) * glyph.w, glyph.w,
+                            &out.pixels[static_cast<size_t>(glyph.y + row) * out.width + glyph.x]);
+            }
+        }
+    }
+    for (unsigned char* bitmap : bitmaps) {
+        if (bitmap) stbtt_FreeSDF(bitmap, nullptr);
+    }
+    return packed;
+}
+
+float SdfCoverage(uint8_t texel, const FontAtlasBake& atlas, float renderSize)
+{
+    if (atlas.mode != FontAtlasBake::Mode::Sdf || atlas.bakeSize <= 0.0f) return texel / 255.0f;
+    const float bakedDistance = (static_cast<float>(texel) - atlas.onEdge) / atlas.pixelDistScale;
+    const float screenDistance = bakedDistance * renderSize / atlas.bakeSize;
+    return std::clamp(screenDistance + 0.5f, 0.0f, 1.0f);
+}
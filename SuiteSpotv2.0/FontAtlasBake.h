@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// FontAtlasBake: Offline font atlas bakes for measuring text rendering modes
+//
+// Purpose: Builds single-channel glyph atlases from a TTF the same way the
+// vendored ImGui atlas builder does (stb_truetype raster, stb_rect_pack
+// packing, ImGui's width heuristic, power-of-two height), in two modes:
+//   - Bitmap: one set of oversampled coverage glyphs per pixel size, which
+//     is what the overlay needs today to keep every AddText size crisp
+//   - Sdf: one set of signed-distance glyphs at a single bake size, which a
+//     distance-threshold shader can draw sharply at any size
+//
+// The host owns the ImGui context, the font atlas texture and the DX11
+// pixel shader, so the plugin cannot switch its live text to SDF; this
+// module exists to put numbers on that trade-off (see
+// RunFontAtlasBenchmark) and documents the shader math in SdfCoverage.
+//
+// Usage Example:
+//   FontAtlasBake atlas;
+//   std::string error;
+//   if (BakeSdfAtlas(ttfBytes, 32.0f, 4, atlas, error)) {
+//       const FontBakeGlyph* a = atlas.Find('A', atlas.bakeSize);
+//   }
+struct FontBakeGlyph {
+    uint32_t codepoint = 0;
+    float size = 0.0f;             // Pixel height the glyph was baked for
+    int x = 0, y = 0, w = 0, h = 0; // Atlas rect (w/h 0 for blank glyphs)
+    float xoff = 0.0f, yoff = 0.0f; // Rect origin relative to the pen, in baked pixels
+    float advance = 0.0f;
+};
+
+struct FontAtlasBake {
+    enum class Mode { Bitmap, Sdf };
+
+    Mode mode = Mode::Bitmap;
+    std::vector<float> sizes;           // Baked pixel heights (one entry for Sdf)
+    std::vector<FontBakeGlyph> glyphs;  // sizes.size() * FontBakeCodepoints().size()
+    std::vector<uint8_t> pixels;        // width * height, Alpha8
+    int width = 0;
+    int height = 0;
+
+    // Sdf only: texel value on the outline, and value change per baked pixel
+    float bakeSize = 0.0f;
+    int padding = 0;
+    uint8_t onEdge = 0;
+    float pixelDistScale = 0.0f;
+
+    const FontBakeGlyph* Find(uint32_t codepoint, float size) const;
+
+    // What the texture costs once the renderer uploads it
+    size_t Alpha8Bytes() const { return static_cast<size_t>(width) * height; }
+    size_t Rgba32Bytes() const { return Alpha8Bytes() * 4; }  // GetTexDataAsRGBA32
+};
+
+// Glyphs the overlay draws: printable ASCII plus the MVP star (U+2605)
+const std::vector<uint32_t>& FontBakeCodepoints();
+
+// One atlas holding every size in sizes (the overlay's four AddText sizes
+// by default), rasterized with ImGui's default 3x1 oversampling
+bool BakeBitmapAtlas(const std::vector<uint8_t>& ttf, const std::vector<float>& sizes,
+                     int oversampleH, int oversampleV, FontAtlasBake& out, std::string& error);
+
+// One atlas of distance glyphs baked at bakeSize; padding is the distance
+// range in baked pixels on each side of the outline
+bool BakeSdfAtlas(const std::vector<uint8_t>& ttf, float bakeSize, int padding,
+                  FontAtlasBake& out, std::string& error);
+
+// Coverage (0..1) a threshold shader outputs for one SDF texel when the
+// glyph is drawn at renderSize pixels: the texel's distance is converted
+// to screen pixels and given a one-pixel linear ramp around the outline
+float SdfCoverage(uint8_t texel, const FontAtlasBake& atlas, float renderSize);
@@ -0,0 +1,170 @@
+#include "pch.h"
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+int LatencyHistogram::BucketOf(double millis)
+{
+    if (!(millis >= 1.0)) return 0;  // also catches NaN
+    int exponent = 0;
+    const double mantissa = std::frexp(millis, &exponent);  // millis = mantissa * 2^exponent, mantissa in [0.5, 1)
+    const int octave = exponent - 1;
+    if (octave >= kOctaves) return kBuckets - 1;
+    const int sub = std::min(kSubBuckets - 1, static_cast<int>((mantissa * 2.0 - 1.0) * kSubBuckets));
+    return 1 + octave * kSubBuckets + sub;
+}
+
+double LatencyHistogram::BucketLowerMs(int bucket)
+{
+    if (bucket <= 0) return 0.0;
+    const int octave = (bucket - 1) / kSubBuckets;
+    const int sub = (bucket - 1) % kSubBuckets;
+    return std::ldexp(1.0 + static_cast<double>(sub) / kSubBuckets, octave);
+}
+
+double LatencyHistogram::BucketUpperMs(int bucket)
+{
+    if (bucket <= 0) return 1.0;
+    return BucketLowerMs(bucket) + std::ldexp(1.0 / kSubBuckets, (bucket - 1) / kSubBuckets);
+}
+
+void LatencyHistogram::Record(double millis)
+{
+    millis = std::max(0.0, millis);
+    ++buckets_[BucketOf(millis)];
+    min_ = count_ ? std::min(min_, millis) : millis;
+    max_ = count_ ? std::max(max_, millis) : millis;
+    sum_ += millis;
+    ++count_;
+}
+
+// #detailed comments: LatencyHistogram::Percentile
+// Purpose: Nearest-rank percentile. The bucket holding the rank is found
+// by a cumulative walk, then the value is placed linearly inside it by how
+// far into the bucket's samples the rank falls. Clamping to the exact
+// min/max keeps p0/p100 (and single-sample histograms) exact.
+double LatencyHistogram::Percentile(double q) const
+{
+    if (count_ == 0) return 0.0;
+    q = std::clamp(q, 0.0, 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        if (buckets_[b] == 0) continue;
+        if (seen + buckets_[b] >= rank) {
+            const double within = static_cast<double>(rank - seen) / buckets_[b];
+            const double value = BucketLowerMs(b) + (BucketUpperMs(b) - BucketLowerMs(b)) * within;
+            return std::clamp(value, min_, max_);
+        }
+        seen += buckets_[b];
+    }
+    return max_;
+}
+
+std::array<float, LatencyHistogram::kOctaves> LatencyHistogram::OctaveCounts() const
+{
+    std::array<float, kOctaves> counts = {};
+    counts[0] = static_cast<float>(buckets_[0]);
+    for (int b = 1; b < kBuckets; ++b) {
+        counts[(b - 1) / kSubBuckets] += static_cast<float>(buckets_[b]);
+    }
+    return counts;
+}
+
+const char* LatencyStageName(LatencyStage stage)
+{
+    switch (stage) {
+        case LatencyStage::Wait: return "wait";
+        case LatencyStage::Load: return "load";
+        case LatencyStage::Total: return "total";
+        case LatencyStage::Queue: return "queue";
+        default: return "?";
+    }
+}
+
+const char* LatencyModeName(LatencyMode mode)
+{
+    switch (mode) {
+        case LatencyMode::Freeplay: return "freeplay";
+        case LatencyMode::Training: return "training";
+        case LatencyMode::Workshop: return "workshop";
+        default: return "?";
+    }
+}
+
+std::string FormatLatencyHistogram(const char* label, const LatencyHistogram& histogram)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%-9s n=%-5llu p50 %7.2f s  p90 %7.2f s  p99 %7.2f s  max %7.2f s",
+        label, static_cast<unsigned long long>(histogram.Count()),
+        histogram.Percentile(0.50) / 1000.0, histogram.Percentile(0.90) / 1000.0,
+        histogram.Percentile(0.99) / 1000.0, histogram.Max() / 1000.0);
+    return buf;
+}
+
+namespace
+{
+    double MillisBetween(PostMatchLatency::Clock::time_point from, PostMatchLatency::Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
+
+LatencyHistogram& PostMatchLatency::At(LatencyStage stage)
+{
+    return stats_[static_cast<size_t>(*mode_)].stages[static_cast<size_t>(stage)];
+}
+
+void PostMatchLatency::BeginMatch(LatencyMode mode, Clock::time_point matchEnd)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    mode_ = mode;
+    matchEnd_ = matchEnd;
+    loadIssued_.reset();
+    ++stats_[static_cast<size_t>(mode)].matches;
+}
+
+void PostMatchLatency::LoadIssued(bool onEvent, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!mode_) return;
+    At(LatencyStage::Wait).Record(MillisBetween(matchEnd_, now));
+    if (!onEvent) ++stats_[static_cast<size_t>(*mode_)].fallbacks;
+    loadIssued_ = now;
+}
+
+void PostMatchLatency::QueueIssued(bool onEvent, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!mode_) return;
+    At(LatencyStage::Queue).Record(MillisBetween(matchEnd_, now));
+    if (!onEvent) ++stats_[static_cast<size_t>(*mode_)].fallbacks;
+}
+
+void PostMatchLatency::MapLoaded(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!mode_ || !loadIssued_) return;
+    if (now - *loadIssued_ <= kMaxLoadWait) {
+        At(LatencyStage::Load).Record(MillisBetween(*loadIssued_, now));
+        At(LatencyStage::Total).Record(MillisBetween(matchEnd_, now));
+    }
+    loadIssued_.reset();
+}
+
+PostMatchLatency::Snapshot PostMatchLatency::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void PostMatchLatency::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = Snapshot();
+    mode_.reset();
+    loadIssued_.reset();
+}
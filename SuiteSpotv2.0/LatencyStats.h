@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// LatencyHistogram: Log-bucketed millisecond histogram
+//
+// Purpose: Fixed-size latency distribution with bounded relative error.
+// Each power of two from 1 ms to 2^17 ms (~131 s) is split into
+// kSubBuckets linear buckets, so a percentile read from bucket bounds is
+// within 1/kSubBuckets (12.5%) of the recorded value. Samples below 1 ms
+// share the first bucket; samples above the range share the last.
+// Min, max and mean are exact.
+class LatencyHistogram
+{
+public:
+    static constexpr int kSubBuckets = 8;
+    static constexpr int kOctaves = 17;
+    static constexpr int kBuckets = kSubBuckets * kOctaves + 1;  // +1: below 1 ms
+
+    void Record(double millis);
+    void Reset() { *this = LatencyHistogram(); }
+
+    uint64_t Count() const { return count_; }
+    double Min() const { return count_ ? min_ : 0.0; }
+    double Max() const { return count_ ? max_ : 0.0; }
+    double Mean() const { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+
+    // q in [0, 1]; interpolated inside the bucket and clamped to [Min, Max]
+    double Percentile(double q) const;
+
+    // Sample counts per octave (index 0: below 2 ms, i: [2^i, 2^(i+1)) ms),
+    // the granularity the settings panel plots
+    std::array<float, kOctaves> OctaveCounts() const;
+
+    static int BucketOf(double millis);
+    static double BucketLowerMs(int bucket);
+    static double BucketUpperMs(int bucket);
+
+private:
+    std::array<uint32_t, kBuckets> buckets_ = {};
+    uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+};
+
+// Where post-match time goes, per map mode
+enum class LatencyStage : uint8_t {
+    Wait,   // Match end -> load command (SuiteSpot's settle wait / delay)
+    Load,   // Load command -> map loaded (the game's load time)
+    Total,  // Match end -> map loaded
+    Queue,  // Match end -> queue command
+    Count
+};
+
+enum class LatencyMode : uint8_t { Freeplay, Training, Workshop, Count };
+
+const char* LatencyStageName(LatencyStage stage);
+const char* LatencyModeName(LatencyMode mode);
+
+// "load      n=12    p50   2.31 s  p90   3.10 s  p99   4.02 s  max   4.10 s"
+std::string FormatLatencyHistogram(const char* label, const LatencyHistogram& histogram);
+
+// PostMatchLatency: Timestamps one post-match run at a time
+//
+// Purpose: The post-match sequence reports each step as it happens
+// (BeginMatch, LoadIssued, QueueIssued) and the map-load hook reports
+// MapLoaded; each completed interval is recorded in the histogram for the
+// run's mode and stage. A map load only counts against the run that
+// issued it, and only within kMaxLoadWait of the command, so loads the
+// user starts by hand are not attributed to SuiteSpot.
+//
+// Threading: Written on the game thread, read by the settings panel on
+// the render thread; all access goes through one mutex and readers take
+// a Snapshot.
+class PostMatchLatency
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration kMaxLoadWait = std::chrono::minutes(2);
+
+    struct ModeStats {
+        std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::Count)> stages;
+        uint64_t matches = 0;
+        uint64_t fallbacks = 0;  // Steps that started on their timeout rather than a game event
+
+        const LatencyHistogram& Get(LatencyStage stage) const { return stages[static_cast<size_t>(stage)]; }
+    };
+    using Snapshot = std::array<ModeStats, static_cast<size_t>(LatencyMode::Count)>;
+
+    void BeginMatch(LatencyMode mode, Clock::time_point matchEnd);
+    void LoadIssued(bool onEvent, Clock::time_point now = Clock::now());
+    void QueueIssued(bool onEvent, Clock::time_point now = Clock::now());
+    void MapLoaded(Clock::time_point now = Clock::now());
+
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+private:
+    LatencyHistogram& At(LatencyStage stage);
+
+    mutable std::mutex mutex_;
+    Snapshot stats_;
+    std::optional<LatencyMode> mode_;           // Run in progress
+    Clock::time_point matchEnd_{};
+    std::optional<Clock::time_point> loadIssued_;  // Load awaiting its map
+};
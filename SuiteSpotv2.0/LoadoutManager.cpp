@@ -3,10 +3,11 @@
 #include "logging.h"
 
 // LoadoutManager Implementation
-// 
+//
 // Purpose: Encapsulates BakkesMod LoadoutSaveWrapper operations for car loadout
-// switching and management. Provides thread-safe interface using gameWrapper->Execute()
-// to ensure all wrapper access happens on the game thread.
+// switching and management. Every operation is a Task: it is queued with
+// gameWrapper->Execute(), runs on the game thread, and reports through a
+// future, an optional callback and the cached State.
 //
 // BakkesMod API Flow:
 //   GameWrapper::GetUserLoadoutSave() -> LoadoutSaveWrapper
@@ -14,280 +15,455 @@
 //     -> GetEquippedLoadout() -> LoadoutSetWrapper
 //     -> EquipPreset(preset) -> void (switches loadout)
 //
-// Thread Safety: All public methods use gameWrapper->Execute() to wrap BakkesMod
-// API calls, ensuring they execute on the game thread regardless of caller context.
+// Completion: A Task owns its promise. Finish fulfils it once; if the Execute
+// lambda (the Task's only owner) is destroyed without running, the Task's
+// destructor fulfils it as Cancelled. Either way pending is decremented
+// exactly once.
+//
+// Snapshot: Tasks and Poll run on the game thread and are the only writers.
+// They build a new LoadoutSnapshot and publish it under the mutex only when
+// the preset list or the equipped preset actually changed, so a generation
+// bump always means something to redraw.
+//
+// Rules: Shared keeps each rule's preset name with its index in the snapshot
+// that was current when it was resolved. Publish and SetRule re-resolve
+// under the mutex, so ApplyRule only copies two ints.
 //
-// Error Handling: All wrapper operations are null-checked. Methods return bool
-// for success/failure to enable caller error handling. Failures are logged.
+// Error Handling: All wrapper operations are null-checked and exceptions are
+// caught; failures come back as a LoadoutStatus plus an error string, and are
+// logged.
 //
 // Design Pattern: Never store wrapper references - always get fresh references
 // within Execute() blocks to avoid using invalid/stale wrappers.
 
-LoadoutManager::LoadoutManager(std::shared_ptr<GameWrapper> gameWrapper)
+struct LoadoutManager::Shared {
+    mutable std::mutex mutex;
+    std::shared_ptr<const LoadoutSnapshot> snapshot = std::make_shared<LoadoutSnapshot>();
+    std::string lastError;
+    int pending = 0;
+
+    // Rule presets and where the current snapshot puts them (-1 = not found)
+    struct ResolvedRule {
+        std::string name;
+        int index = -1;
+        int presetCount = 0;
+    };
+    std::array<ResolvedRule, kLoadoutRuleCount> rules;
+
+    // Game thread only: what Poll compares the game's state against
+    int seenCount = -1;
+    uintptr_t seenEquipped = 0;
+    std::chrono::steady_clock::time_point nextPoll{};
+
+    std::shared_ptr<const LoadoutSnapshot> Current() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return snapshot;
+    }
+
+    void Publish(std::shared_ptr<LoadoutSnapshot> next)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        next->generation = snapshot->generation + 1;
+        snapshot = std::move(next);
+        for (auto& rule : rules) ResolveLocked(rule);
+    }
+
+    void ResolveLocked(ResolvedRule& rule) const
+    {
+        const auto it = rule.name.empty() ? snapshot->presetIndex.end() : snapshot->presetIndex.find(rule.name);
+        rule.index = it == snapshot->presetIndex.end() ? -1 : it->second;
+        rule.presetCount = snapshot->presetCount;
+    }
+};
+
+struct LoadoutManager::Task {
+    LoadoutRequest request;
+    Completion onDone;
+    std::promise<LoadoutResult> promise;
+    std::shared_ptr<Shared> shared;
+    bool finished = false;
+
+    ~Task()
+    {
+        if (!finished) {
+            LoadoutResult result;
+            result.status = LoadoutStatus::Cancelled;
+            result.error = "cancelled before it ran";
+            Finish(std::move(result), false);
+        }
+    }
+
+    void Finish(LoadoutResult result, bool runCallback)
+    {
+        finished = true;
+        if (shared) {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->lastError = result.error;
+            --shared->pending;
+        }
+        if (runCallback && onDone) {
+            try {
+                onDone(result);
+            }
+            catch (const std::exception& e) {
+                ERRORLOG("[LoadoutManager] Exception in completion callback: {}", e.what());
+            }
+        }
+        promise.set_value(std::move(result));
+    }
+};
+
+LoadoutManager::LoadoutManager(std::shared_ptr<GameWrapper> gameWrapper, TimerWheel& timers)
     : gameWrapper_(gameWrapper)
+    , timers_(timers)
+    , shared_(std::make_shared<Shared>())
 {
     // Use deferred initialization to ensure game state is ready
     if (gameWrapper_) {
-        gameWrapper_->SetTimeout([this](GameWrapper* gw) {
-            QueryLoadoutNamesInternal();
-            initialized_.store(true);
-            // Thread-safe access to cache size for logging
-            size_t cacheSize;
-            {
-                std::lock_guard<std::mutex> lock(cacheMutex_);
-                cacheSize = cachedLoadoutNames_.size();
-            }
-            LOG("[LoadoutManager] Initialization complete, found {} loadout(s)", cacheSize);
-        }, 0.5f); // Small delay to ensure BakkesMod is fully loaded
+        initTimer_ = timers_.Schedule(std::chrono::milliseconds(500), [this]() {
+            RefreshLoadoutCache([](const LoadoutResult& result) {
+                if (result.Ok()) {
+                    LOG("[LoadoutManager] Initialization complete, found {} loadout(s)", result.names.size());
+                } else {
+                    LOG("[LoadoutManager] Initialization failed: {}", result.error);
+                }
+            });
+        }); // Small delay to ensure BakkesMod is fully loaded
     } else {
-        LOG("[LoadoutManager] ERROR: GameWrapper is null during construction");
+        ERRORLOG("[LoadoutManager] GameWrapper is null during construction");
     }
 }
 
-void LoadoutManager::QueryLoadoutNamesInternal()
+LoadoutManager::~LoadoutManager()
+{
+    // The deferred initialization captures this; queued tasks only hold shared_
+    timers_.Cancel(initTimer_);
+}
+
+std::future<LoadoutResult> LoadoutManager::Submit(LoadoutRequest request, Completion onDone)
 {
-    // Internal helper that queries LoadoutSaveWrapper for all loadout preset names
-    // Populates cachedLoadoutNames_ for use by GetLoadoutNames() and SwitchLoadout(index)
-    
     if (!gameWrapper_) {
-        LOG("[LoadoutManager] Cannot query loadouts: GameWrapper is null");
-        return;
+        LOG("[LoadoutManager] Submit: GameWrapper is null");
+        return Completed(LoadoutStatus::Unavailable, "GameWrapper is null", onDone);
+    }
+
+    auto task = std::make_shared<Task>();
+    task->request = std::move(request);
+    task->onDone = std::move(onDone);
+    task->shared = shared_;
+    auto future = task->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        ++shared_->pending;
     }
 
     // Execute on game thread for thread-safe wrapper access
-    gameWrapper_->Execute([this](GameWrapper* gw) {
-        std::vector<std::string> tempNames;
-        
-        try {
-            auto loadoutSave = gw->GetUserLoadoutSave();
-            if (loadoutSave.IsNull()) {
-                LOG("[LoadoutManager] GetUserLoadoutSave() returned null");
-                return;
-            }
+    gameWrapper_->Execute([task](GameWrapper* gw) {
+        task->Finish(RunTask(gw, task->request, *task->shared), true);
+    });
+    return future;
+}
+
+LoadoutResult LoadoutManager::RunTask(GameWrapper* gw, const LoadoutRequest& request, Shared& shared)
+{
+    LoadoutResult result;
+    auto fail = [&result](LoadoutStatus status, std::string error) {
+        WARNLOG("[LoadoutManager] {}", error);
+        result.status = status;
+        result.error = std::move(error);
+        return result;
+    };
+
+    const auto known = shared.Current();
+    std::shared_ptr<LoadoutSnapshot> next;  // Set once something differs from known
+    auto edit = [&]() -> LoadoutSnapshot& {
+        if (!next) next = std::make_shared<LoadoutSnapshot>(*known);
+        return *next;
+    };
+
+    try {
+        auto loadoutSave = gw->GetUserLoadoutSave();
+        if (loadoutSave.IsNull()) {
+            return fail(LoadoutStatus::Unavailable, "GetUserLoadoutSave() returned null");
+        }
 
+        if (request.refreshNames || !request.switchTo.empty()) {
             auto presets = loadoutSave.GetPresets();
             if (presets.IsNull()) {
-                LOG("[LoadoutManager] GetPresets() returned null");
-                return;
+                return fail(LoadoutStatus::Unavailable, "GetPresets() returned null");
             }
+            const int presetCount = presets.Count();
 
-            // Iterate through presets and extract names
-            int presetCount = presets.Count();
-            LOG("[LoadoutManager] Found {} preset(s)", presetCount);
-            
-            // Reserve capacity to avoid reallocations
-            tempNames.reserve(presetCount);
-            
-            for (int i = 0; i < presetCount; ++i) {
-                auto preset = presets.Get(i);
-                if (!preset.IsNull()) {
+            // Fast path: the cached index, confirmed with one GetName in
+            // case presets were reordered without the count changing
+            if (!request.switchTo.empty() && known->presetCount == presetCount) {
+                const auto it = known->presetIndex.find(request.switchTo);
+                if (it != known->presetIndex.end()) {
+                    auto preset = presets.Get(it->second);
+                    if (!preset.IsNull() && preset.GetName() == request.switchTo) {
+                        loadoutSave.EquipPreset(preset);
+                        result.switched = true;
+                        LOG("[LoadoutManager] Successfully switched to loadout: '{}'", request.switchTo);
+                    }
+                }
+            }
+
+            // Full scan on refresh, or when the cache could not serve the switch
+            if (request.refreshNames || !result.switched) {
+                std::vector<std::string> names;
+                std::unordered_map<std::string, int> presetIndex;
+                // Reserve capacity to avoid reallocations
+                names.reserve(presetCount);
+                presetIndex.reserve(presetCount);
+
+                for (int i = 0; i < presetCount; ++i) {
+                    auto preset = presets.Get(i);
+                    if (preset.IsNull()) {
+                        DEBUGLOG("[LoadoutManager] Preset at index {} is null", i);
+                        continue;
+                    }
                     std::string name = preset.GetName();
-                    if (!name.empty()) {
-                        tempNames.push_back(name);
-                    } else {
-                        LOG("[LoadoutManager] Preset at index {} has empty name", i);
+                    if (name.empty()) {
+                        DEBUGLOG("[LoadoutManager] Preset at index {} has empty name", i);
+                        continue;
                     }
-                } else {
-                    LOG("[LoadoutManager] Preset at index {} is null", i);
+                    if (!result.switched && name == request.switchTo) {
+                        loadoutSave.EquipPreset(preset);
+                        result.switched = true;
+                        LOG("[LoadoutManager] Successfully switched to loadout: '{}'", request.switchTo);
+                    }
+                    presetIndex.emplace(name, i);  // First of duplicate names wins, as the scan does
+                    names.push_back(std::move(name));
+                }
+
+                if (!known->ready || known->presetCount != presetCount || known->names != names) {
+                    LoadoutSnapshot& snapshot = edit();
+                    snapshot.names = names;
+                    snapshot.presetIndex = std::move(presetIndex);
+                    snapshot.presetCount = presetCount;
+                    snapshot.ready = true;
+                }
+                if (request.refreshNames) {
+                    result.names = std::move(names);
                 }
             }
-            
-            // Update cache with thread safety (inside Execute to ensure completion)
-            {
-                std::lock_guard<std::mutex> lock(cacheMutex_);
-                cachedLoadoutNames_ = std::move(tempNames);
+            shared.seenCount = presetCount;
+
+            if (!request.switchTo.empty() && !result.switched) {
+                // The refreshed names are still valid, so keep them
+                fail(LoadoutStatus::NotFound, "Loadout '" + request.switchTo + "' not found in presets");
             }
         }
-        catch (const std::exception& e) {
-            LOG("[LoadoutManager] Exception in QueryLoadoutNamesInternal: {}", e.what());
-        }
-        catch (...) {
-            LOG("[LoadoutManager] Unknown exception in QueryLoadoutNamesInternal");
+
+        // A switch changes the equipped preset, so the snapshot re-reads it too
+        if (request.queryCurrent || result.switched) {
+            // GetEquippedLoadout() returns a LoadoutSetWrapper with the currently active preset
+            auto equippedLoadout = loadoutSave.GetEquippedLoadout();
+            if (equippedLoadout.IsNull()) {
+                DEBUGLOG("[LoadoutManager] GetEquippedLoadout() returned null");
+            } else {
+                result.current = equippedLoadout.GetName();
+                shared.seenEquipped = equippedLoadout.memory_address;
+                if (result.current != known->current) {
+                    edit().current = result.current;
+                }
+            }
         }
-    });
+    }
+    catch (const std::exception& e) {
+        fail(LoadoutStatus::Unavailable, std::string("Exception: ") + e.what());
+    }
+    catch (...) {
+        fail(LoadoutStatus::Unavailable, "Unknown exception");
+    }
+
+    if (next) {
+        shared.Publish(std::move(next));
+    }
+    return result;
 }
 
-std::vector<std::string> LoadoutManager::GetLoadoutNames()
+void LoadoutManager::Poll()
 {
-    // Thread-safe access to cached loadout names
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    // Check initialization status under the same lock for consistency
-    if (cachedLoadoutNames_.empty()) {
-        bool isInitialized = initialized_.load();
-        if (!isInitialized) {
-            LOG("[LoadoutManager] GetLoadoutNames called before initialization complete");
-        }
+    if (!gameWrapper_) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now < shared_->nextPoll) return;
+    shared_->nextPoll = now + kPollInterval;
+
+    try {
+        auto loadoutSave = gameWrapper_->GetUserLoadoutSave();
+        if (loadoutSave.IsNull()) return;
+        auto presets = loadoutSave.GetPresets();
+        if (presets.IsNull()) return;
+        auto equipped = loadoutSave.GetEquippedLoadout();
+
+        // Three calls and two compares when nothing changed
+        const int presetCount = presets.Count();
+        const uintptr_t equippedAddress = equipped.IsNull() ? 0 : equipped.memory_address;
+        if (presetCount == shared_->seenCount && equippedAddress == shared_->seenEquipped) return;
+
+        LoadoutRequest request;
+        request.refreshNames = presetCount != shared_->seenCount;
+        request.queryCurrent = true;
+        RunTask(gameWrapper_.get(), request, *shared_);
+        shared_->seenEquipped = equippedAddress;
+    }
+    catch (const std::exception& e) {
+        ERRORLOG("[LoadoutManager] Exception in Poll: {}", e.what());
+    }
+    catch (...) {
+        ERRORLOG("[LoadoutManager] Unknown exception in Poll");
     }
-    
-    return cachedLoadoutNames_;
 }
 
-std::string LoadoutManager::GetCurrentLoadoutName()
+const char* LoadoutRuleName(LoadoutRule rule)
 {
-    // Safely queries BakkesMod for the currently equipped loadout name
-    // Returns empty string if unable to determine current loadout or if no preset is active
-
-    if (!gameWrapper_) {
-        LOG("[LoadoutManager] GetCurrentLoadoutName: GameWrapper is null");
-        return "";
+    switch (rule) {
+        case LoadoutRule::Freeplay: return "freeplay";
+        case LoadoutRule::Training: return "training";
+        case LoadoutRule::Workshop: return "workshop";
+        case LoadoutRule::Queue: return "queue";
+        default: return "?";
     }
+}
 
-    std::string currentName;
+void LoadoutManager::SetRule(LoadoutRule rule, std::string presetName)
+{
+    if (rule >= LoadoutRule::Count) return;
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    auto& resolved = shared_->rules[static_cast<size_t>(rule)];
+    resolved.name = std::move(presetName);
+    shared_->ResolveLocked(resolved);
+}
 
-    // Execute on game thread for thread-safe wrapper access
-    // IMPORTANT: Capture currentName by value through a shared_ptr to avoid reference issues
-    auto result = std::make_shared<std::string>();
-
-    gameWrapper_->Execute([this, result](GameWrapper* gw) {
-        try {
-            auto loadoutSave = gw->GetUserLoadoutSave();
-            if (loadoutSave.IsNull()) {
-                LOG("[LoadoutManager] GetCurrentLoadoutName: GetUserLoadoutSave() returned null");
-                return;
-            }
+std::string LoadoutManager::GetRule(LoadoutRule rule) const
+{
+    if (rule >= LoadoutRule::Count) return {};
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->rules[static_cast<size_t>(rule)].name;
+}
 
-            // GetEquippedLoadout() returns a LoadoutSetWrapper with the currently active preset
-            auto equippedLoadout = loadoutSave.GetEquippedLoadout();
-            if (equippedLoadout.IsNull()) {
-                LOG("[LoadoutManager] GetCurrentLoadoutName: GetEquippedLoadout() returned null");
-                return;
-            }
+LoadoutResult LoadoutManager::ApplyRule(LoadoutRule rule)
+{
+    LoadoutResult result;
+    if (rule >= LoadoutRule::Count || !gameWrapper_) return result;
 
-            // Get the name of the equipped loadout preset
-            std::string equippedName = equippedLoadout.GetName();
-            if (equippedName.empty()) {
-                LOG("[LoadoutManager] GetCurrentLoadoutName: Equipped loadout has empty name");
-                return;
-            }
+    Shared::ResolvedRule resolved;
+    bool equipped = false;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        resolved = shared_->rules[static_cast<size_t>(rule)];
+        equipped = !resolved.name.empty() && shared_->snapshot->current == resolved.name;
+    }
+    if (resolved.name.empty() || equipped) return result;
 
-            // Store result in shared_ptr (safe across thread boundaries)
-            *result = equippedName;
-        }
-        catch (const std::exception& e) {
-            LOG("[LoadoutManager] Exception in GetCurrentLoadoutName: {}", e.what());
+    if (resolved.index < 0) {
+        result.status = LoadoutStatus::NotFound;
+        result.error = "Loadout '" + resolved.name + "' for " + LoadoutRuleName(rule) + " not found in presets";
+        LOG("[LoadoutManager] {}", result.error);
+        return result;
+    }
+
+    try {
+        auto loadoutSave = gameWrapper_->GetUserLoadoutSave();
+        if (loadoutSave.IsNull()) {
+            result.status = LoadoutStatus::Unavailable;
+            result.error = "GetUserLoadoutSave() returned null";
+            return result;
         }
-        catch (...) {
-            LOG("[LoadoutManager] Unknown exception in GetCurrentLoadoutName");
+        auto presets = loadoutSave.GetPresets();
+        if (!presets.IsNull() && presets.Count() == resolved.presetCount) {
+            auto preset = presets.Get(resolved.index);
+            if (!preset.IsNull()) {
+                loadoutSave.EquipPreset(preset);
+                result.switched = true;
+                LOG("[LoadoutManager] Equipped '{}' for {}", resolved.name, LoadoutRuleName(rule));
+                return result;
+            }
         }
-    });
+    }
+    catch (const std::exception& e) {
+        ERRORLOG("[LoadoutManager] Exception in ApplyRule: {}", e.what());
+    }
+    catch (...) {
+        ERRORLOG("[LoadoutManager] Unknown exception in ApplyRule");
+    }
 
-    return *result;
+    // Stale index: switch by name, which rescans and republishes (and so re-resolves)
+    LoadoutRequest request;
+    request.switchTo = resolved.name;
+    return RunTask(gameWrapper_.get(), request, *shared_);
 }
 
-bool LoadoutManager::SwitchLoadout(const std::string& loadoutName)
+std::future<LoadoutResult> LoadoutManager::Completed(LoadoutStatus status, std::string error, const Completion& onDone)
+{
+    // For requests rejected before reaching the game thread; the caller's thread runs onDone
+    LoadoutResult result;
+    result.status = status;
+    result.error = std::move(error);
+    if (onDone) onDone(result);
+    std::promise<LoadoutResult> promise;
+    promise.set_value(std::move(result));
+    return promise.get_future();
+}
+
+std::future<LoadoutResult> LoadoutManager::RefreshLoadoutCache(Completion onDone)
+{
+    LoadoutRequest request;
+    request.refreshNames = true;
+    request.queryCurrent = true;
+    return Submit(std::move(request), std::move(onDone));
+}
+
+std::future<LoadoutResult> LoadoutManager::SwitchLoadout(const std::string& loadoutName, Completion onDone)
 {
-    if (!gameWrapper_) {
-        LOG("[LoadoutManager] SwitchLoadout: GameWrapper is null");
-        return false;
-    }
-    
     if (loadoutName.empty()) {
         LOG("[LoadoutManager] SwitchLoadout: Loadout name is empty");
-        return false;
+        return Completed(LoadoutStatus::NotFound, "Loadout name is empty", onDone);
     }
 
-    bool success = false;
-
-    // Capture by value to prevent reference issues
-    gameWrapper_->Execute([this, loadoutName, &success](GameWrapper* gw) {
-        try {
-            auto loadoutSave = gw->GetUserLoadoutSave();
-            if (loadoutSave.IsNull()) {
-                LOG("[LoadoutManager] SwitchLoadout: GetUserLoadoutSave() returned null");
-                return;
-            }
-
-            auto presets = loadoutSave.GetPresets();
-            if (presets.IsNull()) {
-                LOG("[LoadoutManager] SwitchLoadout: GetPresets() returned null");
-                return;
-            }
-
-            // Search for matching preset by name
-            bool found = false;
-            for (int i = 0; i < presets.Count(); ++i) {
-                auto preset = presets.Get(i);
-                if (!preset.IsNull()) {
-                    std::string presetName = preset.GetName();
-                    if (presetName == loadoutName) {
-                        loadoutSave.EquipPreset(preset);
-                        success = true;
-                        found = true;
-                        LOG("[LoadoutManager] Successfully switched to loadout: '{}'", loadoutName);
-                        return;
-                    }
-                }
-            }
-            
-            if (!found) {
-                LOG("[LoadoutManager] SwitchLoadout: Loadout '{}' not found in presets", loadoutName);
-            }
-        }
-        catch (const std::exception& e) {
-            LOG("[LoadoutManager] Exception in SwitchLoadout: {}", e.what());
-        }
-        catch (...) {
-            LOG("[LoadoutManager] Unknown exception in SwitchLoadout");
-        }
-    });
-
-    return success;
+    LoadoutRequest request;
+    request.switchTo = loadoutName;
+    request.queryCurrent = true;
+    return Submit(std::move(request), std::move(onDone));
 }
 
-bool LoadoutManager::SwitchLoadout(int index)
+std::future<LoadoutResult> LoadoutManager::SwitchLoadout(int index, Completion onDone)
 {
-    // Switches to the loadout at the specified index in cachedLoadoutNames_
-    // Returns true if successful, false otherwise
-    // Index must be valid (0 <= index < cachedLoadoutNames_.size())
-    
+    // Index must be valid (0 <= index < snapshot names size)
     std::string loadoutName;
-    
-    // Thread-safe access to cache
-    {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        
-        if (index < 0 || index >= static_cast<int>(cachedLoadoutNames_.size())) {
-            LOG("[LoadoutManager] Invalid loadout index: {} (cache size: {})", index, cachedLoadoutNames_.size());
-            return false;
-        }
-        
-        loadoutName = cachedLoadoutNames_[index];
+    const auto snapshot = shared_->Current();
+    if (index >= 0 && index < static_cast<int>(snapshot->names.size())) {
+        loadoutName = snapshot->names[index];
+    }
+
+    if (loadoutName.empty()) {
+        LOG("[LoadoutManager] Invalid loadout index: {}", index);
+        return Completed(LoadoutStatus::Unavailable, "Invalid loadout index " + std::to_string(index), onDone);
     }
 
     // Use the by-name method with the cached name
-    return SwitchLoadout(loadoutName);
+    return SwitchLoadout(loadoutName, std::move(onDone));
 }
 
-bool LoadoutManager::RefreshLoadoutCache()
+LoadoutManager::State LoadoutManager::GetState() const
 {
-    // Refreshes the cached loadout list by re-querying LoadoutSaveWrapper
-    // Call this after creating or deleting loadouts externally
-    // Returns true if refresh successful (at least able to query), false otherwise
-    
-    if (!gameWrapper_) {
-        LOG("[LoadoutManager] RefreshLoadoutCache: GameWrapper is null");
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    State state;
+    state.presets = shared_->snapshot;
+    state.lastError = shared_->lastError;
+    state.pending = shared_->pending;
+    return state;
+}
 
-    LOG("[LoadoutManager] Refreshing loadout cache...");
-    
-    // Re-query the loadout names
-    QueryLoadoutNamesInternal();
-    
-    // Log the results (capture size outside mutex for minimal lock time)
-    size_t cacheSize;
-    {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        cacheSize = cachedLoadoutNames_.size();
-    }
-    LOG("[LoadoutManager] Cache refresh complete, found {} loadout(s)", cacheSize);
-    
-    // Success if we have a valid gameWrapper (QueryLoadoutNamesInternal logs its own errors)
-    return true;
+std::shared_ptr<const LoadoutSnapshot> LoadoutManager::GetSnapshot() const
+{
+    return shared_->Current();
 }
 
 bool LoadoutManager::IsReady() const
 {
-    return initialized_.load();
+    return shared_->Current()->ready;
 }
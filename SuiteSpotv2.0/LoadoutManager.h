@@ -1,15 +1,67 @@
 #pragma once
 
 #include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "TimerWheel.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
 #include <algorithm>
+#include <functional>
+#include <future>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+// One game-thread hop's worth of loadout work. The steps run in this order
+// inside a single gameWrapper->Execute, so "refresh, switch, then read the
+// equipped name" costs one hop and one pass over the presets.
+struct LoadoutRequest {
+    bool refreshNames = false;
+    std::string switchTo;       // Preset to equip; empty = no switch
+    bool queryCurrent = false;  // Read the equipped preset (after the switch)
+};
+
+enum class LoadoutStatus {
+    Ok,
+    NotFound,     // switchTo matched no preset
+    Unavailable,  // GameWrapper or LoadoutSaveWrapper missing, or the API threw
+    Cancelled     // The task was dropped before it ran (plugin unloading)
+};
+
+struct LoadoutResult {
+    LoadoutStatus status = LoadoutStatus::Ok;
+    std::string error;                // Set for every status but Ok
+    std::vector<std::string> names;   // When refreshNames
+    std::string current;              // When queryCurrent
+    bool switched = false;
+
+    bool Ok() const { return status == LoadoutStatus::Ok; }
+};
+
+// When SuiteSpot equips a rule's preset during the post-match sequence:
+// the map modes as the map load goes out, Queue as the queue goes out
+enum class LoadoutRule : uint8_t { Freeplay, Training, Workshop, Queue, Count };
+inline constexpr size_t kLoadoutRuleCount = static_cast<size_t>(LoadoutRule::Count);
+
+const char* LoadoutRuleName(LoadoutRule rule);
+
+// The preset list as of one generation. Published as an immutable
+// shared_ptr: readers keep the one they got for as long as they like, and
+// compare generations to see whether anything changed.
+struct LoadoutSnapshot {
+    uint64_t generation = 0;           // Bumped when the presets or the equipped preset change
+    std::vector<std::string> names;    // Named presets, in game order
+    std::unordered_map<std::string, int> presetIndex;  // Name -> index in GetPresets()
+    int presetCount = 0;               // GetPresets().Count() when names was read
+    std::string current;               // Equipped preset; empty until read
+    bool ready = false;                // The presets have been read at least once
+};
 
 // LoadoutManager: Utility class for managing car loadout operations
-// 
+//
 // Purpose: Encapsulates all LoadoutSaveWrapper operations for loadout switching
 // and management. Provides a clean interface for the main plugin to interact
 // with the BakkesMod loadout system without directly handling wrapper null
@@ -17,18 +69,37 @@
 //
 // Design Principles:
 // - Always get fresh wrapper references (never store)
-// - Thread-safe operations using gameWrapper->Execute()
-// - Null checks for all wrapper operations
-// - Return bool for success/failure to enable error handling
+// - Every operation is a task run on the game thread through
+//   gameWrapper->Execute(); nothing waits for it
+// - Each task completes exactly once: its future becomes ready and its
+//   callback (if any) runs on the game thread (on the caller's thread for
+//   requests rejected before queueing). A task BakkesMod drops
+//   without running completes as Cancelled instead; its callback does not
+//   run, since the plugin may already be gone.
+// - Results also land in a cached State, so the UI reads GetState() each
+//   frame instead of holding futures
+// - The preset list is a generation-stamped LoadoutSnapshot with a
+//   name -> preset index map, so a switch is one lookup, one GetName check
+//   and EquipPreset. Poll (every game tick, throttled to kPollInterval)
+//   compares the preset count and the equipped preset against the last
+//   ones seen and publishes a new generation when either changed.
+// - Rules ("training -> preset A") are resolved to a preset index
+//   whenever a rule or the snapshot changes, so ApplyRule at match end is
+//   a count check and one EquipPreset, with no name lookup
 //
 // Usage Example:
-//   LoadoutManager loadoutMgr(gameWrapper);
-//   auto names = loadoutMgr.GetLoadoutNames();
-//   bool success = loadoutMgr.SwitchLoadout("My Loadout");
+//   LoadoutManager loadoutMgr(gameWrapper, timerWheel);
+//   loadoutMgr.SwitchLoadout("My Loadout", [](const LoadoutResult& r) {
+//       if (!r.Ok()) LOG("Switch failed: {}", r.error);
+//   });
+//   auto state = loadoutMgr.GetState();  // render thread
+//   if (state.pending > 0) ImGui::TextDisabled("Updating...");
+//   if (state.presets->generation != seen) { /* rebuild derived UI */ }
 //
 // BakkesMod API Used:
 // - GameWrapper::GetUserLoadoutSave() - Access LoadoutSaveWrapper
 // - LoadoutSaveWrapper::GetPresets() - Get all saved loadouts
+// - LoadoutSaveWrapper::GetEquippedLoadout() - Currently active preset
 // - LoadoutSaveWrapper::EquipPreset() - Switch active loadout
 // - LoadoutSetWrapper::GetName() - Get loadout preset name
 //
@@ -36,51 +107,74 @@
 class LoadoutManager
 {
 public:
-    // Constructor: Takes gameWrapper for accessing BakkesMod API
-    explicit LoadoutManager(std::shared_ptr<GameWrapper> gameWrapper);
-    
-    // Get all available loadout names
-    // Returns: Vector of loadout name strings (empty if none available)
-    // Note: This queries the LoadoutSaveWrapper for saved loadout presets
-    std::vector<std::string> GetLoadoutNames();
-    
-    // Get the currently active loadout name
-    // Returns: Current loadout name (empty string if not available)
-    std::string GetCurrentLoadoutName();
-    
-    // Switch to a loadout by name
-    // Parameters:
-    //   loadoutName - Name of the loadout to switch to
-    // Returns: true if successful, false otherwise
-    // Note: Uses gameWrapper->Execute() for thread safety
-    bool SwitchLoadout(const std::string& loadoutName);
-    
-    // Switch to a loadout by index
-    // Parameters:
-    //   index - Index in the loadout names list (0-based)
-    // Returns: true if successful, false otherwise
-    bool SwitchLoadout(int index);
-    
-    // Refresh the cached loadout list
-    // Returns: true if refresh successful, false otherwise
+    using Completion = std::function<void(const LoadoutResult&)>;
+
+    static constexpr std::chrono::milliseconds kPollInterval{ 250 };
+
+    // What the finished tasks have reported so far
+    struct State {
+        std::shared_ptr<const LoadoutSnapshot> presets;  // Never null
+        std::string lastError;  // From the newest finished task; empty if it succeeded
+        int pending = 0;        // Tasks submitted but not finished
+    };
+
+    // Constructor: Takes gameWrapper for accessing BakkesMod API, and the
+    // plugin's timer wheel for the deferred initial query (timers must
+    // outlive this manager)
+    LoadoutManager(std::shared_ptr<GameWrapper> gameWrapper, TimerWheel& timers);
+    ~LoadoutManager();
+
+    // Queues request for the game thread. onDone runs there once the task
+    // ran; the future is ready at the same point (or Cancelled, see above).
+    // Callable from any thread; never blocks.
+    std::future<LoadoutResult> Submit(LoadoutRequest request, Completion onDone = {});
+
+    // Re-reads the preset names and the equipped preset in one hop
     // Note: Call this after creating/deleting loadouts externally
-    bool RefreshLoadoutCache();
-    
+    std::future<LoadoutResult> RefreshLoadoutCache(Completion onDone = {});
+
+    // Equips the named preset, then reads back the equipped name
+    std::future<LoadoutResult> SwitchLoadout(const std::string& loadoutName, Completion onDone = {});
+
+    // Same, by index into the cached names (Unavailable if out of range)
+    std::future<LoadoutResult> SwitchLoadout(int index, Completion onDone = {});
+
+    // Cheap enough to call every frame: the preset list is shared, not copied
+    State GetState() const;
+    std::shared_ptr<const LoadoutSnapshot> GetSnapshot() const;
+
+    // Rule presets by name; empty = leave the loadout alone. Any thread.
+    void SetRule(LoadoutRule rule, std::string presetName);
+    std::string GetRule(LoadoutRule rule) const;
+
+    // Game thread: equips the rule's pre-resolved preset now. Ok without a
+    // switch when the rule is empty or its preset is already equipped;
+    // falls back to a by-name switch if the presets changed since the last
+    // resolve (a preset count the snapshot has not caught up with).
+    LoadoutResult ApplyRule(LoadoutRule rule);
+
+    // Game thread, every tick: picks up presets created, deleted or
+    // equipped outside SuiteSpot (at most once per kPollInterval)
+    void Poll();
+
     // Check if LoadoutManager is ready (initialized)
-    // Returns: true if initialization completed, false otherwise
+    // Returns: true if the presets have been read, false otherwise
     bool IsReady() const;
 
 private:
+    struct Shared;
+    struct Task;
+
+    // Runs on the game thread; publishes what it learned to shared
+    static LoadoutResult RunTask(GameWrapper* gw, const LoadoutRequest& request, Shared& shared);
+    // An already-finished future, for requests rejected up front
+    static std::future<LoadoutResult> Completed(LoadoutStatus status, std::string error, const Completion& onDone);
+
     std::shared_ptr<GameWrapper> gameWrapper_;
-    
-    // Cached loadout names (refreshed on demand)
-    std::vector<std::string> cachedLoadoutNames_;
-    
-    // Thread safety
-    mutable std::mutex cacheMutex_;
-    std::atomic<bool> initialized_{false};
-    
-    // Internal helper: Query loadout names from LoadoutSaveWrapper
-    // Populates cachedLoadoutNames_
-    void QueryLoadoutNamesInternal();
+    TimerWheel& timers_;
+    TimerHandle initTimer_;
+
+    // Snapshot and counters; queued tasks hold a reference, so they stay
+    // valid if this manager is destroyed first
+    std::shared_ptr<Shared> shared_;
 };
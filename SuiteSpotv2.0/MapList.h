@@ -1,5 +1,7 @@
 #pragma once
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Freeplay maps
@@ -10,22 +12,34 @@ struct MapEntry {
 extern std::vector<MapEntry> RLMaps;
 
 // Training packs
+//
+// Strings are std::pmr so a whole catalog can be built inside one arena
+// (see CatalogArena). Entries constructed without a resource use the
+// default heap, and copying an entry always lands on the default heap,
+// so a copy never points into an arena that may later be released.
 struct TrainingEntry {
-    std::string code;
-    std::string name;
+    std::pmr::string code;
+    std::pmr::string name;
     
     // Prejump metadata
-    std::string creator;            // Creator's display name
-    std::string creatorSlug;        // Creator's username (for linking)
-    std::string difficulty;         // Bronze, Gold, Platinum, Diamond, Champion, Supersonic Legend
-    std::vector<std::string> tags;  // Array of tags
-    int shotCount = 0;              // Number of shots
-    std::string staffComments;      // Staff description
-    std::string notes;              // Creator's notes
-    std::string videoUrl;           // Optional YouTube link
-    int likes = 0;                  // Engagement metric
-    int plays = 0;                  // Engagement metric
-    int status = 1;                 // Pack status (1 = active)
+    std::pmr::string creator;            // Creator's display name
+    std::pmr::string creatorSlug;        // Creator's username (for linking)
+    std::pmr::string difficulty;         // Bronze, Gold, Platinum, Diamond, Champion, Supersonic Legend
+    std::pmr::vector<std::pmr::string> tags;  // Array of tags
+    int shotCount = 0;                   // Number of shots
+    std::pmr::string staffComments;      // Staff description
+    std::pmr::string notes;              // Creator's notes
+    std::pmr::string videoUrl;           // Optional YouTube link
+    int likes = 0;                       // Engagement metric
+    int plays = 0;                       // Engagement metric
+    int status = 1;                      // Pack status (1 = active)
+
+    TrainingEntry() = default;
+    TrainingEntry(std::string_view code, std::string_view name) : code(code), name(name) {}
+    // Every string and the tag array allocate from resource
+    explicit TrainingEntry(std::pmr::memory_resource* resource)
+        : code(resource), name(resource), creator(resource), creatorSlug(resource), difficulty(resource),
+          tags(resource), staffComments(resource), notes(resource), videoUrl(resource) {}
 };
 extern std::vector<TrainingEntry> RLTraining;
 
@@ -0,0 +1,45 @@
+#include "pch.h"
+#include "MatchEndPipeline.h"
+
+#include <cstdio>
+
+bool MatchEndPipeline::Submit(std::string_view matchKey, std::string_view source, Clock::time_point now)
+{
+    if (hasLast_ && now - lastAccepted_ < window_) {
+        // Unknown identity on either side: inside the window it is the same match
+        if (matchKey.empty() || lastKey_.empty() || matchKey == lastKey_) {
+            ++coalesced_;
+            return false;
+        }
+    }
+
+    lastKey_.assign(matchKey.data(), matchKey.size());
+    lastSource_.assign(source.data(), source.size());
+    lastAccepted_ = now;
+    hasLast_ = true;
+    ++accepted_;
+    return true;
+}
+
+void MatchEndPipeline::Reset()
+{
+    lastKey_.clear();
+    lastSource_.clear();
+    hasLast_ = false;
+}
+
+std::string MatchIdentity(std::string_view matchGuid, uint64_t eventAddress)
+{
+    if (eventAddress == 0) return {};
+    if (!matchGuid.empty()) return std::string(matchGuid);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "event@%llx", static_cast<unsigned long long>(eventAddress));
+    return buf;
+}
+
+bool AcceptMatchEnd(MatchEndPipeline& pipeline, std::string_view matchGuid, uint64_t eventAddress,
+                    std::string_view source, std::string& matchKey, MatchEndPipeline::Clock::time_point now)
+{
+    matchKey = MatchIdentity(matchGuid, eventAddress);
+    return pipeline.Submit(matchKey, source, now);
+}
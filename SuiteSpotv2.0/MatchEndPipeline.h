@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// MatchEndPipeline: Collapses duplicate match-ended signals into one
+//
+// Purpose: Two hooks report the end of a match
+// (GameEvent_Soccar_TA.EventMatchEnded and
+// AchievementManager_TA.HandleMatchEnded) and both usually fire for the
+// same match. Without a gate, the scoreboard is captured twice and every
+// load_* / queue command is scheduled twice. Every signal is submitted
+// here with an identity for the match it belongs to; only the first
+// signal per match is accepted and the rest are counted as coalesced.
+//
+// Match identity: the caller supplies a key (the server's match GUID when
+// the game provides one, otherwise the game event's address). A signal
+// is a duplicate when it arrives within the coalescing window of the last
+// accepted one and either carries the same key or no usable key at all.
+// A different key inside the window is a new match (e.g. a back-to-back
+// private match) and is accepted.
+//
+// Threading: Game thread only (both hooks run there).
+//
+// Usage Example:
+//   std::string matchKey;
+//   if (!AcceptMatchEnd(matchEnds, server.GetMatchGUID(), server.memory_address, hookName, matchKey)) return;  // duplicate
+//   CaptureMatchResult(); RunPostMatchActions();
+class MatchEndPipeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration kDefaultWindow = std::chrono::seconds(10);
+
+    explicit MatchEndPipeline(Clock::duration window = kDefaultWindow) : window_(window) {}
+
+    // True for the first signal of a match; false for a duplicate
+    bool Submit(std::string_view matchKey, std::string_view source, Clock::time_point now = Clock::now());
+
+    // Forget the last match (e.g. after leaving to the main menu)
+    void Reset();
+
+    void SetWindow(Clock::duration window) { window_ = window; }
+    Clock::duration GetWindow() const { return window_; }
+
+    const std::string& GetLastKey() const { return lastKey_; }
+    const std::string& GetLastSource() const { return lastSource_; }  // source of the accepted signal
+    uint64_t GetAcceptedCount() const { return accepted_; }
+    uint64_t GetCoalescedCount() const { return coalesced_; }
+
+private:
+    Clock::duration window_;
+    std::string lastKey_;
+    std::string lastSource_;
+    Clock::time_point lastAccepted_{};
+    bool hasLast_ = false;
+    uint64_t accepted_ = 0;
+    uint64_t coalesced_ = 0;
+};
+
+// Server match GUID, else "event@<address>" of the game event; empty when
+// eventAddress is 0 (no game event, e.g. in menus)
+std::string MatchIdentity(std::string_view matchGuid, uint64_t eventAddress);
+
+// SuiteSpot::GameEndedEvent's decision for one match-ended hook: builds the
+// identity into matchKey and submits it. True when the capture and
+// post-match actions should run.
+bool AcceptMatchEnd(MatchEndPipeline& pipeline, std::string_view matchGuid, uint64_t eventAddress,
+                    std::string_view source, std::string& matchKey,
+                    MatchEndPipeline::Clock::time_point now = MatchEndPipeline::Clock::now());
@@ -0,0 +1,619 @@
+#include "pch.h"
+#include "MatchHistory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+    // The view keeps the section alive; neither handle is needed after this
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return false;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return false;
+    data_ = static_cast<const std::byte*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    data_ = static_cast<const std::byte*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MatchAggregate::Add(const MatchIndexEntry& entry)
+{
+    const bool win = (entry.flags & MatchIndexEntry::kWin) != 0;
+    ++games;
+    if (win) ++wins;
+    if (entry.flags & MatchIndexEntry::kOvertime) ++overtimes;
+    goalsFor += entry.myScore;
+    goalsAgainst += entry.oppScore;
+    if (entry.flags & MatchIndexEntry::kHasLocal) {
+        ++withLocal;
+        goals += entry.goals;
+        assists += entry.assists;
+        saves += entry.saves;
+        shots += entry.shots;
+        score += entry.localScore;
+        if (entry.flags & MatchIndexEntry::kLocalMvp) ++mvps;
+    }
+
+    TrendPoint& slot = trend[trendHead];
+    if (trendCount == kTrendWindow) {
+        trendWins -= slot.win ? 1 : 0;
+        trendGoals -= slot.goals;
+    } else {
+        ++trendCount;
+    }
+    slot.goals = entry.goals;
+    slot.win = win;
+    trendWins += win ? 1 : 0;
+    trendGoals += entry.goals;
+    trendHead = (trendHead + 1) % kTrendWindow;
+}
+
+std::vector<float> MatchAggregate::TrendGoalsSeries() const
+{
+    std::vector<float> series;
+    series.reserve(trendCount);
+    const uint32_t start = trendCount < kTrendWindow ? 0 : trendHead;
+    for (uint32_t i = 0; i < trendCount; ++i) {
+        series.push_back(trend[(start + i) % kTrendWindow].goals);
+    }
+    return series;
+}
+
+std::string FormatMatchAggregate(std::string_view label, const MatchAggregate& stats)
+{
+    char buf[224];
+    snprintf(buf, sizeof(buf), "%-24.*s n=%-5u win %3.0f%%  goals/g %.2f  mvp %3.0f%%  last %u: win %3.0f%% goals/g %.2f",
+             static_cast<int>(label.size()), label.data(), stats.games, stats.WinRate() * 100.0, stats.GoalsPerGame(),
+             stats.MvpRate() * 100.0, stats.trendCount, stats.TrendWinRate() * 100.0, stats.TrendGoalsPerGame());
+    return buf;
+}
+
+namespace
+{
+    // Log:    LogHeader, then records (RecordHeader + payload)
+    // Index:  IndexHeader, then MatchIndexEntry[]
+    constexpr uint32_t kLogMagic = 0x4C4D5353;     // "SSML"
+    constexpr uint32_t kIndexMagic = 0x494D5353;   // "SSMI"
+    constexpr uint32_t kRecordMagic = 0x524D5353;  // "SSMR"
+    constexpr uint32_t kFormatVersion = 1;
+
+    struct LogHeader {
+        uint32_t magic = kLogMagic;
+        uint32_t version = kFormatVersion;
+        uint64_t reserved = 0;
+    };
+    struct IndexHeader {
+        uint32_t magic = kIndexMagic;
+        uint32_t version = kFormatVersion;
+        uint8_t reserved[24] = {};
+    };
+    struct RecordHeader {
+        uint32_t magic = kRecordMagic;
+        uint32_t payloadSize = 0;
+        uint32_t checksum = 0;  // FNV-1a of the payload; catches torn writes
+    };
+    static_assert(sizeof(IndexHeader) == sizeof(MatchIndexEntry), "keeps index entries aligned to their size");
+
+    // Largest record: 8 players with 255-byte names plus three 255-byte strings
+    constexpr uint32_t kMaxPayload = 4096;
+
+    uint32_t Fnv1a(const std::byte* data, size_t size)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    uint8_t ClampU8(int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+    class RecordWriter
+    {
+    public:
+        explicit RecordWriter(std::vector<std::byte>& out) : out_(out) {}
+
+        template <typename T>
+        void Put(T value)
+        {
+            const size_t at = out_.size();
+            out_.resize(at + sizeof(T));
+            std::memcpy(out_.data() + at, &value, sizeof(T));
+        }
+
+        // u8 length, then the bytes; names longer than 255 bytes are cut
+        void PutString(std::string_view s)
+        {
+            const size_t n = std::min<size_t>(s.size(), 255);
+            Put<uint8_t>(static_cast<uint8_t>(n));
+            const size_t at = out_.size();
+            out_.resize(at + n);
+            std::memcpy(out_.data() + at, s.data(), n);
+        }
+
+    private:
+        std::vector<std::byte>& out_;
+    };
+
+    class RecordReader
+    {
+    public:
+        explicit RecordReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+        template <typename T>
+        T Get()
+        {
+            T value{};
+            if (pos_ + sizeof(T) > bytes_.size()) {
+                ok_ = false;
+                return value;
+            }
+            std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return value;
+        }
+
+        void GetString(std::string& out)
+        {
+            const size_t n = Get<uint8_t>();
+            if (!ok_ || pos_ + n > bytes_.size()) {
+                ok_ = false;
+                out.clear();
+                return;
+            }
+            out.assign(reinterpret_cast<const char*>(bytes_.data() + pos_), n);
+            pos_ += n;
+        }
+
+        bool Ok() const { return ok_; }
+
+    private:
+        std::span<const std::byte> bytes_;
+        size_t pos_ = 0;
+        bool ok_ = true;
+    };
+
+    // Payload: i64 time, u16 my/opp score, u8 overtime, u8 player count,
+    // playlist, my team, opp team, then per player: i8 team, u8 flags
+    // (1 local, 2 MVP), i32 score, u8 goals/assists/saves/shots, u16 ping, name
+    void EncodeRecord(const PostMatchInfo& info, int64_t unixTime, std::vector<std::byte>& out)
+    {
+        out.clear();
+        out.resize(sizeof(RecordHeader));
+        RecordWriter w(out);
+        w.Put<int64_t>(unixTime);
+        w.Put<uint16_t>(static_cast<uint16_t>(std::clamp(info.myScore, 0, 65535)));
+        w.Put<uint16_t>(static_cast<uint16_t>(std::clamp(info.oppScore, 0, 65535)));
+        w.Put<uint8_t>(info.overtime ? 1 : 0);
+        const auto players = info.Players();
+        w.Put<uint8_t>(static_cast<uint8_t>(players.size()));
+        w.PutString(info.playlist);
+        w.PutString(info.myTeamName);
+        w.PutString(info.oppTeamName);
+        for (const auto& row : players) {
+            w.Put<int8_t>(static_cast<int8_t>(std::clamp(row.teamIndex, -1, 127)));
+            w.Put<uint8_t>(static_cast<uint8_t>((row.isLocal ? 1 : 0) | (row.isMVP ? 2 : 0)));
+            w.Put<int32_t>(row.score);
+            w.Put<uint8_t>(ClampU8(row.goals));
+            w.Put<uint8_t>(ClampU8(row.assists));
+            w.Put<uint8_t>(ClampU8(row.saves));
+            w.Put<uint8_t>(ClampU8(row.shots));
+            w.Put<uint16_t>(static_cast<uint16_t>(std::clamp(row.ping, 0, 65535)));
+            w.PutString(row.name);
+        }
+
+        RecordHeader header;
+        header.payloadSize = static_cast<uint32_t>(out.size() - sizeof(RecordHeader));
+        header.checksum = Fnv1a(out.data() + sizeof(RecordHeader), header.payloadSize);
+        std::memcpy(out.data(), &header, sizeof(header));
+    }
+
+    // Validates the record at the start of bytes; recordSize is header plus
+    // payload. out may be null to only validate.
+    bool DecodeRecord(std::span<const std::byte> bytes, size_t& recordSize, MatchRecord* out)
+    {
+        RecordHeader header;
+        if (bytes.size() < sizeof(header)) return false;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != kRecordMagic || header.payloadSize > kMaxPayload) return false;
+        if (bytes.size() - sizeof(header) < header.payloadSize) return false;
+        const auto payload = bytes.subspan(sizeof(header), header.payloadSize);
+        if (Fnv1a(payload.data(), payload.size()) != header.checksum) return false;
+        recordSize = sizeof(header) + header.payloadSize;
+        if (!out) return true;
+
+        RecordReader r(payload);
+        out->unixTime = r.Get<int64_t>();
+        out->myScore = r.Get<uint16_t>();
+        out->oppScore = r.Get<uint16_t>();
+        out->overtime = r.Get<uint8_t>() != 0;
+        const size_t playerCount = std::min<size_t>(r.Get<uint8_t>(), kMaxPostMatchPlayers);
+        r.GetString(out->playlist);
+        r.GetString(out->myTeamName);
+        r.GetString(out->oppTeamName);
+        out->players.resize(playerCount);
+        for (auto& row : out->players) {
+            row.teamIndex = r.Get<int8_t>();
+            const uint8_t flags = r.Get<uint8_t>();
+            row.isLocal = (flags & 1) != 0;
+            row.isMVP = (flags & 2) != 0;
+            row.score = r.Get<int32_t>();
+            row.goals = r.Get<uint8_t>();
+            row.assists = r.Get<uint8_t>();
+            row.saves = r.Get<uint8_t>();
+            row.shots = r.Get<uint8_t>();
+            row.ping = r.Get<uint16_t>();
+            r.GetString(row.name);
+        }
+        return r.Ok();
+    }
+
+    MatchIndexEntry MakeEntry(uint64_t offset, int64_t unixTime, std::string_view playlist, int myScore, int oppScore,
+                              bool overtime, std::span<const PostMatchPlayerRow> players)
+    {
+        MatchIndexEntry entry;
+        entry.offset = offset;
+        entry.unixTime = unixTime;
+        entry.playlistHash = MatchHistory::PlaylistHash(playlist);
+        entry.myScore = ClampU8(myScore);
+        entry.oppScore = ClampU8(oppScore);
+        if (myScore > oppScore) entry.flags |= MatchIndexEntry::kWin;
+        if (overtime) entry.flags |= MatchIndexEntry::kOvertime;
+        for (const auto& row : players) {
+            if (!row.isLocal) continue;
+            entry.flags |= MatchIndexEntry::kHasLocal;
+            if (row.isMVP) entry.flags |= MatchIndexEntry::kLocalMvp;
+            entry.localScore = static_cast<uint16_t>(std::clamp(row.score, 0, 65535));
+            entry.goals = ClampU8(row.goals);
+            entry.assists = ClampU8(row.assists);
+            entry.saves = ClampU8(row.saves);
+            entry.shots = ClampU8(row.shots);
+            break;
+        }
+        return entry;
+    }
+}
+
+uint32_t MatchHistory::PlaylistHash(std::string_view playlist)
+{
+    const uint32_t hash = Fnv1a(reinterpret_cast<const std::byte*>(playlist.data()), playlist.size());
+    return hash ? hash : 1;
+}
+
+// #detailed comments: MatchHistory::Open
+// Purpose: Map both files and build the in-memory aggregates. A missing
+// log starts empty; a log with a foreign header is left untouched and
+// history stays off. The index is trusted only when its last entry ends
+// exactly at the end of the log; anything else is rebuilt from the log.
+bool MatchHistory::Open(const std::filesystem::path& logPath, const std::filesystem::path& indexPath, std::string& error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResetLocked();
+    logPath_ = logPath;
+    indexPath_ = indexPath;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(logPath_, ec) || std::filesystem::file_size(logPath_, ec) == 0) {
+        std::ofstream out(logPath_, std::ios::binary | std::ios::trunc);
+        const LogHeader header;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!out) {
+            error = "cannot create " + logPath_.string();
+            return false;
+        }
+    }
+    if (!log_.Open(logPath_)) {
+        error = "cannot map " + logPath_.string();
+        return false;
+    }
+    LogHeader logHeader;
+    const auto logBytes = log_.Bytes();
+    if (logBytes.size() >= sizeof(logHeader)) std::memcpy(&logHeader, logBytes.data(), sizeof(logHeader));
+    if (logBytes.size() < sizeof(logHeader) || logHeader.magic != kLogMagic || logHeader.version != kFormatVersion) {
+        error = logPath_.string() + " is not a version " + std::to_string(kFormatVersion) + " match history log";
+        log_.Close();
+        return false;
+    }
+
+    bool indexValid = false;
+    if (std::filesystem::exists(indexPath_, ec) && index_.Open(indexPath_)) {
+        const auto indexBytes = index_.Bytes();
+        IndexHeader indexHeader;
+        if (indexBytes.size() >= sizeof(indexHeader)) std::memcpy(&indexHeader, indexBytes.data(), sizeof(indexHeader));
+        if (indexBytes.size() >= sizeof(indexHeader) && indexHeader.magic == kIndexMagic && indexHeader.version == kFormatVersion
+            && (indexBytes.size() - sizeof(indexHeader)) % sizeof(MatchIndexEntry) == 0) {
+            count_ = (indexBytes.size() - sizeof(indexHeader)) / sizeof(MatchIndexEntry);
+            if (count_ == 0) {
+                indexValid = logBytes.size() == sizeof(LogHeader);
+            } else {
+                const MatchIndexEntry last = EntryAt(count_ - 1);
+                size_t recordSize = 0;
+                indexValid = last.offset >= sizeof(LogHeader) && last.offset < logBytes.size()
+                    && DecodeRecord(logBytes.subspan(last.offset), recordSize, nullptr)
+                    && last.offset + recordSize == logBytes.size();
+            }
+        }
+    }
+    if (!indexValid && !RebuildIndex(error)) {
+        ResetLocked();
+        return false;
+    }
+    logEnd_ = log_.Bytes().size();
+
+    MatchRecord record;
+    for (size_t i = 0; i < count_; ++i) {
+        const MatchIndexEntry entry = EntryAt(i);
+        std::string_view name;
+        if (playlists_.find(entry.playlistHash) == playlists_.end()) {
+            // First match of a playlist: its name only lives in the log
+            size_t recordSize = 0;
+            if (DecodeRecord(log_.Bytes().subspan(entry.offset), recordSize, &record)) name = record.playlist;
+        }
+        AddToAggregates(static_cast<uint32_t>(i), entry, name);
+    }
+    open_ = true;
+    return true;
+}
+
+// Scans the log's valid records, cuts off a torn tail and writes a fresh
+// index next to the old one before replacing it
+bool MatchHistory::RebuildIndex(std::string& error)
+{
+    const auto bytes = log_.Bytes();
+    std::vector<MatchIndexEntry> entries;
+    MatchRecord record;
+    size_t pos = sizeof(LogHeader);
+    while (pos < bytes.size()) {
+        size_t recordSize = 0;
+        if (!DecodeRecord(bytes.subspan(pos), recordSize, &record)) break;
+        entries.push_back(MakeEntry(pos, record.unixTime, record.playlist, record.myScore, record.oppScore, record.overtime, record.players));
+        pos += recordSize;
+    }
+    const size_t logSize = bytes.size();
+    log_.Close();
+    index_.Close();
+
+    std::error_code ec;
+    if (pos < logSize) {
+        std::filesystem::resize_file(logPath_, pos, ec);
+        if (ec) {
+            error = "cannot truncate " + logPath_.string() + ": " + ec.message();
+            return false;
+        }
+    }
+
+    auto tmpPath = indexPath_;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        const IndexHeader header;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(MatchIndexEntry)));
+        if (!out) {
+            error = "cannot write " + tmpPath.string();
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, indexPath_, ec);
+    if (ec) {
+        error = "cannot replace " + indexPath_.string() + ": " + ec.message();
+        return false;
+    }
+    return Remap(error);
+}
+
+bool MatchHistory::Remap(std::string& error)
+{
+    if (!log_.Open(logPath_) || !index_.Open(indexPath_)) {
+        error = "cannot map match history files";
+        return false;
+    }
+    const size_t indexSize = index_.Bytes().size();
+    count_ = indexSize > sizeof(IndexHeader) ? (indexSize - sizeof(IndexHeader)) / sizeof(MatchIndexEntry) : 0;
+    return true;
+}
+
+void MatchHistory::ResetLocked()
+{
+    open_ = false;
+    log_.Close();
+    index_.Close();
+    count_ = 0;
+    logEnd_ = 0;
+    overall_ = {};
+    playlists_.clear();
+}
+
+void MatchHistory::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResetLocked();
+}
+
+bool MatchHistory::IsOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+MatchIndexEntry MatchHistory::EntryAt(size_t i) const
+{
+    MatchIndexEntry entry;
+    std::memcpy(&entry, index_.Bytes().data() + sizeof(IndexHeader) + i * sizeof(MatchIndexEntry), sizeof(entry));
+    return entry;
+}
+
+void MatchHistory::AddToAggregates(uint32_t position, const MatchIndexEntry& entry, std::string_view playlistName)
+{
+    overall_.Add(entry);
+    Playlist& playlist = playlists_[entry.playlistHash];
+    if (playlist.name.empty()) playlist.name.assign(playlistName.empty() ? std::string_view("Unknown") : playlistName);
+    playlist.stats.Add(entry);
+    playlist.matches.push_back(position);
+}
+
+// #detailed comments: MatchHistory::Append
+// Purpose: Write one result: the log record first, then its index entry,
+// so a crash in between leaves an unindexed record that the next Open
+// picks up. On a write error history turns off until the next Open
+// rather than appending past a damaged tail.
+bool MatchHistory::Append(const PostMatchInfo& info, int64_t unixTime, std::string& error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        error = "match history is not open";
+        return false;
+    }
+
+    EncodeRecord(info, unixTime, scratch_);
+    const MatchIndexEntry entry = MakeEntry(logEnd_, unixTime, info.playlist, info.myScore, info.oppScore, info.overtime, info.Players());
+    {
+        std::ofstream out(logPath_, std::ios::binary | std::ios::app);
+        out.write(reinterpret_cast<const char*>(scratch_.data()), static_cast<std::streamsize>(scratch_.size()));
+        if (!out) {
+            error = "cannot append to " + logPath_.string();
+            ResetLocked();
+            return false;
+        }
+    }
+    {
+        std::ofstream out(indexPath_, std::ios::binary | std::ios::app);
+        out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        if (!out) {
+            error = "cannot append to " + indexPath_.string();
+            ResetLocked();
+            return false;
+        }
+    }
+
+    logEnd_ += scratch_.size();
+    const auto position = static_cast<uint32_t>(count_);
+    if (!Remap(error)) {
+        ResetLocked();
+        return false;
+    }
+    AddToAggregates(position, entry, info.playlist);
+    return true;
+}
+
+size_t MatchHistory::Count(uint32_t playlistHash) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (playlistHash == 0) return count_;
+    const auto it = playlists_.find(playlistHash);
+    return it == playlists_.end() ? 0 : it->second.matches.size();
+}
+
+MatchAggregate MatchHistory::Stats(uint32_t playlistHash) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (playlistHash == 0) return overall_;
+    const auto it = playlists_.find(playlistHash);
+    return it == playlists_.end() ? MatchAggregate{} : it->second.stats;
+}
+
+std::vector<MatchHistory::PlaylistStats> MatchHistory::Playlists() const
+{
+    std::vector<PlaylistStats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(playlists_.size());
+        for (const auto& [hash, playlist] : playlists_) {
+            result.push_back({ hash, playlist.name, playlist.stats });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const PlaylistStats& a, const PlaylistStats& b) {
+        if (a.stats.games != b.stats.games) return a.stats.games > b.stats.games;
+        return a.name < b.name;
+    });
+    return result;
+}
+
+std::string MatchHistory::PlaylistName(uint32_t playlistHash) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = playlists_.find(playlistHash);
+    return it == playlists_.end() ? std::string() : it->second.name;
+}
+
+bool MatchHistory::GetNewest(uint32_t playlistHash, size_t pos, MatchIndexEntry& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (playlistHash == 0) {
+        if (pos >= count_) return false;
+        out = EntryAt(count_ - 1 - pos);
+        return true;
+    }
+    const auto it = playlists_.find(playlistHash);
+    if (it == playlists_.end() || pos >= it->second.matches.size()) return false;
+    out = EntryAt(it->second.matches[it->second.matches.size() - 1 - pos]);
+    return true;
+}
+
+bool MatchHistory::ReadRecord(const MatchIndexEntry& entry, MatchRecord& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto bytes = log_.Bytes();
+    if (!open_ || entry.offset >= bytes.size()) return false;
+    size_t recordSize = 0;
+    return DecodeRecord(bytes.subspan(entry.offset), recordSize, &out);
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "PostMatchInfo.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// MappedFile: Read-only view of a whole file (MapViewOfFile, mmap elsewhere)
+//
+// The view stays valid until Close or the next Open; it does not grow with
+// the file, so writers re-Open after appending. An empty file maps to an
+// empty view.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    std::span<const std::byte> Bytes() const { return { data_, size_ }; }
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// One match in the index file. Fixed size, so entry i sits at
+// 32 + i * 32 (after the header) and needs no parsing; it carries everything
+// the aggregates and the history list use, so only the details view reads
+// the log record. Written in host byte order (the plugin is x64 only).
+struct MatchIndexEntry {
+    static constexpr uint8_t kWin = 1 << 0;
+    static constexpr uint8_t kOvertime = 1 << 1;
+    static constexpr uint8_t kLocalMvp = 1 << 2;
+    static constexpr uint8_t kHasLocal = 1 << 3;  // The local player has a row (not spectating)
+
+    uint64_t offset = 0;        // Record start in the log
+    int64_t unixTime = 0;
+    uint32_t playlistHash = 0;  // MatchHistory::PlaylistHash
+    uint16_t localScore = 0;
+    uint8_t myScore = 0;
+    uint8_t oppScore = 0;
+    uint8_t flags = 0;
+    uint8_t goals = 0;          // Local player's stats
+    uint8_t assists = 0;
+    uint8_t saves = 0;
+    uint8_t shots = 0;
+    uint8_t reserved[3] = {};
+};
+static_assert(sizeof(MatchIndexEntry) == 32, "index entries are written as is");
+
+// Running totals for a set of matches; Add is O(1)
+struct MatchAggregate {
+    static constexpr size_t kTrendWindow = 20;
+
+    struct TrendPoint {
+        uint8_t goals = 0;
+        bool win = false;
+    };
+
+    uint32_t games = 0;
+    uint32_t wins = 0;
+    uint32_t overtimes = 0;
+    uint32_t withLocal = 0;  // Games with a local player row; the per-player rates divide by this
+    uint32_t mvps = 0;
+    uint64_t goals = 0;
+    uint64_t assists = 0;
+    uint64_t saves = 0;
+    uint64_t shots = 0;
+    uint64_t score = 0;
+    uint64_t goalsFor = 0;      // Team scores
+    uint64_t goalsAgainst = 0;
+
+    // Last kTrendWindow games in a ring, with their sums kept alongside
+    std::array<TrendPoint, kTrendWindow> trend{};
+    uint32_t trendCount = 0;
+    uint32_t trendHead = 0;  // Next slot to overwrite (the oldest once full)
+    uint32_t trendWins = 0;
+    uint32_t trendGoals = 0;
+
+    void Add(const MatchIndexEntry& entry);
+
+    double WinRate() const { return games ? double(wins) / games : 0.0; }
+    double GoalsPerGame() const { return withLocal ? double(goals) / withLocal : 0.0; }
+    double MvpRate() const { return withLocal ? double(mvps) / withLocal : 0.0; }
+    double TrendWinRate() const { return trendCount ? double(trendWins) / trendCount : 0.0; }
+    double TrendGoalsPerGame() const { return trendCount ? double(trendGoals) / trendCount : 0.0; }
+    // Oldest first, for plotting
+    std::vector<float> TrendGoalsSeries() const;
+};
+
+// One match as stored in the log
+struct MatchRecord {
+    int64_t unixTime = 0;
+    std::string playlist;
+    std::string myTeamName;
+    std::string oppTeamName;
+    int myScore = 0;
+    int oppScore = 0;
+    bool overtime = false;
+    std::vector<PostMatchPlayerRow> players;
+};
+
+// "Ranked Doubles  n=120  win 55%  goals/g 0.91  mvp 31%  last 20: win 60% goals/g 1.05"
+std::string FormatMatchAggregate(std::string_view label, const MatchAggregate& stats);
+
+// MatchHistory: Every captured match result, kept on disk
+//
+// Purpose: PostMatchInfo is overwritten at each match end; this keeps
+// every result. Two files under SuiteTraining:
+//   - the log (SuiteMatchHistory.log): append-only, one length-prefixed,
+//     checksummed record per match with the full result (names, every
+//     player's row)
+//   - the index (SuiteMatchHistory.idx): one MatchIndexEntry per match
+// Both are memory-mapped, so a query is a pointer offset. Aggregates
+// (overall and per playlist) and per-playlist match lists are built with
+// one pass over the index at Open, then updated in O(1) by Append.
+//
+// Recovery: Append writes the log record before its index entry. At Open
+// an index that does not end exactly at the end of the log (a crash
+// between the two writes, a torn record, a missing index) is rebuilt from
+// the log; a torn record at the end of the log is cut off.
+//
+// Threading: Append runs on the game thread, queries on the render
+// thread; all access goes through one mutex.
+//
+// Usage Example:
+//   std::string error;
+//   if (!history.Open(dir / "SuiteMatchHistory.log", dir / "SuiteMatchHistory.idx", error)) LOG(error);
+//   history.Append(postMatch, std::time(nullptr), error);
+//   MatchIndexEntry newest;
+//   history.GetNewest(0, 0, newest);
+class MatchHistory
+{
+public:
+    struct PlaylistStats {
+        uint32_t hash = 0;
+        std::string name;
+        MatchAggregate stats;
+    };
+
+    // Never 0, which the queries use for "all playlists"
+    static uint32_t PlaylistHash(std::string_view playlist);
+
+    bool Open(const std::filesystem::path& logPath, const std::filesystem::path& indexPath, std::string& error);
+    void Close();
+    bool IsOpen() const;
+
+    bool Append(const PostMatchInfo& info, int64_t unixTime, std::string& error);
+
+    // playlistHash 0 = every playlist
+    size_t Count(uint32_t playlistHash = 0) const;
+    MatchAggregate Stats(uint32_t playlistHash = 0) const;
+    // Most played first
+    std::vector<PlaylistStats> Playlists() const;
+    std::string PlaylistName(uint32_t playlistHash) const;
+
+    // pos 0 = the newest match in the playlist
+    bool GetNewest(uint32_t playlistHash, size_t pos, MatchIndexEntry& out) const;
+    bool ReadRecord(const MatchIndexEntry& entry, MatchRecord& out) const;
+
+private:
+    struct Playlist {
+        std::string name;
+        MatchAggregate stats;
+        std::vector<uint32_t> matches;  // Index positions, oldest first
+    };
+
+    void ResetLocked();
+    bool Remap(std::string& error);
+    bool RebuildIndex(std::string& error);
+    MatchIndexEntry EntryAt(size_t i) const;
+    void AddToAggregates(uint32_t position, const MatchIndexEntry& entry, std::string_view playlistName);
+
+    mutable std::mutex mutex_;
+    bool open_ = false;
+    std::filesystem::path logPath_;
+    std::filesystem::path indexPath_;
+    MappedFile log_;
+    MappedFile index_;
+    size_t count_ = 0;
+    uint64_t logEnd_ = 0;
+    MatchAggregate overall_;
+    std::unordered_map<uint32_t, Playlist> playlists_;
+    std::vector<std::byte> scratch_;  // Append's record buffer, reused
+};
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "MatchStatSampler.h"
+
+#include <algorithm>
+
+uint64_t MatchStatSampler::Begin(Clock::time_point now)
+{
+    active_ = true;
+    begin_ = now;
+    interval_ = kBaseInterval;
+    intervalNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval_).count(), std::memory_order_relaxed);
+    slotIds_.fill(0);
+    last_ = StatSample{};
+
+    // Start before id: a reader that sees the new id also sees its start
+    sessionStart_.store(ring_.Written(), std::memory_order_release);
+    const uint64_t session = session_.load(std::memory_order_relaxed) + 1;
+    session_.store(session, std::memory_order_release);
+    return session;
+}
+
+// #detailed comments: MatchStatSampler::Record
+// Purpose: Map each PRI to its slot (first seen, first slot; a full
+// roster ignores latecomers) and push one sample. Slots whose PRI is
+// missing this time keep their previous values.
+void MatchStatSampler::Record(std::span<const StatReading> readings, Clock::time_point now)
+{
+    if (!active_) return;
+
+    StatSample& sample = last_;
+    sample.t = std::chrono::duration<float>(now - begin_).count();
+    for (const auto& reading : readings) {
+        size_t slot = 0;
+        while (slot < sample.playerCount && slotIds_[slot] != reading.id) ++slot;
+        if (slot == sample.playerCount) {
+            if (slot == kMaxPostMatchPlayers) continue;
+            slotIds_[slot] = reading.id;
+            ++sample.playerCount;
+        }
+        StatSamplePlayer& player = sample.players[slot];
+        player.team = static_cast<int8_t>(std::clamp(reading.team, -1, 127));
+        player.score = static_cast<int16_t>(std::clamp(reading.score, 0, 32767));
+        player.goals = static_cast<uint8_t>(std::clamp(reading.goals, 0, 255));
+        player.saves = static_cast<uint8_t>(std::clamp(reading.saves, 0, 255));
+    }
+    ring_.Push(sample);
+}
+
+void MatchStatSampler::RecordCost(Clock::duration cost)
+{
+    const auto ns = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(cost).count()));
+    samples_.fetch_add(1, std::memory_order_relaxed);
+    totalNs_.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > maxNs_.load(std::memory_order_relaxed)) maxNs_.store(ns, std::memory_order_relaxed);  // single writer
+    if (cost > kBudget) {
+        overBudget_.fetch_add(1, std::memory_order_relaxed);
+        interval_ = std::min(interval_ * 2, kMaxInterval);
+        intervalNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval_).count(), std::memory_order_relaxed);
+    }
+}
+
+size_t MatchStatSampler::CopySession(uint64_t session, std::span<StatSample> out) const
+{
+    if (session == 0 || out.empty() || session_.load(std::memory_order_acquire) != session) return 0;
+    const uint64_t start = sessionStart_.load(std::memory_order_acquire);
+    const uint64_t end = ring_.Written();
+    const uint64_t first = std::max(start, end > out.size() ? end - out.size() : 0);
+    const size_t count = ring_.Copy(first, end, out.data());
+    // A Begin during the copy means some of it may belong to the next session
+    if (session_.load(std::memory_order_acquire) != session) return 0;
+    return count;
+}
+
+StatSamplerCost MatchStatSampler::Cost() const
+{
+    StatSamplerCost cost;
+    cost.samples = samples_.load(std::memory_order_relaxed);
+    cost.totalNs = totalNs_.load(std::memory_order_relaxed);
+    cost.maxNs = maxNs_.load(std::memory_order_relaxed);
+    cost.overBudget = overBudget_.load(std::memory_order_relaxed);
+    cost.intervalSec = intervalNs_.load(std::memory_order_relaxed) / 1e9;
+    return cost;
+}
+
+void StatTimelineSeries::Build(std::span<const StatSample> samples)
+{
+    t.clear();
+    teamPoints.clear();
+    maxPoints = 0.0f;
+    for (const auto& sample : samples) {
+        std::array<float, 2> points{ 0.0f, 0.0f };
+        for (size_t i = 0; i < sample.playerCount; ++i) {
+            const auto& player = sample.players[i];
+            if (player.team == 0 || player.team == 1) points[player.team] += player.score;
+        }
+        t.push_back(sample.t);
+        teamPoints.push_back(points);
+        maxPoints = std::max({ maxPoints, points[0], points[1] });
+    }
+}
+
+float StatTimelineSeries::PointsAt(float x, int team) const
+{
+    if (t.empty() || team < 0 || team > 1) return 0.0f;
+    // Last sample at or before x
+    const auto it = std::upper_bound(t.begin(), t.end(), x);
+    const size_t i = it == t.begin() ? 0 : static_cast<size_t>(it - t.begin()) - 1;
+    return teamPoints[i][team];
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "PostMatchInfo.h"
+#include "SpscRing.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// One player's stats at one sample
+struct StatSamplePlayer {
+    int16_t score = 0;
+    uint8_t goals = 0;
+    uint8_t saves = 0;
+    int8_t team = -1;
+};
+
+// Every player's stats at one moment of a match. Player i is the i-th
+// player the session saw (players who leave keep their last values), so
+// a player's stats can be followed from sample to sample.
+struct StatSample {
+    float t = 0.0f;  // Seconds since the session began
+    uint8_t playerCount = 0;
+    std::array<StatSamplePlayer, kMaxPostMatchPlayers> players{};
+};
+
+// One PRI as read by the sampling tick
+struct StatReading {
+    uintptr_t id = 0;  // PRI address; stable for the match
+    int team = -1;
+    int score = 0;
+    int goals = 0;
+    int saves = 0;
+};
+
+struct StatSamplerCost {
+    uint64_t samples = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t overBudget = 0;  // Samples that took longer than kBudget
+    double intervalSec = 0.0;
+
+    double MeanUs() const { return samples ? totalNs / 1000.0 / samples : 0.0; }
+};
+
+// MatchStatSampler: In-match stat timeline
+//
+// Purpose: The only PRI read used to be at match end. While a session is
+// active, SuiteSpot reads every PRI's score, goals and saves once per
+// Interval() and Records them; the post-match overlay copies the session
+// back out and plots it. Samples go into a fixed SpscRing (kCapacity
+// samples, about 34 minutes at the base rate), so recording never
+// allocates and never waits for the overlay.
+//
+// Cost: The caller times each read-and-Record and reports it through
+// RecordCost. A sample over kBudget doubles the interval for the rest of
+// the session (up to kMaxInterval), so sampling cannot grow into a
+// visible slice of a game-thread frame; `ss_timeline` prints the totals.
+//
+// Threading: Begin, End, Record and RecordCost on the game thread;
+// CopySession and Cost from any thread.
+//
+// Usage Example:
+//   sampler.Begin(now);
+//   sampler.Record(readings, now);          // every Interval()
+//   sampler.End();                          // match over
+//   size_t n = sampler.CopySession(session, scratch);  // render thread
+class MatchStatSampler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kCapacity = 2048;
+    static constexpr Clock::duration kBaseInterval = std::chrono::seconds(1);
+    static constexpr Clock::duration kMaxInterval = std::chrono::seconds(8);
+    static constexpr Clock::duration kBudget = std::chrono::microseconds(200);
+
+    // Game thread: starts a session and returns its id (never 0)
+    uint64_t Begin(Clock::time_point now);
+    void End() { active_ = false; }
+    bool Active() const { return active_; }
+    uint64_t Session() const { return session_.load(std::memory_order_relaxed); }
+    Clock::duration Interval() const { return interval_; }
+
+    void Record(std::span<const StatReading> readings, Clock::time_point now);
+    void RecordCost(Clock::duration cost);
+
+    // Copies the newest samples of session (up to out.size()), oldest
+    // first; 0 when a newer session has replaced it
+    size_t CopySession(uint64_t session, std::span<StatSample> out) const;
+    StatSamplerCost Cost() const;
+
+private:
+    SpscRing<StatSample, kCapacity> ring_;
+    std::atomic<uint64_t> session_{ 0 };
+    std::atomic<uint64_t> sessionStart_{ 0 };  // Ring index of the session's first sample
+
+    // Game thread only
+    bool active_ = false;
+    Clock::time_point begin_{};
+    Clock::duration interval_ = kBaseInterval;
+    std::array<uintptr_t, kMaxPostMatchPlayers> slotIds_{};
+    StatSample last_{};  // Carries players who left forward
+
+    std::atomic<uint64_t> samples_{ 0 };
+    std::atomic<uint64_t> totalNs_{ 0 };
+    std::atomic<uint64_t> maxNs_{ 0 };
+    std::atomic<uint64_t> overBudget_{ 0 };
+    std::atomic<int64_t> intervalNs_{ std::chrono::duration_cast<std::chrono::nanoseconds>(kBaseInterval).count() };
+};
+
+// Per-team point totals over time, for plotting a copied session.
+// Rebuilding reuses the vectors' capacity.
+struct StatTimelineSeries {
+    std::vector<float> t;
+    std::vector<std::array<float, 2>> teamPoints;  // [blue, orange]
+    float maxPoints = 0.0f;
+
+    void Build(std::span<const StatSample> samples);
+    bool Empty() const { return t.empty(); }
+    float Duration() const { return t.empty() ? 0.0f : t.back(); }
+    // Value held at time x (stats only change between samples)
+    float PointsAt(float x, int team) const;
+};
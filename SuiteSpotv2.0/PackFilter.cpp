@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "PackFilter.h"
+
+#include <algorithm>
+
+namespace
+{
+    int CompareInts(int a, int b)
+    {
+        return (a < b) ? -1 : (a > b) ? 1 : 0;
+    }
+
+    bool Matches(const PackFilterCriteria& criteria, const TrainingEntry& pack)
+    {
+        return !criteria.query || criteria.query->Matches(pack);
+    }
+
+    struct RowLess {
+        const std::vector<TrainingEntry>& packs;
+        int sortColumn;
+        bool ascending;
+
+        bool operator()(int lhs, int rhs) const
+        {
+            const int cmp = ComparePacksByColumn(packs[lhs], packs[rhs], sortColumn);
+            return ascending ? (cmp < 0) : (cmp > 0);
+        }
+    };
+}
+
+int ComparePacksByColumn(const TrainingEntry& a, const TrainingEntry& b, int sortColumn)
+{
+    switch (sortColumn) {
+        case 0: return a.name.compare(b.name);
+        case 1: return a.creator.compare(b.creator);
+        case 2: return a.difficulty.compare(b.difficulty);
+        case 3: return CompareInts(a.shotCount, b.shotCount);
+        case 4: return CompareInts(a.likes, b.likes);
+        case 5: return CompareInts(a.plays, b.plays);
+        default: return 0;
+    }
+}
+
+PackFilterEngine::PackFilterEngine(size_t threadCount)
+    : pool_(threadCount == 0 ? WorkerPool::DefaultWorkerCount() : threadCount - 1)
+{
+}
+
+std::vector<int> PackFilterEngine::Run(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria)
+{
+    lastRunParallel_ = packs.size() >= parallelThreshold_ && pool_.GetConcurrency() > 1;
+    return lastRunParallel_ ? RunParallel(packs, criteria) : RunSerial(packs, criteria);
+}
+
+std::vector<int> PackFilterEngine::RunSerial(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria) const
+{
+    std::vector<int> rows;
+    rows.reserve(packs.size());
+    for (size_t i = 0; i < packs.size(); ++i) {
+        if (Matches(criteria, packs[i])) {
+            rows.push_back(static_cast<int>(i));
+        }
+    }
+    std::stable_sort(rows.begin(), rows.end(), RowLess{ packs, criteria.sortColumn, criteria.sortAscending });
+    return rows;
+}
+
+// #detailed comments: RunParallel
+// Purpose: Chunked filter + sort + merge over the worker pool.
+//
+// Phase 1: every chunk filters its row range into a private vector and
+// stable-sorts it. Chunks cover ascending row ranges, so concatenating
+// them in chunk order preserves catalog order for equal keys.
+// Phase 2: the chunk results are copied into one buffer and neighbouring
+// runs are merged pairwise (inplace_merge is stable and prefers the left
+// run on ties), doubling the run width each pass until one run remains.
+std::vector<int> PackFilterEngine::RunParallel(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria)
+{
+    const RowLess less{ packs, criteria.sortColumn, criteria.sortAscending };
+    const size_t chunkCount = (packs.size() + kChunkSize - 1) / kChunkSize;
+
+    std::vector<std::vector<int>> chunkRows(chunkCount);
+    lastRunParallel_ &= pool_.ParallelForOrInline(chunkCount, [&](size_t chunk) {
+        const size_t begin = chunk * kChunkSize;
+        const size_t end = std::min(packs.size(), begin + kChunkSize);
+        auto& out = chunkRows[chunk];
+        out.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            if (Matches(criteria, packs[i])) {
+                out.push_back(static_cast<int>(i));
+            }
+        }
+        std::stable_sort(out.begin(), out.end(), less);
+    });
+
+    // Run boundaries into the flattened buffer: runs[k] .. runs[k + 1]
+    std::vector<size_t> runs;
+    runs.reserve(chunkCount + 1);
+    runs.push_back(0);
+    size_t total = 0;
+    for (const auto& c : chunkRows) {
+        total += c.size();
+        runs.push_back(total);
+    }
+
+    std::vector<int> rows;
+    rows.reserve(total);
+    for (auto& c : chunkRows) {
+        rows.insert(rows.end(), c.begin(), c.end());
+        std::vector<int>().swap(c);
+    }
+
+    for (size_t width = 1; width < chunkCount; width *= 2) {
+        const size_t pairCount = (chunkCount + 2 * width - 1) / (2 * width);
+        lastRunParallel_ &= pool_.ParallelForOrInline(pairCount, [&](size_t pair) {
+            const size_t left = pair * 2 * width;
+            const size_t mid = std::min(left + width, chunkCount);
+            const size_t right = std::min(left + 2 * width, chunkCount);
+            if (mid >= right) return;
+            std::inplace_merge(rows.begin() + runs[left], rows.begin() + runs[mid], rows.begin() + runs[right], less);
+        });
+    }
+
+    return rows;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "MapList.h"
+#include "PackQuery.h"
+#include "WorkerPool.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// PackFilter: Filter and sort engine for the training pack browser
+//
+// Purpose: Produces the list of catalog rows shown by the Prejump browser.
+// Results are row indices into the source vector (never copies), filtered
+// by a compiled PackQuery and ordered by the selected sort column.
+//
+// Parallel path: above parallelThreshold_ rows the catalog is split into
+// fixed-size chunks. Each chunk is filtered and sorted independently on the
+// WorkerPool, then neighbouring chunks are merged pairwise. Both steps are
+// stable, so equal keys keep catalog order and the output is identical to
+// the serial path regardless of thread count. A pass never waits for the
+// pool: while another caller (a bulk import) holds it, the pass runs on
+// the calling thread, so the render thread is not stalled behind it.
+//
+// Usage Example:
+//   PackFilterEngine engine;
+//   PackFilterCriteria criteria;
+//   criteria.query = queryCache.Get("diff:gold..champion shots>=10");
+//   std::vector<int> rows = engine.Run(prejumpPacks, criteria);
+struct PackFilterCriteria {
+    std::shared_ptr<const PackQuery> query;  // null or empty matches every pack
+    int sortColumn = 0;                      // 0=Name, 1=Creator, 2=Difficulty, 3=Shots, 4=Likes, 5=Plays
+    bool sortAscending = true;
+};
+
+// Three-way compare on the criteria's sort column (ignores sort direction)
+int ComparePacksByColumn(const TrainingEntry& a, const TrainingEntry& b, int sortColumn);
+
+class PackFilterEngine
+{
+public:
+    // Catalogs smaller than this are filtered serially on the calling thread
+    static constexpr size_t kDefaultParallelThreshold = 16384;
+    // Rows per parallel chunk; large enough to amortize the chunk handoff
+    static constexpr size_t kChunkSize = 8192;
+
+    // threadCount: total threads used by the parallel path (0 = all cores)
+    explicit PackFilterEngine(size_t threadCount = 0);
+
+    // Filters and sorts packs; returns row indices into packs
+    std::vector<int> Run(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria);
+
+    void SetParallelThreshold(size_t rows) { parallelThreshold_ = rows; }
+    size_t GetParallelThreshold() const { return parallelThreshold_; }
+    size_t GetConcurrency() const { return pool_.GetConcurrency(); }
+    // False also when the pool was busy and a pass ran on the calling thread
+    bool LastRunWasParallel() const { return lastRunParallel_; }
+    // Shared with other catalog-scale work (bulk imports) so the plugin
+    // keeps one set of worker threads; Run never waits for those callers
+    WorkerPool& Pool() { return pool_; }
+
+private:
+    std::vector<int> RunSerial(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria) const;
+    std::vector<int> RunParallel(const std::vector<TrainingEntry>& packs, const PackFilterCriteria& criteria);
+
+    WorkerPool pool_;
+    size_t parallelThreshold_ = kDefaultParallelThreshold;
+    bool lastRunParallel_ = false;
+};
@@ -0,0 +1,624 @@
+#include "pch.h"
+#include "PackQuery.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <climits>
+
+namespace
+{
+    unsigned char LowerAscii(char c)
+    {
+        return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    std::string ToLower(std::string_view value)
+    {
+        std::string lower(value);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) { return static_cast<char>(LowerAscii(c)); });
+        return lower;
+    }
+
+    // needleLower must already be lowercase
+    bool ContainsCaseInsensitive(std::string_view haystack, std::string_view needleLower)
+    {
+        if (needleLower.empty()) return true;
+        if (haystack.size() < needleLower.size()) return false;
+        auto it = std::search(haystack.begin(), haystack.end(), needleLower.begin(), needleLower.end(),
+            [](char h, char n) { return LowerAscii(h) == static_cast<unsigned char>(n); });
+        return it != haystack.end();
+    }
+
+    bool EqualsCaseInsensitive(std::string_view value, std::string_view lower)
+    {
+        if (value.size() != lower.size()) return false;
+        for (size_t i = 0; i < value.size(); ++i) {
+            if (LowerAscii(value[i]) != static_cast<unsigned char>(lower[i])) return false;
+        }
+        return true;
+    }
+
+    // ===== Tokens =====
+
+    enum class TokenKind { Term, LParen, RParen, Or, Not, End };
+
+    enum class TermOp { None, Colon, Eq, Ne, Lt, Le, Gt, Ge };
+
+    struct Token {
+        TokenKind kind = TokenKind::End;
+        bool negated = false;
+        std::string field;  // lowercase, empty for free text
+        TermOp op = TermOp::None;
+        std::string value;  // unquoted, original case
+        bool quoted = false;
+    };
+
+    Token PunctToken(TokenKind kind)
+    {
+        Token token;
+        token.kind = kind;
+        return token;
+    }
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // ===== AST =====
+
+    struct Node {
+        enum class Kind { Pred, And, Or, Not } kind = Kind::Pred;
+        PackQueryPredicate pred;
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;  // unused for Not/Pred
+    };
+}
+
+// #detailed comments: PackQueryCompiler
+// Purpose: Tokenizer + recursive-descent parser + postfix emitter.
+// Grammar (lowest to highest precedence):
+//   or    := and ( ("OR" | "|") and )*
+//   and   := unary unary*              (juxtaposition is AND)
+//   unary := "-(" or ")" | "(" or ")" | term
+// A leading '-' on a term negates it. Errors stop compilation and are
+// reported through PackQuery::GetError(); a failed query matches nothing.
+class PackQueryCompiler
+{
+public:
+    explicit PackQueryCompiler(std::string_view text) : text_(text) {}
+
+    PackQuery Run()
+    {
+        PackQuery query;
+        query.text_ = std::string(text_);
+
+        Tokenize();
+        if (error_.empty()) {
+            std::unique_ptr<Node> root;
+            if (tokens_[pos_].kind != TokenKind::End) {
+                root = ParseOr();
+                if (error_.empty() && tokens_[pos_].kind != TokenKind::End) {
+                    error_ = tokens_[pos_].kind == TokenKind::RParen ? "Unmatched ')'" : "Unexpected input";
+                }
+            }
+            if (error_.empty() && root) {
+                int depth = 0;
+                int maxDepth = 0;
+                Emit(*root, query, depth, maxDepth);
+                if (maxDepth > PackQuery::kMaxStackDepth) {
+                    error_ = "Query is nested too deeply";
+                }
+            }
+        }
+
+        if (!error_.empty()) {
+            query.error_ = error_;
+            query.predicates_.clear();
+            query.program_.clear();
+        }
+        return query;
+    }
+
+private:
+    // ===== Tokenizer =====
+
+    void Tokenize()
+    {
+        size_t i = 0;
+        while (error_.empty()) {
+            while (i < text_.size() && IsSpace(text_[i])) ++i;
+            if (i >= text_.size()) break;
+
+            const char c = text_[i];
+            if (c == '(') { tokens_.push_back(PunctToken(TokenKind::LParen)); ++i; continue; }
+            if (c == ')') { tokens_.push_back(PunctToken(TokenKind::RParen)); ++i; continue; }
+            if (c == '|') { tokens_.push_back(PunctToken(TokenKind::Or)); ++i; continue; }
+            if (c == '-' && i + 1 < text_.size() && text_[i + 1] == '(') {
+                tokens_.push_back(PunctToken(TokenKind::Not));
+                ++i;
+                continue;
+            }
+
+            Token tok;
+            tok.kind = TokenKind::Term;
+            if (c == '-' && i + 1 < text_.size() && !IsSpace(text_[i + 1])) {
+                tok.negated = true;
+                ++i;
+            }
+
+            // Read one word: unquoted characters up to whitespace/parens,
+            // with "..." segments taken verbatim. The first unquoted ':' or
+            // comparator splits field from value.
+            std::string raw;
+            bool sawOp = false;
+            while (i < text_.size() && !IsSpace(text_[i]) && text_[i] != '(' && text_[i] != ')') {
+                const char ch = text_[i];
+                if (ch == '"') {
+                    ++i;
+                    tok.quoted = true;
+                    bool closed = false;
+                    while (i < text_.size()) {
+                        if (text_[i] == '\\' && i + 1 < text_.size()) {
+                            raw.push_back(text_[i + 1]);
+                            i += 2;
+                            continue;
+                        }
+                        if (text_[i] == '"') {
+                            closed = true;
+                            ++i;
+                            break;
+                        }
+                        raw.push_back(text_[i++]);
+                    }
+                    if (!closed) {
+                        error_ = "Unterminated quote";
+                        return;
+                    }
+                    continue;
+                }
+
+                if (!sawOp && !tok.quoted && !raw.empty()) {
+                    const char next = (i + 1 < text_.size()) ? text_[i + 1] : '\0';
+                    TermOp op = TermOp::None;
+                    size_t width = 1;
+                    if (ch == ':') { op = TermOp::Colon; }
+                    else if (ch == '=') { op = TermOp::Eq; width = (next == '=') ? 2 : 1; }
+                    else if (ch == '!' && next == '=') { op = TermOp::Ne; width = 2; }
+                    else if (ch == '<') { op = (next == '=') ? TermOp::Le : TermOp::Lt; width = (next == '=') ? 2 : 1; }
+                    else if (ch == '>') { op = (next == '=') ? TermOp::Ge : TermOp::Gt; width = (next == '=') ? 2 : 1; }
+
+                    if (op != TermOp::None) {
+                        sawOp = true;
+                        tok.op = op;
+                        tok.field = ToLower(raw);
+                        raw.clear();
+                        i += width;
+                        continue;
+                    }
+                }
+
+                raw.push_back(ch);
+                ++i;
+            }
+            tok.value = std::move(raw);
+
+            if (!tok.negated && !tok.quoted && tok.field.empty() && (tok.value == "OR" || tok.value == "or")) {
+                tokens_.push_back(PunctToken(TokenKind::Or));
+                continue;
+            }
+            if (tok.field.empty() && tok.value.empty() && !tok.quoted) {
+                continue;  // lone '-'
+            }
+            tokens_.push_back(std::move(tok));
+        }
+        tokens_.push_back(PunctToken(TokenKind::End));
+    }
+
+    // ===== Parser =====
+
+    std::unique_ptr<Node> MakeBinary(Node::Kind kind, std::unique_ptr<Node> l, std::unique_ptr<Node> r)
+    {
+        auto n = std::make_unique<Node>();
+        n->kind = kind;
+        n->left = std::move(l);
+        n->right = std::move(r);
+        return n;
+    }
+
+    std::unique_ptr<Node> MakeNot(std::unique_ptr<Node> child)
+    {
+        auto n = std::make_unique<Node>();
+        n->kind = Node::Kind::Not;
+        n->left = std::move(child);
+        return n;
+    }
+
+    std::unique_ptr<Node> ParseOr()
+    {
+        auto left = ParseAnd();
+        while (error_.empty() && tokens_[pos_].kind == TokenKind::Or) {
+            ++pos_;
+            auto right = ParseAnd();
+            if (!error_.empty()) return nullptr;
+            left = MakeBinary(Node::Kind::Or, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    std::unique_ptr<Node> ParseAnd()
+    {
+        auto left = ParseUnary();
+        while (error_.empty()) {
+            const auto kind = tokens_[pos_].kind;
+            if (kind != TokenKind::Term && kind != TokenKind::LParen && kind != TokenKind::Not) break;
+            auto right = ParseUnary();
+            if (!error_.empty()) return nullptr;
+            left = MakeBinary(Node::Kind::And, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    std::unique_ptr<Node> ParseUnary()
+    {
+        const Token& tok = tokens_[pos_];
+        switch (tok.kind) {
+            case TokenKind::Not: {
+                ++pos_;
+                if (tokens_[pos_].kind != TokenKind::LParen) {
+                    error_ = "Expected '(' after '-'";
+                    return nullptr;
+                }
+                auto inner = ParseUnary();
+                return error_.empty() ? MakeNot(std::move(inner)) : nullptr;
+            }
+            case TokenKind::LParen: {
+                ++pos_;
+                auto inner = ParseOr();
+                if (!error_.empty()) return nullptr;
+                if (tokens_[pos_].kind != TokenKind::RParen) {
+                    error_ = "Missing ')'";
+                    return nullptr;
+                }
+                ++pos_;
+                return inner;
+            }
+            case TokenKind::Term: {
+                ++pos_;
+                return ParseTerm(tok);
+            }
+            case TokenKind::Or:
+                error_ = "OR needs a term on both sides";
+                return nullptr;
+            case TokenKind::RParen:
+                error_ = "Unmatched ')'";
+                return nullptr;
+            default:
+                error_ = "Unexpected end of query";
+                return nullptr;
+        }
+    }
+
+    bool ParseInt(std::string_view s, int& out)
+    {
+        if (s.empty()) return false;
+        const auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+        return result.ec == std::errc() && result.ptr == s.data() + s.size();
+    }
+
+    // Splits "a..b" (either side optional) into bounds via parse; single
+    // values produce lo == hi
+    template <typename ParseFn>
+    bool ParseRange(std::string_view value, int minValue, int maxValue, int& lo, int& hi, ParseFn&& parse)
+    {
+        const auto dots = value.find("..");
+        if (dots == std::string_view::npos) {
+            if (!parse(value, lo)) return false;
+            hi = lo;
+            return true;
+        }
+        const auto a = value.substr(0, dots);
+        const auto b = value.substr(dots + 2);
+        lo = minValue;
+        hi = maxValue;
+        if (a.empty() && b.empty()) return false;
+        if (!a.empty() && !parse(a, lo)) return false;
+        if (!b.empty() && !parse(b, hi)) return false;
+        return true;
+    }
+
+    // Applies a comparator to a parsed bound; returns false for unsupported ops
+    bool ApplyCompare(TermOp op, int value, int minValue, int maxValue, int& lo, int& hi)
+    {
+        switch (op) {
+            case TermOp::Lt: lo = minValue; hi = value == INT_MIN ? INT_MIN : value - 1; return true;
+            case TermOp::Le: lo = minValue; hi = value; return true;
+            case TermOp::Gt: lo = value == INT_MAX ? INT_MAX : value + 1; hi = maxValue; return true;
+            case TermOp::Ge: lo = value; hi = maxValue; return true;
+            default: return false;
+        }
+    }
+
+    std::unique_ptr<Node> ParseTerm(const Token& tok)
+    {
+        auto leaf = std::make_unique<Node>();
+        PackQueryPredicate& pred = leaf->pred;
+        bool negate = tok.negated;
+
+        const std::string& f = tok.field;
+        if (f.empty()) {
+            pred.field = PackQueryField::Text;
+        } else if (f == "name" || f == "n") {
+            pred.field = PackQueryField::Name;
+        } else if (f == "creator" || f == "by" || f == "author") {
+            pred.field = PackQueryField::Creator;
+        } else if (f == "tag" || f == "tags" || f == "t") {
+            pred.field = PackQueryField::Tag;
+        } else if (f == "diff" || f == "difficulty" || f == "d") {
+            pred.field = PackQueryField::Difficulty;
+        } else if (f == "shots" || f == "shot") {
+            pred.field = PackQueryField::Shots;
+        } else if (f == "likes") {
+            pred.field = PackQueryField::Likes;
+        } else if (f == "plays") {
+            pred.field = PackQueryField::Plays;
+        } else if (f == "code") {
+            pred.field = PackQueryField::Code;
+        } else {
+            error_ = "Unknown field '" + f + "'";
+            return nullptr;
+        }
+
+        if (tok.op == TermOp::Ne) {
+            negate = !negate;
+        }
+
+        switch (pred.field) {
+            case PackQueryField::Text:
+            case PackQueryField::Name:
+            case PackQueryField::Creator:
+            case PackQueryField::Tag:
+            case PackQueryField::Code: {
+                if (tok.op != TermOp::None && tok.op != TermOp::Colon && tok.op != TermOp::Eq && tok.op != TermOp::Ne) {
+                    error_ = "'" + f + "' only supports ':' and '!='";
+                    return nullptr;
+                }
+                if (tok.value.empty()) {
+                    error_ = "Missing value for '" + (f.empty() ? std::string("search") : f) + "'";
+                    return nullptr;
+                }
+                pred.text = ToLower(tok.value);
+                break;
+            }
+            case PackQueryField::Difficulty: {
+                auto parseRank = [](std::string_view s, int& out) {
+                    out = PackDifficultyRank(s);
+                    return out >= 0;
+                };
+                bool ok = false;
+                if (tok.op == TermOp::Colon || tok.op == TermOp::Eq || tok.op == TermOp::Ne) {
+                    ok = ParseRange(tok.value, 0, 7, pred.lo, pred.hi, parseRank);
+                } else {
+                    int rank = 0;
+                    ok = parseRank(tok.value, rank) && ApplyCompare(tok.op, rank, 0, 7, pred.lo, pred.hi);
+                }
+                if (!ok) {
+                    error_ = "Unknown difficulty '" + tok.value + "'";
+                    return nullptr;
+                }
+                break;
+            }
+            default: {
+                auto parseNumber = [this](std::string_view s, int& out) { return ParseInt(s, out); };
+                bool ok = false;
+                if (tok.op == TermOp::Colon || tok.op == TermOp::Eq || tok.op == TermOp::Ne) {
+                    ok = ParseRange(tok.value, INT_MIN, INT_MAX, pred.lo, pred.hi, parseNumber);
+                } else if (tok.op != TermOp::None) {
+                    int number = 0;
+                    ok = ParseInt(tok.value, number) && ApplyCompare(tok.op, number, INT_MIN, INT_MAX, pred.lo, pred.hi);
+                }
+                if (!ok) {
+                    error_ = "Invalid number '" + tok.value + "' for '" + f + "'";
+                    return nullptr;
+                }
+                break;
+            }
+        }
+
+        return negate ? MakeNot(std::move(leaf)) : std::move(leaf);
+    }
+
+    // ===== Emitter =====
+
+    void Emit(const Node& node, PackQuery& query, int& depth, int& maxDepth)
+    {
+        switch (node.kind) {
+            case Node::Kind::Pred: {
+                if (query.predicates_.size() >= UINT16_MAX) {
+                    error_ = "Query has too many terms";
+                    return;
+                }
+                query.predicates_.push_back(node.pred);
+                query.program_.push_back({ PackQuery::OpCode::Test, static_cast<uint16_t>(query.predicates_.size() - 1) });
+                maxDepth = std::max(maxDepth, ++depth);
+                return;
+            }
+            case Node::Kind::Not:
+                Emit(*node.left, query, depth, maxDepth);
+                query.program_.push_back({ PackQuery::OpCode::Not });
+                return;
+            case Node::Kind::And:
+            case Node::Kind::Or:
+                Emit(*node.left, query, depth, maxDepth);
+                Emit(*node.right, query, depth, maxDepth);
+                query.program_.push_back({ node.kind == Node::Kind::And ? PackQuery::OpCode::And : PackQuery::OpCode::Or });
+                --depth;
+                return;
+        }
+    }
+
+    std::string_view text_;
+    std::vector<Token> tokens_;
+    size_t pos_ = 0;
+    std::string error_;
+};
+
+PackQuery PackQuery::Compile(std::string_view text)
+{
+    return PackQueryCompiler(text).Run();
+}
+
+int PackDifficultyRank(std::string_view difficulty)
+{
+    // Collapse case and spaces so "Grand Champion", "grandchampion" and "GC" agree
+    std::string key;
+    key.reserve(difficulty.size());
+    for (char c : difficulty) {
+        if (!IsSpace(c) && c != '_' && c != '-') key.push_back(static_cast<char>(LowerAscii(c)));
+    }
+
+    static const std::pair<const char*, int> kAliases[] = {
+        { "bronze", 0 }, { "silver", 1 }, { "gold", 2 },
+        { "platinum", 3 }, { "plat", 3 },
+        { "diamond", 4 }, { "diam", 4 },
+        { "champion", 5 }, { "champ", 5 },
+        { "grandchampion", 6 }, { "gc", 6 },
+        { "supersoniclegend", 7 }, { "ssl", 7 }, { "supersonic", 7 },
+    };
+    for (const auto& [alias, rank] : kAliases) {
+        if (key == alias) return rank;
+    }
+    return -1;
+}
+
+bool PackQuery::Matches(const TrainingEntry& pack) const
+{
+    if (!error_.empty()) return false;
+    if (program_.empty()) return true;
+
+    std::array<bool, kMaxStackDepth> stack{};
+    int top = -1;
+    for (const Instruction& ins : program_) {
+        switch (ins.op) {
+            case OpCode::Test: {
+                const PackQueryPredicate& p = predicates_[ins.predicate];
+                bool result = false;
+                switch (p.field) {
+                    case PackQueryField::Text:
+                        result = ContainsCaseInsensitive(pack.name, p.text) || ContainsCaseInsensitive(pack.creator, p.text);
+                        for (size_t t = 0; !result && t < pack.tags.size(); ++t) {
+                            result = ContainsCaseInsensitive(pack.tags[t], p.text);
+                        }
+                        break;
+                    case PackQueryField::Name:
+                        result = ContainsCaseInsensitive(pack.name, p.text);
+                        break;
+                    case PackQueryField::Creator:
+                        result = ContainsCaseInsensitive(pack.creator, p.text) || ContainsCaseInsensitive(pack.creatorSlug, p.text);
+                        break;
+                    case PackQueryField::Tag:
+                        for (size_t t = 0; !result && t < pack.tags.size(); ++t) {
+                            result = EqualsCaseInsensitive(pack.tags[t], p.text);
+                        }
+                        break;
+                    case PackQueryField::Difficulty: {
+                        const int rank = PackDifficultyRank(pack.difficulty);
+                        result = rank >= p.lo && rank <= p.hi;
+                        break;
+                    }
+                    case PackQueryField::Shots:
+                        result = pack.shotCount >= p.lo && pack.shotCount <= p.hi;
+                        break;
+                    case PackQueryField::Likes:
+                        result = pack.likes >= p.lo && pack.likes <= p.hi;
+                        break;
+                    case PackQueryField::Plays:
+                        result = pack.plays >= p.lo && pack.plays <= p.hi;
+                        break;
+                    case PackQueryField::Code:
+                        result = EqualsCaseInsensitive(pack.code, p.text);
+                        break;
+                }
+                stack[++top] = result;
+                break;
+            }
+            case OpCode::Not:
+                stack[top] = !stack[top];
+                break;
+            case OpCode::And:
+                --top;
+                stack[top] = stack[top] && stack[top + 1];
+                break;
+            case OpCode::Or:
+                --top;
+                stack[top] = stack[top] || stack[top + 1];
+                break;
+        }
+    }
+    return top == 0 && stack[0];
+}
+
+std::string BuildPackQuery(const std::string& searchText, const std::string& difficulty, const std::string& tag, int minShots)
+{
+    // Quotes keep the widget semantics: the search box is one substring,
+    // tag/difficulty names may contain spaces
+    auto quote = [](const std::string& value) {
+        std::string out = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') out.push_back('\\');
+            out.push_back(c);
+        }
+        out.push_back('"');
+        return out;
+    };
+    auto needsQuotes = [](const std::string& value) {
+        return value.find_first_of(" \t\"():<>=!|\\") != std::string::npos || value.front() == '-' ||
+               value == "OR" || value == "or" || value.find("..") != std::string::npos;
+    };
+
+    std::string query;
+    auto append = [&query](const std::string& term) {
+        if (!query.empty()) query.push_back(' ');
+        query += term;
+    };
+
+    if (!searchText.empty()) {
+        append(needsQuotes(searchText) ? quote(searchText) : searchText);
+    }
+    if (!difficulty.empty() && difficulty != "All") {
+        append("diff:" + (needsQuotes(difficulty) ? quote(difficulty) : difficulty));
+    }
+    if (!tag.empty()) {
+        append("tag:" + (needsQuotes(tag) ? quote(tag) : tag));
+    }
+    if (minShots > 0) {
+        append("shots>=" + std::to_string(minShots));
+    }
+    return query;
+}
+
+std::shared_ptr<const PackQuery> PackQueryCache::Get(const std::string& text)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(text);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    // Queries are typed a character at a time; a full reset is cheaper than
+    // LRU bookkeeping and the live query is recompiled on the next lookup
+    if (entries_.size() >= kMaxEntries) {
+        entries_.clear();
+    }
+    auto compiled = std::make_shared<const PackQuery>(PackQuery::Compile(text));
+    entries_.emplace(text, compiled);
+    return compiled;
+}
+
+void PackQueryCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "MapList.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// PackQuery: Query language for the Prejump browser
+//
+// Purpose: Lets power users type filters the fixed widgets cannot express.
+// A query string is tokenized, parsed into an expression tree and compiled
+// into a flat postfix program of predicate tests and boolean operators.
+// Evaluating a pack is a single pass over that program with a small fixed
+// bool stack, so the per-row cost does not depend on how the query was
+// written and there is no tree walking or allocation in the scan.
+//
+// Syntax (terms are ANDed; OR and parentheses group; '-' negates):
+//   wall                     free text: name, creator or any tag contains "wall"
+//   "air roll"               quoted free text (spaces kept)
+//   name:reset               name contains
+//   creator:wayprotein       creator contains (also by:)
+//   tag:aerial -tag:ground   has tag / does not have tag (exact, case-insensitive)
+//   diff:gold..champion      difficulty rank range (diff:gold, diff>=plat, diff:..diamond)
+//   shots>=10 likes>100      numeric compare on shots, likes, plays (also shots:5..20)
+//   code:555F-7503-BBB9-E1E3 exact training code
+//   (tag:wall OR tag:ceiling) -diff:ssl
+//
+// Compiled queries never reference catalog rows, so one compiled query can
+// be re-run against a reloaded catalog without parsing again (see
+// PackQueryCache).
+enum class PackQueryField : uint8_t {
+    Text,        // name, creator or tags contain
+    Name,
+    Creator,
+    Tag,
+    Difficulty,  // compared by rank, see PackDifficultyRank
+    Shots,
+    Likes,
+    Plays,
+    Code,
+};
+
+struct PackQueryPredicate {
+    PackQueryField field = PackQueryField::Text;
+    std::string text;  // lowercase needle for text fields
+    int lo = 0;        // inclusive range for numeric/difficulty fields
+    int hi = 0;
+};
+
+class PackQuery
+{
+public:
+    // Parses and compiles text. Never throws; check IsValid()/GetError().
+    static PackQuery Compile(std::string_view text);
+
+    // True for every pack when the query is empty; false for every pack when invalid
+    bool Matches(const TrainingEntry& pack) const;
+
+    bool IsValid() const { return error_.empty(); }
+    bool IsEmpty() const { return program_.empty(); }
+    const std::string& GetError() const { return error_; }
+    const std::string& GetText() const { return text_; }
+    size_t GetInstructionCount() const { return program_.size(); }
+
+    // Deepest bool stack a program may need; deeper queries fail to compile
+    static constexpr int kMaxStackDepth = 32;
+
+    enum class OpCode : uint8_t { Test, And, Or, Not };
+    struct Instruction {
+        OpCode op = OpCode::Test;
+        uint16_t predicate = 0;  // index into predicates_ for Test
+    };
+
+private:
+    friend class PackQueryCompiler;
+
+    std::string text_;
+    std::string error_;
+    std::vector<PackQueryPredicate> predicates_;
+    std::vector<Instruction> program_;  // postfix
+};
+
+// Rank of a difficulty name or alias (bronze=0 ... supersonic legend=7),
+// case-insensitive and ignoring spaces; -1 when unknown
+int PackDifficultyRank(std::string_view difficulty);
+
+// Builds the query the classic browser widgets describe, so both UIs run
+// through the same compiled path ("All"/empty/0 values are omitted)
+std::string BuildPackQuery(const std::string& searchText, const std::string& difficulty, const std::string& tag, int minShots);
+
+// Thread-safe memo of compiled queries keyed by query text
+class PackQueryCache
+{
+public:
+    std::shared_ptr<const PackQuery> Get(const std::string& text);
+    void Clear();
+
+private:
+    static constexpr size_t kMaxEntries = 64;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const PackQuery>> entries_;
+};
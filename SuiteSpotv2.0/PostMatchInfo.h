@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+struct PostMatchColor {
+    float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+};
+
+struct PostMatchPlayerRow {
+    int teamIndex = -1;
+    bool isLocal = false;
+    std::string name;
+    int score = 0;
+    int goals = 0;
+    int assists = 0;
+    int saves = 0;
+    int shots = 0;
+    int ping = 0;
+    bool isMVP = false;
+};
+
+// Largest match Rocket League hosts (4v4); rows beyond this are dropped
+constexpr size_t kMaxPostMatchPlayers = 8;
+
+// One complete match result as the overlay shows it. Published from the
+// game thread through postMatchBuffer (a TripleBuffer), so the renderer
+// only ever sees whole snapshots. Rows live in a fixed array and strings
+// keep their capacity between matches (see the constructor), so refilling a slot
+// for a new match does not allocate.
+struct PostMatchInfo {
+    uint64_t sequence = 0;   // Bumped by every publish; the renderer opens/closes the overlay on change
+    bool active = false;     // false = hide the overlay
+    std::chrono::steady_clock::time_point start;
+    int myScore = 0;
+    int oppScore = 0;
+    std::string myTeamName;
+    std::string oppTeamName;
+    std::string playlist;
+    bool overtime = false;
+    PostMatchColor myColor{};   // Team font colours as the game reports them
+    PostMatchColor oppColor{};
+    std::array<PostMatchPlayerRow, kMaxPostMatchPlayers> rows;
+    size_t playerCount = 0;
+    uint64_t timelineSession = 0;  // MatchStatSampler session holding this match's samples; 0 = none
+
+    // Pre-sizes every string so later captures reuse the capacity
+    PostMatchInfo()
+    {
+        // Longer than any team, playlist or player name the game shows
+        constexpr size_t kNameCapacity = 64;
+        myTeamName.reserve(kNameCapacity);
+        oppTeamName.reserve(kNameCapacity);
+        playlist.reserve(kNameCapacity);
+        for (auto& row : rows) {
+            row.name.reserve(kNameCapacity);
+        }
+    }
+
+    std::span<const PostMatchPlayerRow> Players() const { return { rows.data(), playerCount }; }
+    std::span<PostMatchPlayerRow> Players() { return { rows.data(), playerCount }; }
+};
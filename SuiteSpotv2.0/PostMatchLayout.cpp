@@ -0,0 +1,183 @@
+#include "pch.h"
+#include "PostMatchLayout.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    struct Rgb {
+        float r, g, b;
+    };
+
+    Rgb HsvToRgb(float h, float s, float v)
+    {
+        const float c = v * s;
+        const float x = c * (1 - std::fabs(std::fmod(h / 60.0f, 2.0f) - 1));
+        const float m = v - c;
+        float r = 0, g = 0, b = 0;
+        if (h < 60) { r = c; g = x; b = 0; }
+        else if (h < 120) { r = x; g = c; b = 0; }
+        else if (h < 180) { r = 0; g = c; b = x; }
+        else if (h < 240) { r = 0; g = x; b = c; }
+        else if (h < 300) { r = x; g = 0; b = c; }
+        else { r = c; g = 0; b = x; }
+        return { r + m, g + m, b + m };
+    }
+}
+
+uint32_t PostMatchLayout::PackRgb(float r, float g, float b)
+{
+    // IM_COL32 order: R in the low byte, alpha in the high byte
+    return AlphaByte(r) | (AlphaByte(g) << 8) | (AlphaByte(b) << 16);
+}
+
+void PostMatchLayout::AddRect(float x0, float y0, float x1, float y1, float rounding, uint32_t rgb, float alpha)
+{
+    OverlayDrawItem item;
+    item.kind = OverlayDrawKind::Rect;
+    item.x0 = x0;
+    item.y0 = y0;
+    item.x1 = x1;
+    item.y1 = y1;
+    item.size = rounding;
+    item.rgb = rgb;
+    item.alpha = alpha;
+    items_.push_back(item);
+}
+
+void PostMatchLayout::AddText(float x, float y, float fontSize, uint32_t rgb, float alpha, std::string_view text)
+{
+    OverlayDrawItem item;
+    item.kind = OverlayDrawKind::Text;
+    item.x0 = x;
+    item.y0 = y;
+    item.size = fontSize;
+    item.rgb = rgb;
+    item.alpha = alpha;
+    item.textBegin = static_cast<uint32_t>(text_.size());
+    text_.append(text);
+    item.textEnd = static_cast<uint32_t>(text_.size());
+    items_.push_back(item);
+}
+
+void PostMatchLayout::AddNumber(float x, float y, float fontSize, uint32_t rgb, float alpha, int value)
+{
+    char buf[16];
+    const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    AddText(x, y, fontSize, rgb, alpha, std::string_view(buf, static_cast<size_t>(result.ptr - buf)));
+}
+
+// #detailed comments: PostMatchLayout::Build
+// Purpose: Produce exactly the draw calls the immediate-mode overlay used
+// to issue each frame, in the same order and at the same window-relative
+// positions, so the cached overlay looks identical.
+void PostMatchLayout::Build(const PostMatchInfo& info, const PostMatchLayoutStyle& style)
+{
+    items_.clear();
+    text_.clear();
+    style_ = style;
+    sequence_ = info.sequence;
+    built_ = true;
+
+    const uint32_t black = PackRgb(0.f, 0.f, 0.f);
+    const uint32_t white = PackRgb(1.f, 1.f, 1.f);
+    const uint32_t gray = PackRgb(0.7f, 0.7f, 0.7f);
+    const uint32_t gold = PackRgb(1.f, 0.84f, 0.f);
+
+    // Background and header band
+    AddRect(0.0f, 0.0f, style.width, style.height, 8.0f, black, style.backgroundAlpha);
+    AddRect(0.0f, 0.0f, style.width, 34.0f, 8.0f, black, style.headerAlpha);
+
+    AddText(12.0f, 8.0f, style.teamHeaderFontSize, white, 1.0f, info.overtime ? "MATCH COMPLETE - OVERTIME" : "MATCH COMPLETE");
+
+    // Match info line: "<playlist> | <my team> <n> - <n> <opponents>"
+    {
+        const uint32_t begin = static_cast<uint32_t>(text_.size());
+        char buf[16];
+        text_.append(info.playlist).append(" | ").append(info.myTeamName).append(" ");
+        text_.append(buf, std::to_chars(buf, buf + sizeof(buf), info.myScore).ptr);
+        text_.append(" - ");
+        text_.append(buf, std::to_chars(buf, buf + sizeof(buf), info.oppScore).ptr);
+        text_.append(" ").append(info.oppTeamName);
+
+        OverlayDrawItem item;
+        item.kind = OverlayDrawKind::Text;
+        item.x0 = 12.0f;
+        item.y0 = 45.0f;
+        item.size = style.headerFontSize;
+        item.rgb = white;
+        item.textBegin = begin;
+        item.textEnd = static_cast<uint32_t>(text_.size());
+        items_.push_back(item);
+    }
+
+    float contentY = 70.0f;
+    if (style.showColumnHeaders) {
+        AddText(style.nameColumnX, contentY, style.headerFontSize, gray, 1.0f, "Player");
+        AddText(style.scoreColumnX, contentY, style.headerFontSize, gray, 1.0f, "Score");
+        AddText(style.goalsColumnX, contentY, style.headerFontSize, gray, 1.0f, "Goals");
+        AddText(style.assistsColumnX, contentY, style.headerFontSize, gray, 1.0f, "Assists");
+        AddText(style.savesColumnX, contentY, style.headerFontSize, gray, 1.0f, "Saves");
+        AddText(style.shotsColumnX, contentY, style.headerFontSize, gray, 1.0f, "Shots");
+        AddText(style.pingColumnX, contentY, style.headerFontSize, gray, 1.0f, "Ping");
+        contentY += style.playerRowHeight;
+    }
+
+    const auto players = info.Players();
+    for (int teamIdx = 0; teamIdx <= 1; teamIdx++) {
+        bool isMyTeam = false;
+        for (const auto& p : players) {
+            if (p.isLocal && p.teamIndex == teamIdx) {
+                isMyTeam = true;
+                break;
+            }
+        }
+
+        const Rgb team = teamIdx == 0
+            ? HsvToRgb(style.blueTeamHue, style.blueTeamSat, style.blueTeamVal)
+            : HsvToRgb(style.orangeTeamHue, style.orangeTeamSat, style.orangeTeamVal);
+        AddRect(style.sectionPadding, contentY, style.width - style.sectionPadding, contentY + style.teamHeaderHeight,
+            4.0f, PackRgb(team.r, team.g, team.b), 1.0f);
+
+        // "<team name>[ - <score>]"
+        const uint32_t begin = static_cast<uint32_t>(text_.size());
+        text_.append(isMyTeam ? info.myTeamName : info.oppTeamName);
+        if (style.showTeamScores) {
+            char buf[16];
+            text_.append(" - ");
+            text_.append(buf, std::to_chars(buf, buf + sizeof(buf), isMyTeam ? info.myScore : info.oppScore).ptr);
+        }
+        OverlayDrawItem header;
+        header.kind = OverlayDrawKind::Text;
+        header.x0 = style.nameColumnX;
+        header.y0 = contentY + 4.0f;
+        header.size = style.teamHeaderFontSize;
+        header.rgb = white;
+        header.textBegin = begin;
+        header.textEnd = static_cast<uint32_t>(text_.size());
+        items_.push_back(header);
+        contentY += style.teamHeaderHeight + 4.0f;
+
+        for (const auto& player : players) {
+            if (player.teamIndex != teamIdx) continue;
+
+            const uint32_t playerColor = player.isMVP && style.showMvpGlow ? gold : white;
+            if (player.isMVP) {
+                AddText(style.nameColumnX - 20.0f, contentY, style.mainFontSize * style.mvpCheckmarkSize, gold, 1.0f, "\xE2\x98\x85");  // ★
+            }
+
+            AddText(style.nameColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.name);
+            AddNumber(style.scoreColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.score);
+            AddNumber(style.goalsColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.goals);
+            AddNumber(style.assistsColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.assists);
+            AddNumber(style.savesColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.saves);
+            AddNumber(style.shotsColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.shots);
+            AddNumber(style.pingColumnX, contentY, style.mainFontSize, playerColor, 1.0f, player.ping);
+
+            contentY += style.playerRowHeight;
+        }
+
+        contentY += style.teamSectionSpacing;
+    }
+}
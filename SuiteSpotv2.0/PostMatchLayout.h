@@ -0,0 +1,117 @@
+#pragma once
+
+#include "PostMatchInfo.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Overlay settings that affect layout; a change forces a rebuild
+struct PostMatchLayoutStyle {
+    float width = 0.0f;              // Overlay window size
+    float height = 0.0f;
+    float teamHeaderHeight = 0.0f;
+    float playerRowHeight = 0.0f;
+    float teamSectionSpacing = 0.0f;
+    float sectionPadding = 0.0f;
+    float nameColumnX = 0.0f;
+    float scoreColumnX = 0.0f;
+    float goalsColumnX = 0.0f;
+    float assistsColumnX = 0.0f;
+    float savesColumnX = 0.0f;
+    float shotsColumnX = 0.0f;
+    float pingColumnX = 0.0f;
+    float mainFontSize = 0.0f;
+    float headerFontSize = 0.0f;
+    float teamHeaderFontSize = 0.0f;
+    float blueTeamHue = 0.0f, blueTeamSat = 0.0f, blueTeamVal = 0.0f;
+    float orangeTeamHue = 0.0f, orangeTeamSat = 0.0f, orangeTeamVal = 0.0f;
+    float backgroundAlpha = 0.0f;
+    float headerAlpha = 0.0f;
+    float mvpCheckmarkSize = 0.0f;
+    bool showMvpGlow = false;
+    bool showTeamScores = false;
+    bool showColumnHeaders = false;
+
+    bool operator==(const PostMatchLayoutStyle&) const = default;
+};
+
+enum class OverlayDrawKind : uint8_t { Rect, Text };
+
+// One draw call, positioned relative to the overlay window's top-left
+struct OverlayDrawItem {
+    OverlayDrawKind kind = OverlayDrawKind::Rect;
+    float x0 = 0.0f, y0 = 0.0f;   // Rect min / text position
+    float x1 = 0.0f, y1 = 0.0f;   // Rect max (unused for text)
+    float size = 0.0f;            // Rect rounding / font size
+    uint32_t rgb = 0;             // Packed like ImU32 (IM_COL32 order) with alpha 0
+    float alpha = 1.0f;           // Item alpha before the frame's fade
+    uint32_t textBegin = 0;       // Text: range in the layout's text buffer
+    uint32_t textEnd = 0;
+};
+
+// PostMatchLayout: Retained layout of the post-match overlay
+//
+// Purpose: The overlay's content only changes when a new match result is
+// published or an overlay setting changes, but it used to be rebuilt every
+// frame (title strings, std::to_string for every stat, HSV conversions, a
+// scan for the local team). Build() does that work once and records the
+// result as a flat list of rects and text runs whose text lives in one
+// shared buffer. Each frame, Emit() only combines every item's alpha with
+// the fade alpha and hands it to a sink; it performs no allocation and no
+// formatting.
+//
+// Sink interface (see SuiteSpot::RenderPostMatchOverlay for the ImDrawList one):
+//   void Rect(const OverlayDrawItem& item, uint32_t color);
+//   void Text(const OverlayDrawItem& item, const char* begin, const char* end, uint32_t color);
+//
+// Threading: Render thread only.
+class PostMatchLayout
+{
+public:
+    // True when the cached layout was built for this snapshot and style
+    bool IsCurrent(uint64_t sequence, const PostMatchLayoutStyle& style) const
+    {
+        return built_ && sequence == sequence_ && style == style_;
+    }
+
+    // Lays out info; reuses the item and text buffers' capacity
+    void Build(const PostMatchInfo& info, const PostMatchLayoutStyle& style);
+
+    // Per frame: every item with its alpha scaled by frameAlpha
+    template <typename Sink>
+    void Emit(float frameAlpha, Sink& sink) const
+    {
+        const char* text = text_.data();
+        for (const auto& item : items_) {
+            const uint32_t color = item.rgb | (AlphaByte(item.alpha * frameAlpha) << 24);
+            if (item.kind == OverlayDrawKind::Rect) {
+                sink.Rect(item, color);
+            } else {
+                sink.Text(item, text + item.textBegin, text + item.textEnd, color);
+            }
+        }
+    }
+
+    const std::vector<OverlayDrawItem>& Items() const { return items_; }
+
+    // r, g, b in [0, 1] packed in IM_COL32 byte order with alpha 0
+    static uint32_t PackRgb(float r, float g, float b);
+    // Same rounding as ImGui::ColorConvertFloat4ToU32
+    static uint32_t AlphaByte(float alpha)
+    {
+        return static_cast<uint32_t>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+private:
+    void AddRect(float x0, float y0, float x1, float y1, float rounding, uint32_t rgb, float alpha);
+    void AddText(float x, float y, float fontSize, uint32_t rgb, float alpha, std::string_view text);
+    void AddNumber(float x, float y, float fontSize, uint32_t rgb, float alpha, int value);
+
+    std::vector<OverlayDrawItem> items_;
+    std::string text_;
+    PostMatchLayoutStyle style_;
+    uint64_t sequence_ = 0;
+    bool built_ = false;
+};
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "PostMatchSequencer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+void PostMatchSequencer::ReportUnhandled(std::exception_ptr error) noexcept
+{
+    try {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            ERRORLOG("SuiteSpot: Post-match sequence stopped by an error: {}", e.what());
+        } catch (...) {
+            ERRORLOG("SuiteSpot: Post-match sequence stopped by an unknown error");
+        }
+    } catch (...) {
+        // Logging failed too; the sequence has still ended
+    }
+}
+
+void PostMatchSequencer::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    sequencer_.waits_.push_back({ handle, this, Clock::now() + timeout_ });
+}
+
+PostMatchSequencer::Awaiter PostMatchSequencer::WaitFor(PostMatchEvent event, double timeoutSec)
+{
+    const auto timeout = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(0.0, timeoutSec)));
+    return Awaiter(*this, event, timeout);
+}
+
+// #detailed comments: PostMatchSequencer::ResumeWhere
+// Purpose: Resumed sequences run their next step immediately and may
+// suspend again (appending to waits_) or finish, so the ready set is
+// moved out of waits_ before any of them runs.
+template <typename Pred>
+void PostMatchSequencer::ResumeWhere(Pred pred, PostMatchWaitResult result)
+{
+    std::vector<Wait> ready;
+    const auto split = std::stable_partition(waits_.begin(), waits_.end(), [&](const Wait& w) { return !pred(w); });
+    ready.assign(split, waits_.end());
+    waits_.erase(split, waits_.end());
+
+    for (const Wait& wait : ready) {
+        wait.awaiter->result_ = result;
+        wait.handle.resume();
+    }
+}
+
+void PostMatchSequencer::Raise(PostMatchEvent event)
+{
+    ResumeWhere([event](const Wait& w) { return w.awaiter->event_ == event; }, PostMatchWaitResult::Event);
+}
+
+void PostMatchSequencer::Poll(Clock::time_point now)
+{
+    ResumeWhere([now](const Wait& w) { return w.deadline <= now; }, PostMatchWaitResult::Timeout);
+}
+
+void PostMatchSequencer::CancelAll()
+{
+    std::vector<Wait> cancelled;
+    cancelled.swap(waits_);
+    for (const Wait& wait : cancelled) {
+        wait.handle.destroy();
+    }
+}
+
+bool PostMatchSequencer::IsWaitingFor(PostMatchEvent event) const
+{
+    return std::any_of(waits_.begin(), waits_.end(), [event](const Wait& w) { return w.awaiter->event_ == event; });
+}
+
+std::optional<PostMatchSequencer::Clock::time_point> PostMatchSequencer::NextDeadline() const
+{
+    if (waits_.empty()) return std::nullopt;
+    const auto it = std::min_element(waits_.begin(), waits_.end(),
+                                     [](const Wait& a, const Wait& b) { return a.deadline < b.deadline; });
+    return it->deadline;
+}
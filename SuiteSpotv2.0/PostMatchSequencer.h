@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <vector>
+
+// Game transitions a post-match sequence can wait for
+enum class PostMatchEvent : uint8_t {
+    Settled,       // The finished match can be left (results recorded, or back in the menu)
+    MapLoaded,     // A map finished loading after the sequence's load command
+    LoadStarted,   // The game began loading a map (a load command was accepted)
+    QueueStarted,  // Matchmaking is searching (a queue command was accepted)
+    Timer,         // Never raised: WaitFor(Timer, t) is a plain delay (see Sleep)
+};
+
+enum class PostMatchWaitResult : uint8_t {
+    Event,    // The awaited event was raised
+    Timeout,  // The fallback delay ran out first
+};
+
+// PostMatchSequencer: Runs post-match sequences as coroutines
+//
+// Purpose: Replaces fixed SetTimeout delays with waits on the game's own
+// transitions. A sequence is a coroutine returning Task that co_awaits
+// WaitFor(event, timeoutSec) between steps; it resumes as soon as the
+// event is raised, or when the timeout (the user's configured delay, now
+// a worst case) runs out. Events come from game hooks via Raise; timeouts
+// fire from Poll, which the owner calls on a short timer while
+// HasPending() is true.
+//
+// Lifetime: Sequences are fire-and-forget. A suspended sequence is owned
+// by the sequencer's wait list; CancelAll (and the destructor) destroy
+// those frames without resuming them, so a new match or an unload never
+// runs stale commands. A sequence that finishes frees itself.
+//
+// Threading: Game thread only (hooks, timers and sequences all run there;
+// sequences resume synchronously inside Raise and Poll).
+//
+// Usage Example:
+//   PostMatchSequencer::Task Run(PostMatchSequencer& seq) {
+//       co_await seq.WaitFor(PostMatchEvent::Settled, 5.0);
+//       Execute("load_freeplay ...");
+//       if (co_await seq.WaitFor(PostMatchEvent::MapLoaded, 15.0) == PostMatchWaitResult::Timeout) { ... }
+//       Execute("queue");
+//   }
+class PostMatchSequencer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        struct promise_type {
+            Task get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            // Nothing may escape into a hook: the error is logged and the
+            // sequence ends (its frame is freed like a finished one)
+            void unhandled_exception() noexcept { ReportUnhandled(std::current_exception()); }
+        };
+    };
+
+    // ERRORLOGs an exception that escaped a sequence
+    static void ReportUnhandled(std::exception_ptr error) noexcept;
+
+    class Awaiter
+    {
+    public:
+        Awaiter(PostMatchSequencer& sequencer, PostMatchEvent event, Clock::duration timeout)
+            : sequencer_(sequencer), event_(event), timeout_(timeout) {}
+
+        // A non-positive timeout means "do not wait" (the old zero-delay path)
+        bool await_ready() const noexcept { return timeout_ <= Clock::duration::zero(); }
+        void await_suspend(std::coroutine_handle<> handle);
+        PostMatchWaitResult await_resume() const noexcept { return result_; }
+
+    private:
+        friend class PostMatchSequencer;
+        PostMatchSequencer& sequencer_;
+        PostMatchEvent event_;
+        Clock::duration timeout_;
+        PostMatchWaitResult result_ = PostMatchWaitResult::Timeout;
+    };
+
+    PostMatchSequencer() = default;
+    PostMatchSequencer(const PostMatchSequencer&) = delete;
+    PostMatchSequencer& operator=(const PostMatchSequencer&) = delete;
+    ~PostMatchSequencer() { CancelAll(); }
+
+    Awaiter WaitFor(PostMatchEvent event, double timeoutSec);
+    Awaiter Sleep(double seconds) { return WaitFor(PostMatchEvent::Timer, seconds); }
+
+    // Resumes every sequence waiting for event
+    void Raise(PostMatchEvent event);
+    // Resumes every sequence whose timeout has passed
+    void Poll(Clock::time_point now = Clock::now());
+    // Destroys every suspended sequence
+    void CancelAll();
+
+    bool HasPending() const { return !waits_.empty(); }
+    bool IsWaitingFor(PostMatchEvent event) const;
+    std::optional<Clock::time_point> NextDeadline() const;
+
+private:
+    struct Wait {
+        std::coroutine_handle<> handle;
+        Awaiter* awaiter;
+        Clock::time_point deadline;
+    };
+
+    // Removes the waits matching pred, then resumes them in wait order
+    template <typename Pred>
+    void ResumeWhere(Pred pred, PostMatchWaitResult result);
+
+    std::vector<Wait> waits_;
+};
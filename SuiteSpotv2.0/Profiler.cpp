@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+Profiler& Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+int64_t Profiler::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t Profiler::RegisterSite(const char* name)
+{
+    // Markers sharing a name share a row
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < siteNames_.size(); ++i) {
+        if (siteNames_[i] == name) return static_cast<uint32_t>(i);
+    }
+    siteNames_.emplace_back(name);
+    return static_cast<uint32_t>(siteNames_.size() - 1);
+}
+
+std::string Profiler::SiteName(uint32_t site) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return site < siteNames_.size() ? siteNames_[site] : std::string("?");
+}
+
+// The buffer is owned by the profiler, so it outlives its thread and the
+// events of a finished thread can still be collected
+Profiler::ThreadBuffer& Profiler::LocalBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto owned = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        owned->index = static_cast<uint16_t>(std::min<size_t>(buffers_.size(), UINT16_MAX));
+        buffer = owned.get();
+        buffers_.push_back(std::move(owned));
+    }
+    return *buffer;
+}
+
+void Profiler::Record(uint32_t site, uint16_t depth, int64_t startNs, int64_t durationNs, const AllocCounters& allocs)
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    ProfileEvent event;
+    event.site = site;
+    event.depth = depth;
+    event.thread = buffer.index;
+    event.allocations = static_cast<uint32_t>(std::min<uint64_t>(allocs.allocations, UINT32_MAX));
+    event.allocBytes = static_cast<uint32_t>(std::min<uint64_t>(allocs.bytes, UINT32_MAX));
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    buffer.ring.Push(event);
+}
+
+void Profiler::MarkFrame(uint64_t frameId)
+{
+    // frameId_ is only touched here, on the render thread
+    if (frameId == frameId_) return;
+    frameId_ = frameId;
+
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    if (resetPending_.exchange(false, std::memory_order_acq_rel)) ApplyReset();
+    if (!Enabled()) {
+        frameStart_ = 0;
+        return;
+    }
+
+    const int64_t now = NowNs();
+    renderThread_ = LocalBuffer().index;
+    if (frameStart_ == 0) {
+        // First frame since recording started: nothing before it is a frame
+        SkipBuffered();
+    } else {
+        Collect();
+        CloseFrame(frameStart_, now);
+    }
+    frameStart_ = now;
+}
+
+void Profiler::Collect()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        collectBuffers_.clear();
+        for (const auto& buffer : buffers_) collectBuffers_.push_back(buffer.get());
+        if (sites_.size() < siteNames_.size()) sites_.resize(siteNames_.size());
+    }
+    scratch_.resize(kThreadCapacity);
+
+    for (ThreadBuffer* buffer : collectBuffers_) {
+        const uint64_t end = buffer->ring.Written();
+        const size_t count = buffer->ring.Copy(buffer->readCursor, end, scratch_.data());
+        buffer->readCursor = end;
+
+        for (size_t i = 0; i < count; ++i) {
+            const ProfileEvent& event = scratch_[i];
+            if (event.site >= sites_.size()) continue;
+            SiteWindow& window = sites_[event.site];
+            window.durationsUs[window.head] = static_cast<float>(event.durationNs / 1000.0);
+            window.head = (window.head + 1) % kWindow;
+            window.count = std::min(window.count + 1, kWindow);
+            ++window.calls;
+            current_.push_back(event);
+        }
+    }
+}
+
+void Profiler::CloseFrame(int64_t startNs, int64_t endNs)
+{
+    for (auto& window : sites_) {
+        window.callsLastFrame = 0;
+        window.lastFrameUs = 0.0;
+        window.allocsLastFrame = 0;
+        window.bytesLastFrame = 0;
+    }
+
+    double renderCostUs = 0.0;
+    for (const auto& event : current_) {
+        SiteWindow& window = sites_[event.site];
+        const double us = event.durationNs / 1000.0;
+        ++window.callsLastFrame;
+        window.lastFrameUs += us;
+        window.allocsLastFrame += event.allocations;
+        window.bytesLastFrame += event.allocBytes;
+        if (event.thread == renderThread_ && event.depth == 0) renderCostUs += us;
+    }
+    for (auto& window : sites_) {
+        window.peakAllocs = std::max(window.peakAllocs, window.allocsLastFrame);
+        window.peakBytes = std::max(window.peakBytes, window.bytesLastFrame);
+    }
+    frameCostMs_[frameCostHead_] = static_cast<float>(renderCostUs / 1000.0);
+    frameCostHead_ = (frameCostHead_ + 1) % kFrameHistory;
+    frameCostCount_ = std::min(frameCostCount_ + 1, kFrameHistory);
+
+    lastFrame_.swap(current_);
+    current_.clear();
+    std::sort(lastFrame_.begin(), lastFrame_.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+        return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+    });
+    lastFrameStart_ = startNs;
+    lastFrameEnd_ = endNs;
+}
+
+void Profiler::Reset()
+{
+    resetPending_.store(true, std::memory_order_release);
+}
+
+void Profiler::SkipBuffered()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) buffer->readCursor = buffer->ring.Written();
+}
+
+void Profiler::ApplyReset()
+{
+    for (auto& window : sites_) window = SiteWindow{};
+    current_.clear();
+    lastFrame_.clear();
+    frameCostCount_ = 0;
+    frameCostHead_ = 0;
+    frameStart_ = 0;
+}
+
+std::vector<ProfileSiteStats> Profiler::Stats() const
+{
+    std::vector<ProfileSiteStats> stats;
+    std::vector<float> sorted;
+    std::lock_guard<std::mutex> frameLock(frameMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < sites_.size() && i < siteNames_.size(); ++i) {
+        const SiteWindow& window = sites_[i];
+        if (window.calls == 0) continue;
+
+        ProfileSiteStats site;
+        site.name = siteNames_[i];
+        site.calls = window.calls;
+        site.callsLastFrame = window.callsLastFrame;
+        site.lastFrameUs = window.lastFrameUs;
+        site.allocsLastFrame = window.allocsLastFrame;
+        site.bytesLastFrame = window.bytesLastFrame;
+        site.peakAllocsPerFrame = window.peakAllocs;
+        site.peakBytesPerFrame = window.peakBytes;
+
+        sorted.assign(window.durationsUs.begin(), window.durationsUs.begin() + window.count);
+        const auto at = [&sorted](double q) {
+            const size_t k = std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()));
+            std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+            return static_cast<double>(sorted[k]);
+        };
+        site.p50Us = at(0.50);
+        site.p99Us = at(0.99);
+        site.maxUs = *std::max_element(sorted.begin(), sorted.end());
+        stats.push_back(std::move(site));
+    }
+    return stats;
+}
+
+std::vector<float> Profiler::FrameCostHistory() const
+{
+    std::vector<float> history;
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    history.reserve(frameCostCount_);
+    const size_t first = (frameCostHead_ + kFrameHistory - frameCostCount_) % kFrameHistory;
+    for (size_t i = 0; i < frameCostCount_; ++i) {
+        history.push_back(frameCostMs_[(first + i) % kFrameHistory]);
+    }
+    return history;
+}
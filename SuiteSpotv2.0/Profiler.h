@@ -0,0 +1,212 @@
+#pragma once
+
+#include "AllocTracker.h"
+#include "SpscRing.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped timing markers are compiled in when SUITESPOT_PROFILING is 1:
+// by default in debug builds; pass /DSUITESPOT_PROFILING=1 to keep them in
+// a release build. Compiled in, a scope costs one relaxed load until
+// recording is switched on (ss_profiler).
+#ifndef SUITESPOT_PROFILING
+#ifdef _DEBUG
+#define SUITESPOT_PROFILING 1
+#else
+#define SUITESPOT_PROFILING 0
+#endif
+#endif
+
+// One finished scope. Times are Profiler::NowNs() values.
+struct ProfileEvent {
+    uint32_t site = 0;
+    uint16_t depth = 0;   // Scopes open on the thread when this one began
+    uint16_t thread = 0;  // Profiler's index for the recording thread
+    uint32_t allocations = 0;  // Heap allocations inside the scope (AllocTracker)
+    uint32_t allocBytes = 0;   // Saturates at 4 GB
+    int64_t startNs = 0;
+    int64_t durationNs = 0;
+};
+
+// Rolling numbers for one marker, over its last kWindow calls
+struct ProfileSiteStats {
+    std::string name;
+    uint64_t calls = 0;           // Since the last Reset
+    uint32_t callsLastFrame = 0;
+    double lastFrameUs = 0.0;     // Summed over the last complete frame
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;           // Within the window
+    // Heap use summed over the last complete frame, and the worst frame
+    // since the last Reset; zero unless SUITESPOT_ALLOC_TRACKING
+    uint64_t allocsLastFrame = 0;
+    uint64_t bytesLastFrame = 0;
+    uint64_t peakAllocsPerFrame = 0;
+    uint64_t peakBytesPerFrame = 0;
+};
+
+// Profiler: Where plugin time goes, per frame, without an external profiler
+//
+// Purpose: SS_PROFILE_SCOPE("RenderSettings") times the enclosing scope.
+// Each thread records into its own SpscRing of kThreadCapacity events, so
+// recording takes no lock and never allocates after the thread's first
+// event; a thread that records faster than Collect drains loses its
+// oldest events, not its newest.
+//
+// Frames: the render thread calls MarkFrame once per ImGui frame. It pulls
+// new events from every thread into per-marker windows (p50/p99 over the
+// last kWindow calls) and keeps the finished frame's events for the frame
+// view. An event belongs to the frame in which its scope ended, so a
+// game-thread scope (GameEndedEvent) shows up next to the render work it
+// overlapped. With SUITESPOT_ALLOC_TRACKING each scope also records the
+// heap allocations made inside it, summed per marker per frame.
+//
+// Threading: RegisterSite, NowNs and recording from any thread. MarkFrame,
+// LastFrame and the frame times from the render thread only. Stats and
+// FrameCostHistory from any thread (ss_profiler dump runs on the game
+// thread); they share frameMutex_ with MarkFrame, taken once per frame.
+// Reset from any thread; the next MarkFrame applies it.
+//
+// Usage Example:
+//   void SuiteSpot::RenderSettings() {
+//       SS_PROFILE_SCOPE("RenderSettings");
+//       ...
+//   }
+//   // render thread, each frame
+//   profiler.MarkFrame(ImGui::GetFrameCount());
+//   for (const auto& s : profiler.Stats()) ImGui::Text("%s p99 %.1f us", s.name.c_str(), s.p99Us);
+class Profiler
+{
+public:
+    static constexpr size_t kThreadCapacity = 4096;  // Events buffered per thread
+    static constexpr size_t kWindow = 256;           // Calls per marker in the percentiles
+    static constexpr size_t kFrameHistory = 240;     // Frame costs kept for the plot
+
+    static Profiler& Get();
+    static int64_t NowNs();
+
+    // Once per call site (SS_PROFILE_SCOPE keeps it in a static)
+    uint32_t RegisterSite(const char* name);
+    std::string SiteName(uint32_t site) const;
+
+    void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Called by ProfileScope; records on the calling thread's buffer
+    void Record(uint32_t site, uint16_t depth, int64_t startNs, int64_t durationNs, const AllocCounters& allocs = {});
+
+    // Render thread: closes the frame in progress when frameId changes
+    // (repeats within a frame are ignored) and collects its events
+    void MarkFrame(uint64_t frameId);
+    // Any thread: clears the stats at the next MarkFrame
+    void Reset();
+
+    std::vector<ProfileSiteStats> Stats() const;
+    // Events of the last complete frame, by start time
+    const std::vector<ProfileEvent>& LastFrame() const { return lastFrame_; }
+    int64_t LastFrameStartNs() const { return lastFrameStart_; }
+    int64_t LastFrameEndNs() const { return lastFrameEnd_; }
+    // Top-level marker time on the render thread per frame, oldest first (ms)
+    std::vector<float> FrameCostHistory() const;
+
+private:
+    struct ThreadBuffer {
+        SpscRing<ProfileEvent, kThreadCapacity> ring;
+        uint16_t index = 0;
+        uint64_t readCursor = 0;  // Collect only
+    };
+
+    struct SiteWindow {
+        std::array<float, kWindow> durationsUs{};
+        size_t count = 0;
+        size_t head = 0;
+        uint64_t calls = 0;
+        uint32_t callsLastFrame = 0;
+        double lastFrameUs = 0.0;
+        uint64_t allocsLastFrame = 0;
+        uint64_t bytesLastFrame = 0;
+        uint64_t peakAllocs = 0;
+        uint64_t peakBytes = 0;
+    };
+
+    ThreadBuffer& LocalBuffer();
+    void ApplyReset();
+    void SkipBuffered();
+    void Collect();
+    void CloseFrame(int64_t startNs, int64_t endNs);
+
+    std::atomic<bool> enabled_{ false };
+    std::atomic<bool> resetPending_{ false };
+
+    mutable std::mutex mutex_;  // Guards siteNames_ and buffers_ (both only grow)
+    std::vector<std::string> siteNames_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    // Written by MarkFrame on the render thread; frameMutex_ is taken
+    // before mutex_ when both are needed
+    mutable std::mutex frameMutex_;
+    uint64_t frameId_ = 0;
+    int64_t frameStart_ = 0;       // Start of the frame in progress
+    int renderThread_ = -1;        // Buffer index of the thread calling MarkFrame
+    std::vector<SiteWindow> sites_;
+    std::vector<ThreadBuffer*> collectBuffers_;
+    std::vector<ProfileEvent> scratch_;
+    std::vector<ProfileEvent> current_;   // Events of the frame in progress
+    std::vector<ProfileEvent> lastFrame_;
+    int64_t lastFrameStart_ = 0;
+    int64_t lastFrameEnd_ = 0;
+    std::array<float, kFrameHistory> frameCostMs_{};
+    size_t frameCostCount_ = 0;
+    size_t frameCostHead_ = 0;
+};
+
+// RAII marker; use SS_PROFILE_SCOPE rather than naming it directly
+class ProfileScope
+{
+public:
+    explicit ProfileScope(uint32_t site)
+    {
+        if (!Profiler::Get().Enabled()) return;
+        site_ = site;
+        depth_ = static_cast<uint16_t>(depth++);
+        allocStart_ = ThreadAllocCounters();
+        startNs_ = Profiler::NowNs();
+    }
+    ~ProfileScope()
+    {
+        if (site_ == kInactive) return;
+        const int64_t endNs = Profiler::NowNs();
+        --depth;
+        Profiler::Get().Record(site_, depth_, startNs_, endNs - startNs_, ThreadAllocCounters() - allocStart_);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    static constexpr uint32_t kInactive = UINT32_MAX;
+    static inline thread_local int depth = 0;
+
+    uint32_t site_ = kInactive;
+    uint16_t depth_ = 0;
+    int64_t startNs_ = 0;
+    AllocCounters allocStart_;
+};
+
+#define SS_PROFILE_CONCAT_INNER(a, b) a##b
+#define SS_PROFILE_CONCAT(a, b) SS_PROFILE_CONCAT_INNER(a, b)
+
+#if SUITESPOT_PROFILING
+#define SS_PROFILE_SCOPE(name)                                                                     \
+    static const uint32_t SS_PROFILE_CONCAT(ssProfileSite_, __LINE__) = Profiler::Get().RegisterSite(name); \
+    ProfileScope SS_PROFILE_CONCAT(ssProfileScope_, __LINE__)(SS_PROFILE_CONCAT(ssProfileSite_, __LINE__))
+#else
+#define SS_PROFILE_SCOPE(name) ((void)0)
+#endif
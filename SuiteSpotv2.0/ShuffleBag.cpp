@@ -0,0 +1,95 @@
+#include "pch.h"
+#include "ShuffleBag.h"
+
+#include <algorithm>
+
+ShuffleBag::ShuffleBag(const TrainingCodeIndex& index)
+    : index_(index)
+{
+}
+
+bool ShuffleBag::ContainsRow(TrainingCodeSource source, int row) const
+{
+    const auto& bits = rowBits_[static_cast<size_t>(source)];
+    const size_t word = static_cast<size_t>(row) / 64;
+    if (row < 0 || word >= bits.size()) return false;
+    return (bits[word] >> (row % 64)) & 1u;
+}
+
+bool ShuffleBag::Add(TrainingCode code, std::string_view name)
+{
+    const auto inserted = slots_.emplace(code, static_cast<uint32_t>(items_.size()));
+    if (!inserted.second) return false;
+    items_.push_back({ code, std::string(name) });
+    SetRowBits(code, true);
+    ++version_;
+    return true;
+}
+
+bool ShuffleBag::Remove(TrainingCode code)
+{
+    const auto it = slots_.find(code);
+    if (it == slots_.end()) return false;
+
+    const uint32_t slot = it->second;
+    slots_.erase(it);
+    SetRowBits(code, false);
+
+    // Fill the hole with the last item so removal stays O(1)
+    if (slot + 1 != items_.size()) {
+        items_[slot] = std::move(items_.back());
+        slots_[items_[slot].code] = slot;
+    }
+    items_.pop_back();
+    ++version_;
+    return true;
+}
+
+void ShuffleBag::Clear()
+{
+    items_.clear();
+    slots_.clear();
+    for (size_t c = 0; c < kCatalogs; ++c) {
+        std::fill(rowBits_[c].begin(), rowBits_[c].end(), 0);
+        rowCounts_[c] = 0;
+    }
+    ++version_;
+}
+
+void ShuffleBag::RebindRows(TrainingCodeSource source, size_t rowCount)
+{
+    const size_t c = static_cast<size_t>(source);
+    rowBits_[c].assign((rowCount + 63) / 64, 0);
+    rowCounts_[c] = 0;
+    for (const auto& item : items_) {
+        const int row = index_.IndexOf(source, item.code);
+        if (row >= 0 && static_cast<size_t>(row) < rowCount) {
+            rowBits_[c][row / 64] |= uint64_t(1) << (row % 64);
+            ++rowCounts_[c];
+        }
+    }
+}
+
+void ShuffleBag::SetRowBits(TrainingCode code, bool value)
+{
+    const auto* location = index_.Find(code);
+    if (!location) return;
+
+    for (size_t c = 0; c < kCatalogs; ++c) {
+        const int row = location->rows[c];
+        if (row < 0) continue;
+
+        auto& bits = rowBits_[c];
+        const size_t word = static_cast<size_t>(row) / 64;
+        if (word >= bits.size()) bits.resize(word + 1, 0);
+        const uint64_t mask = uint64_t(1) << (row % 64);
+        const bool wasSet = (bits[word] & mask) != 0;
+        if (value && !wasSet) {
+            bits[word] |= mask;
+            ++rowCounts_[c];
+        } else if (!value && wasSet) {
+            bits[word] &= ~mask;
+            --rowCounts_[c];
+        }
+    }
+}
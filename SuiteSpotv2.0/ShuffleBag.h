@@ -0,0 +1,73 @@
+#pragma once
+
+#include "TrainingCode.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A bag entry: the packed code plus the name the bag file records (the
+// pack may not be in any loaded catalog, e.g. before the first scrape)
+struct ShuffleBagItem {
+    TrainingCode code;
+    std::string name;
+};
+
+// ShuffleBag: Training packs in the shuffle rotation
+//
+// Purpose: Stores the bag as compact code references instead of full
+// TrainingEntry copies, with two O(1) membership views:
+//   - a hash map from code to slot, for lookups by code and O(1) removal
+//     (the removed slot is filled with the last item, so bag order is not
+//     preserved; it is only ever sampled at random)
+//   - one bitset per catalog keyed by catalog row, so the Prejump browser
+//     and the training list can test "is this row in the bag" with a
+//     single bit test while drawing rows
+//
+// The training-list bitset replaces the old selectedTrainingIndices set:
+// "selected in the training list" and "in the bag" are the same state.
+//
+// Row bits come from the shared TrainingCodeIndex, so after a catalog is
+// reloaded or re-sorted (and reindexed) call RebindRows for it.
+class ShuffleBag
+{
+public:
+    explicit ShuffleBag(const TrainingCodeIndex& index);
+
+    bool Contains(TrainingCode code) const { return slots_.count(code) != 0; }
+    bool ContainsRow(TrainingCodeSource source, int row) const;
+
+    // Both return false when nothing changed
+    bool Add(TrainingCode code, std::string_view name);
+    bool Remove(TrainingCode code);
+    void Clear();
+
+    size_t Size() const { return items_.size(); }
+    bool Empty() const { return items_.empty(); }
+    const ShuffleBagItem& operator[](size_t i) const { return items_[i]; }
+    const std::vector<ShuffleBagItem>& Items() const { return items_; }
+
+    // Bumped by every Clear and by every Add/Remove that changed the bag
+    uint64_t GetVersion() const { return version_; }
+
+    // Number of bag packs that have a row in source
+    size_t CountRows(TrainingCodeSource source) const { return rowCounts_[static_cast<size_t>(source)]; }
+
+    // Rebuilds source's bitset for a catalog of rowCount rows (O(bag))
+    void RebindRows(TrainingCodeSource source, size_t rowCount);
+
+private:
+    static constexpr size_t kCatalogs = static_cast<size_t>(TrainingCodeSource::Count);
+
+    void SetRowBits(TrainingCode code, bool value);
+
+    const TrainingCodeIndex& index_;
+    std::vector<ShuffleBagItem> items_;
+    std::unordered_map<TrainingCode, uint32_t, TrainingCodeHash> slots_;  // code -> index into items_
+    std::array<std::vector<uint64_t>, kCatalogs> rowBits_;
+    std::array<size_t, kCatalogs> rowCounts_ = {};
+    uint64_t version_ = 0;
+};
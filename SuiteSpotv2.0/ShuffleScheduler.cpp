@@ -0,0 +1,306 @@
+#include "pch.h"
+#include "ShuffleScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+namespace
+{
+    constexpr double kMinManualWeight = 0.01;
+    constexpr double kMaxManualWeight = 100.0;
+    // Packs with no weight still belong to the rotation; they just come last
+    constexpr double kFloorWeight = 1e-6;
+    constexpr int kStateVersion = 1;
+}
+
+// #detailed comments: AliasTable::Build
+// Purpose: Vose's alias method. Weights are scaled so the average is 1;
+// each "small" column (< 1) is topped up by one "large" column, whose
+// excess moves back into the small or large list. Leftover columns hold
+// (up to rounding) exactly 1 and keep prob 1.
+void AliasTable::Build(const std::vector<double>& weights)
+{
+    prob_.clear();
+    alias_.clear();
+
+    double total = 0.0;
+    uint32_t anyPositive = 0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] > 0.0) {
+            total += weights[i];
+            anyPositive = static_cast<uint32_t>(i);
+        }
+    }
+    if (total <= 0.0) return;
+
+    const size_t n = weights.size();
+    prob_.assign(n, 0.0);
+    alias_.assign(n, anyPositive);
+
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] > 0.0 ? weights[i] * static_cast<double>(n) / total : 0.0;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const uint32_t s = small.back();
+        small.pop_back();
+        const uint32_t l = large.back();
+        prob_[s] = scaled[s];
+        alias_[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    for (uint32_t l : large) prob_[l] = 1.0;
+    // Rounding leftovers: real columns keep themselves, zero-weight ones
+    // always redirect (prob 0, alias to a positive column)
+    for (uint32_t s : small) prob_[s] = weights[s] > 0.0 ? 1.0 : 0.0;
+}
+
+size_t AliasTable::Sample(std::mt19937_64& rng) const
+{
+    std::uniform_int_distribution<size_t> column(0, prob_.size() - 1);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    const size_t i = column(rng);
+    return coin(rng) < prob_[i] ? i : alias_[i];
+}
+
+ShuffleScheduler::ShuffleScheduler()
+    : rng_(std::random_device{}())
+{
+}
+
+// #detailed comments: ShuffleScheduler::WeightedOrder
+// Purpose: Weighted sampling without replacement. Draws come from an
+// AliasTable over the packs still remaining; a draw that hits an already
+// taken pack is rejected. Once half the table's weight has been taken
+// the table is rebuilt over what is left, so the rejection rate never
+// exceeds one half (at most two expected samples per accepted pack) and
+// every rebuild at least halves the remaining weight.
+std::vector<uint32_t> ShuffleScheduler::WeightedOrder(const std::vector<double>& weights, std::mt19937_64& rng)
+{
+    std::vector<uint32_t> order;
+    order.reserve(weights.size());
+
+    std::vector<uint32_t> remaining(weights.size());
+    std::iota(remaining.begin(), remaining.end(), 0u);
+
+    AliasTable table;
+    std::vector<double> tableWeights;
+    std::vector<char> taken;
+    while (!remaining.empty()) {
+        tableWeights.resize(remaining.size());
+        double total = 0.0;
+        for (size_t k = 0; k < remaining.size(); ++k) {
+            tableWeights[k] = std::max(weights[remaining[k]], kFloorWeight);
+            total += tableWeights[k];
+        }
+        table.Build(tableWeights);
+        taken.assign(remaining.size(), 0);
+
+        double drawn = 0.0;
+        size_t takenCount = 0;
+        while (drawn < total * 0.5 && takenCount < remaining.size()) {
+            const size_t k = table.Sample(rng);
+            if (taken[k]) continue;
+            taken[k] = 1;
+            ++takenCount;
+            drawn += tableWeights[k];
+            order.push_back(remaining[k]);
+        }
+
+        size_t kept = 0;
+        for (size_t k = 0; k < remaining.size(); ++k) {
+            if (!taken[k]) remaining[kept++] = remaining[k];
+        }
+        remaining.resize(kept);
+    }
+    return order;
+}
+
+std::optional<TrainingCode> ShuffleScheduler::Next(const ShuffleBag& bag, const PackLookup& lookup)
+{
+    if (bag.Empty()) return std::nullopt;
+
+    if (bagVersion_ != bag.GetVersion()) {
+        MergeNewPacks(bag);
+        bagVersion_ = bag.GetVersion();
+    }
+
+    // Second pass only runs after a fresh rotation, which is never empty
+    for (int pass = 0; pass < 2; ++pass) {
+        while (cursor_ < order_.size()) {
+            const TrainingCode code = order_[cursor_++];
+            if (bag.Contains(code)) return code;  // removed packs are skipped
+        }
+        BuildRotation(bag, lookup);
+    }
+    return std::nullopt;
+}
+
+void ShuffleScheduler::BuildRotation(const ShuffleBag& bag, const PackLookup& lookup)
+{
+    const auto& items = bag.Items();
+    const std::optional<TrainingCode> previous = cursor_ > 0 && cursor_ <= order_.size()
+        ? std::optional<TrainingCode>(order_[cursor_ - 1]) : std::nullopt;
+
+    order_.clear();
+    order_.reserve(items.size());
+    if (mode_ == WeightMode::Uniform) {
+        for (const auto& item : items) order_.push_back(item.code);
+        std::shuffle(order_.begin(), order_.end(), rng_);
+    } else {
+        std::vector<double> weights(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            weights[i] = WeightOf(items[i].code, lookup);
+        }
+        for (uint32_t i : WeightedOrder(weights, rng_)) {
+            order_.push_back(items[i].code);
+        }
+    }
+
+    // No back-to-back repeat across the rotation boundary
+    if (previous && order_.size() > 1 && order_.front() == *previous) {
+        std::uniform_int_distribution<size_t> pick(1, order_.size() - 1);
+        std::swap(order_.front(), order_[pick(rng_)]);
+    }
+
+    cursor_ = 0;
+    ++rotation_;
+    bagVersion_ = bag.GetVersion();
+}
+
+// Packs added since the rotation was built go to random remaining slots
+void ShuffleScheduler::MergeNewPacks(const ShuffleBag& bag)
+{
+    if (order_.empty()) return;
+
+    std::unordered_set<TrainingCode, TrainingCodeHash> known(order_.begin(), order_.end());
+    for (const auto& item : bag.Items()) {
+        if (known.count(item.code)) continue;
+        order_.push_back(item.code);
+        std::uniform_int_distribution<size_t> slot(cursor_, order_.size() - 1);
+        std::swap(order_.back(), order_[slot(rng_)]);
+    }
+}
+
+void ShuffleScheduler::SetWeightMode(WeightMode mode)
+{
+    if (mode_ == mode) return;
+    mode_ = mode;
+    Reset();
+}
+
+void ShuffleScheduler::SetManualWeight(TrainingCode code, double weight)
+{
+    weight = std::clamp(weight, kMinManualWeight, kMaxManualWeight);
+    if (weight == 1.0) {
+        manualWeights_.erase(code);
+    } else {
+        manualWeights_[code] = weight;
+    }
+}
+
+double ShuffleScheduler::GetManualWeight(TrainingCode code) const
+{
+    const auto it = manualWeights_.find(code);
+    return it == manualWeights_.end() ? 1.0 : it->second;
+}
+
+double ShuffleScheduler::WeightOf(TrainingCode code, const PackLookup& lookup) const
+{
+    switch (mode_) {
+        case WeightMode::Manual:
+            return GetManualWeight(code);
+        case WeightMode::Likes:
+        case WeightMode::Plays: {
+            const TrainingEntry* entry = lookup ? lookup(code) : nullptr;
+            if (!entry) return 1.0;
+            const int value = mode_ == WeightMode::Likes ? entry->likes : entry->plays;
+            // Log-scaled so popular packs come up sooner without starving the rest
+            return 1.0 + std::log1p(static_cast<double>(std::max(0, value)));
+        }
+        default:
+            return 1.0;
+    }
+}
+
+void ShuffleScheduler::Reset()
+{
+    order_.clear();
+    cursor_ = 0;
+}
+
+// Line format: "key,value[,value]"; see Deserialize
+void ShuffleScheduler::Serialize(std::ostream& out) const
+{
+    out << "version," << kStateVersion << "\n";
+    out << "mode," << static_cast<int>(mode_) << "\n";
+    out << "rotation," << rotation_ << "\n";
+    out << "cursor," << cursor_ << "\n";
+    for (const auto& [code, weight] : manualWeights_) {
+        out << "weight," << code.ToString() << "," << weight << "\n";
+    }
+    for (const TrainingCode code : order_) {
+        out << "order," << code.ToString() << "\n";
+    }
+}
+
+bool ShuffleScheduler::Deserialize(std::istream& in)
+{
+    bool sawVersion = false;
+    int mode = static_cast<int>(WeightMode::Uniform);
+    uint64_t rotation = 0;
+    size_t cursor = 0;
+    std::unordered_map<TrainingCode, double, TrainingCodeHash> weights;
+    std::vector<TrainingCode> order;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const auto comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        const std::string key = line.substr(0, comma);
+        const std::string value = line.substr(comma + 1);
+
+        if (key == "version") {
+            sawVersion = std::atoi(value.c_str()) == kStateVersion;
+        } else if (key == "mode") {
+            mode = std::clamp(std::atoi(value.c_str()), 0, static_cast<int>(WeightMode::Manual));
+        } else if (key == "rotation") {
+            rotation = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "cursor") {
+            cursor = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (key == "weight") {
+            const auto split = value.find(',');
+            const auto code = TrainingCode::Parse(value.substr(0, split));
+            if (code && split != std::string::npos) {
+                weights[*code] = std::clamp(std::strtod(value.c_str() + split + 1, nullptr), kMinManualWeight, kMaxManualWeight);
+            }
+        } else if (key == "order") {
+            if (const auto code = TrainingCode::Parse(value)) order.push_back(*code);
+        }
+    }
+    if (!sawVersion) return false;
+
+    mode_ = static_cast<WeightMode>(mode);
+    rotation_ = rotation;
+    manualWeights_ = std::move(weights);
+    order_ = std::move(order);
+    cursor_ = std::min(cursor, order_.size());
+    bagVersion_ = UINT64_MAX;  // reconcile with whatever the bag holds now
+    return true;
+}
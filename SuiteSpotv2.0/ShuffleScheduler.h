@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ShuffleBag.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// AliasTable: O(1) sampling from a discrete weighted distribution
+//
+// Purpose: Vose's alias method. Build is O(n); every Sample is one
+// uniform draw, one table lookup and one compare, independent of n.
+class AliasTable
+{
+public:
+    // weights <= 0 are never sampled; all-zero input yields an empty table
+    void Build(const std::vector<double>& weights);
+    size_t Sample(std::mt19937_64& rng) const;
+    size_t Size() const { return prob_.size(); }
+
+private:
+    std::vector<double> prob_;
+    std::vector<uint32_t> alias_;
+};
+
+// ShuffleScheduler: Rotation order for the shuffle bag
+//
+// Purpose: Replaces uniform draws with replacement (which could repeat a
+// pack back to back) with rotations: every pack in the bag is drawn once
+// before any pack repeats. Each rotation is a random order of the bag,
+// optionally weighted so higher-weight packs tend to come up earlier.
+//
+// Cost: a rotation is generated up front, so each Next() is an O(1) read
+// of the next slot. Weighted orders are sampled from an AliasTable with
+// rejection of already-drawn packs; the table is rebuilt over the
+// remaining packs each time half the remaining weight has been drawn,
+// which keeps expected rejections below two per pack.
+//
+// Bag edits: removed packs are skipped when their slot comes up; packs
+// added mid-rotation are inserted at a random remaining slot (detected
+// through ShuffleBag::GetVersion, so callers need not notify).
+//
+// Persistence: Serialize/Deserialize write the mode, manual weights,
+// rotation order and cursor, so a restart resumes the same rotation.
+class ShuffleScheduler
+{
+public:
+    enum class WeightMode : uint8_t {
+        Uniform,  // every pack equally likely at each step
+        Likes,    // 1 + ln(1 + likes) from the catalog entry
+        Plays,    // 1 + ln(1 + plays) from the catalog entry
+        Manual,   // per-pack weight set with SetManualWeight (default 1)
+    };
+
+    // Catalog entry for a code, or null (used by the Likes/Plays modes)
+    using PackLookup = std::function<const TrainingEntry*(TrainingCode)>;
+
+    ShuffleScheduler();
+
+    // Next pack of the current rotation; starts a new one when exhausted.
+    // Empty only when the bag is empty.
+    std::optional<TrainingCode> Next(const ShuffleBag& bag, const PackLookup& lookup);
+
+    void SetWeightMode(WeightMode mode);
+    WeightMode GetWeightMode() const { return mode_; }
+    // Clamped to [0.01, 100]; 1 (the default) removes the override
+    void SetManualWeight(TrainingCode code, double weight);
+    double GetManualWeight(TrainingCode code) const;
+    double WeightOf(TrainingCode code, const PackLookup& lookup) const;
+
+    // Drops the current rotation; the next draw starts a fresh one
+    void Reset();
+
+    size_t GetCursor() const { return cursor_; }
+    size_t GetRotationSize() const { return order_.size(); }
+    uint64_t GetRotationCount() const { return rotation_; }
+
+    void Serialize(std::ostream& out) const;
+    // Returns false (state unchanged) when the stream is not a saved rotation
+    bool Deserialize(std::istream& in);
+
+    // Random order of 0..weights.size()-1 without repeats, weighted as above
+    static std::vector<uint32_t> WeightedOrder(const std::vector<double>& weights, std::mt19937_64& rng);
+
+private:
+    void BuildRotation(const ShuffleBag& bag, const PackLookup& lookup);
+    void MergeNewPacks(const ShuffleBag& bag);
+
+    WeightMode mode_ = WeightMode::Uniform;
+    std::unordered_map<TrainingCode, double, TrainingCodeHash> manualWeights_;
+    std::vector<TrainingCode> order_;
+    size_t cursor_ = 0;
+    uint64_t rotation_ = 0;
+    uint64_t bagVersion_ = 0;
+    std::mt19937_64 rng_;
+};
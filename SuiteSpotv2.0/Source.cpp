@@ -4,9 +4,11 @@
 #include <shellapi.h>
 #include "SuiteSpot.h"
 #include "MapList.h"
+#include "IMGUI/imgui_timeline.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <ctime>
 
 // Helper function for sortable column headers with visual indicators
 namespace {
@@ -50,8 +52,8 @@ void SuiteSpot::SetImGuiContext(uintptr_t ctx) {
 // #detailed comments: RenderSettings
 // Purpose: Build the Settings UI using ImGui. This method is called on
 // the UI thread and must complete quickly — avoid heavy computation
-// or blocking calls here. Instead, schedule background work with
-// gameWrapper->SetTimeout if needed.
+// or blocking calls here. Instead, defer game work onto timerWheel
+// (it runs on the game thread, from the viewport tick).
 //
 // UI & state invariants:
 //  - Any changes to cvars must keep the CVar<->member variable sync
@@ -65,6 +67,10 @@ void SuiteSpot::SetImGuiContext(uintptr_t ctx) {
 // relied upon by external automation and saved settings; altering them
 // will change user-visible state persistence and CLI integrations.
 void SuiteSpot::RenderSettings() {
+    Profiler::Get().MarkFrame(ImGui::GetFrameCount());
+    SS_PROFILE_SCOPE("RenderSettings");
+    SS_TRACE_SCOPE("render", "RenderSettings");
+
     // Header with metadata
     ImGui::TextUnformatted("SuiteSpot");
     ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "By: Flicks Creations");
@@ -89,32 +95,21 @@ void SuiteSpot::RenderSettings() {
             mapDelayStr = std::to_string(delayFreeplaySec) + "s";
         } else if (mapType == 1) {
             if (!RLTraining.empty() && currentTrainingIndex >= 0 && currentTrainingIndex < (int)RLTraining.size()) {
-                currentMap = RLTraining[currentTrainingIndex].name + " (Shots:" + std::to_string(RLTraining[currentTrainingIndex].shotCount) + ")";
+                currentMap = std::string(RLTraining[currentTrainingIndex].name) + " (Shots:" + std::to_string(RLTraining[currentTrainingIndex].shotCount) + ")";
             }
             mapDelayStr = std::to_string(delayTrainingSec) + "s";
 
             if (trainingShuffleEnabled) {
-                int shuffleCount = 0;
-                if (!trainingShuffleBag.empty()) {
-                    shuffleCount = static_cast<int>(trainingShuffleBag.size());
-                } else if (!selectedTrainingIndices.empty()) {
-                    shuffleCount = static_cast<int>(selectedTrainingIndices.size());
-                }
-                // Only show shuffle indicator when we have a non-empty selection/bag.
+                int shuffleCount = static_cast<int>(trainingShuffleBag.Size());
+                // Only show shuffle indicator when we have a non-empty bag.
                 if (shuffleCount > 0) {
                     if (shuffleCount == 1) {
-                        // Single pack in shuffle – show its name/shots.
-                        const TrainingEntry* entry = nullptr;
-                        if (!trainingShuffleBag.empty()) {
-                            entry = &trainingShuffleBag.front();
-                        } else if (!selectedTrainingIndices.empty()) {
-                            int idx = *selectedTrainingIndices.begin();
-                            if (idx >= 0 && idx < static_cast<int>(RLTraining.size())) {
-                                entry = &RLTraining[idx];
-                            }
-                        }
-                        if (entry) {
-                            currentMap = entry->name + " (Shots:" + std::to_string(entry->shotCount) + ")";
+                        // Single pack in shuffle – show its name/shots when a catalog has it.
+                        const ShuffleBagItem& item = trainingShuffleBag[0];
+                        if (const TrainingEntry* entry = FindTrainingEntry(item.code)) {
+                            currentMap = std::string(entry->name) + " (Shots:" + std::to_string(entry->shotCount) + ")";
+                        } else {
+                            currentMap = item.name;
                         }
                     } else {
                         currentMap = "Shuffle (" + std::to_string(shuffleCount) + " packs)";
@@ -207,7 +202,7 @@ void SuiteSpot::RenderSettings() {
         cvarManager->getCvar("suitespot_auto_queue").setValue(autoQueue);
     }
     if (ImGui::IsItemHovered()) {
-    ImGui::SetTooltip("Automatically queue into the next match after the current match ends.\nQueue delay starts at match end, independent of map load.");
+    ImGui::SetTooltip("Automatically queue into the next match after the current match ends.\nQueues once the loaded map is ready (or the match has settled when no map is loaded).");
 }
 
 ImGui::SetNextItemWidth(220);
@@ -216,7 +211,14 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
         cvarManager->getCvar("suitespot_delay_queue_sec").setValue(delayQueueSec);
     }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Wait this many seconds before queuing (independent of map load time)");
+        ImGui::SetTooltip("Longest wait before queuing, counted from match end.\nQueue starts sooner when the game is ready.");
+    }
+
+    if (ImGui::Checkbox("Adaptive Delays", &adaptiveDelaysEnabled)) {
+        cvarManager->getCvar("suitespot_adaptive_delays").setValue(adaptiveDelaysEnabled);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Learn the shortest load/queue delays that work, per mode and playlist.\nStarts from the delays below and retries any command the game ignores.\nSee ss_adaptive_delays.");
     }
 
     ImGui::Separator();
@@ -252,9 +254,9 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
         if (ImGui::Button("Load Now##freeplay")) {
             if (!RLMaps.empty() && currentIndex >= 0 && currentIndex < (int)RLMaps.size()) {
                 std::string mapCode = RLMaps[currentIndex].code;
-                gameWrapper->SetTimeout([this, mapCode](GameWrapper* gw) {
+                timerWheel.Schedule(std::chrono::milliseconds(0), [this, mapCode]() {
                     cvarManager->executeCommand("load_freeplay " + mapCode);
-                }, 0.0f);
+                }, kMapLoadTimerKey);
             }
         }
         if (ImGui::IsItemHovered()) {
@@ -269,7 +271,7 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             cvarManager->getCvar("suitespot_delay_freeplay_sec").setValue(delayFreeplaySec);
         }
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Wait this many seconds after match ends before loading Freeplay");
+            ImGui::SetTooltip("Longest wait after match end before loading Freeplay.\nLoads sooner once the match has settled; 0 loads immediately.");
         }
     }
     else if (mapType == 1) {
@@ -283,14 +285,14 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
         const char* trainingLabel = "<none>";
         static std::string trainingLabelBuf;
         if (!RLTraining.empty() && currentTrainingIndex >= 0 && currentTrainingIndex < (int)RLTraining.size()) {
-            trainingLabelBuf = RLTraining[currentTrainingIndex].name + " (Shots:" + std::to_string(RLTraining[currentTrainingIndex].shotCount) + ")";
+            trainingLabelBuf = std::string(RLTraining[currentTrainingIndex].name) + " (Shots:" + std::to_string(RLTraining[currentTrainingIndex].shotCount) + ")";
             trainingLabel = trainingLabelBuf.c_str();
         }
 
         if (ImGui::BeginCombo("Training Packs", trainingLabel)) {
             for (int i = 0; i < (int)RLTraining.size(); ++i) {
                 bool selected = (i == currentTrainingIndex);
-                std::string itemLabel = RLTraining[i].name + " (Shots:" + std::to_string(RLTraining[i].shotCount) + ")";
+                std::string itemLabel = std::string(RLTraining[i].name) + " (Shots:" + std::to_string(RLTraining[i].shotCount) + ")";
                 if (ImGui::Selectable(itemLabel.c_str(), selected)) {
                     currentTrainingIndex = i;
                     cvarManager->getCvar("suitespot_current_training_index").setValue(currentTrainingIndex);
@@ -310,10 +312,9 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             }
             LoadTrainingMaps();
             if (!previousCode.empty()) {
-                auto it = std::find_if(RLTraining.begin(), RLTraining.end(),
-                    [&](const TrainingEntry& entry){ return entry.code == previousCode; });
-                if (it != RLTraining.end()) {
-                    currentTrainingIndex = static_cast<int>(std::distance(RLTraining.begin(), it));
+                const int row = trainingCodeIndex.IndexOf(TrainingCodeSource::Training, previousCode);
+                if (row >= 0) {
+                    currentTrainingIndex = row;
                     cvarManager->getCvar("suitespot_current_training_index").setValue(currentTrainingIndex);
                 }
             }
@@ -328,28 +329,17 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
                 int indexToLoad = currentTrainingIndex;
 
                 if (trainingShuffleEnabled) {
-                    // Build bag from current selection; if none selected and bag empty, fall back to dropdown.
-                    if (trainingShuffleBag.empty()) {
-                        trainingShuffleBag.clear();
-                        if (!selectedTrainingIndices.empty()) {
-                            for (int idx : selectedTrainingIndices) {
-                                if (idx >= 0 && idx < static_cast<int>(RLTraining.size())) {
-                                    trainingShuffleBag.push_back(RLTraining[idx]);
-                                }
-                            }
-                        }
-                    }
-
-                    if (!trainingShuffleBag.empty()) {
+                    // The bag is the selection; if it is empty, fall back to the dropdown.
+                    if (!trainingShuffleBag.Empty()) {
                         indexToLoad = GetRandomTrainingIndex();
                     } // else fall back to the currently selected pack
                 }
 
                 indexToLoad = std::clamp(indexToLoad, 0, (int)RLTraining.size() - 1);
-                std::string packCode = RLTraining[indexToLoad].code;
-                gameWrapper->SetTimeout([this, packCode](GameWrapper* gw) {
+                std::string packCode(RLTraining[indexToLoad].code);
+                timerWheel.Schedule(std::chrono::milliseconds(0), [this, packCode]() {
                     cvarManager->executeCommand("load_training " + packCode);
-                }, 0.0f);
+                }, kMapLoadTimerKey);
             }
         }
         if (ImGui::IsItemHovered()) {
@@ -375,7 +365,7 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             cvarManager->getCvar("suitespot_delay_training_sec").setValue(delayTrainingSec);
         }
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Wait this many seconds after match ends before loading Training");
+            ImGui::SetTooltip("Longest wait after match end before loading Training.\nLoads sooner once the match has settled; 0 loads immediately.");
         }
         
         if (showAddTrainingForm) {
@@ -388,6 +378,7 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             static char newMapName[64] = {0};
             static bool addSuccess = false;
             static float addSuccessTimer = 0.0f;
+            static bool addInvalidCode = false;
             
             ImGui::InputText("Training Map Code##input", newMapCode, IM_ARRAYSIZE(newMapCode), 0);
             if (ImGui::IsItemHovered()) {
@@ -400,16 +391,19 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             }
             
             if (ImGui::Button("Add Training Map")) {
-                if (strlen(newMapCode) > 0 && strlen(newMapName) > 0) {
-                    const std::string codeStr(newMapCode);
+                const std::string codeStr = TrainingCode::Normalize(newMapCode);
+                addInvalidCode = strlen(newMapCode) > 0 && codeStr.empty();
+                if (!codeStr.empty() && strlen(newMapName) > 0) {
                     const std::string nameStr(newMapName);
-                    RLTraining.push_back({ codeStr, nameStr });
-                    SaveTrainingMaps();
-                    LoadTrainingMaps();
-                    auto it = std::find_if(RLTraining.begin(), RLTraining.end(),
-                        [&](const TrainingEntry& entry){ return entry.code == codeStr; });
-                    if (it != RLTraining.end()) {
-                        currentTrainingIndex = static_cast<int>(std::distance(RLTraining.begin(), it));
+                    // An existing code is just selected rather than added twice
+                    if (!trainingCodeIndex.Contains(TrainingCodeSource::Training, codeStr)) {
+                        RLTraining.push_back({ codeStr, nameStr });
+                        SaveTrainingMaps();
+                        LoadTrainingMaps();
+                    }
+                    const int row = trainingCodeIndex.IndexOf(TrainingCodeSource::Training, codeStr);
+                    if (row >= 0) {
+                        currentTrainingIndex = row;
                         cvarManager->getCvar("suitespot_current_training_index").setValue(currentTrainingIndex);
                     }
                     addSuccess = true;
@@ -422,6 +416,11 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
                 ImGui::SetTooltip("Add this training pack to your collection");
             }
             
+            if (addInvalidCode) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Invalid code (expected XXXX-XXXX-XXXX-XXXX)");
+            }
+
             if (addSuccess && addSuccessTimer > 0.0f) {
                 ImGui::SameLine();
                 ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, addSuccessTimer / 3.0f), "Pack added!");
@@ -479,9 +478,9 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
         if (ImGui::Button("Load Now##workshop")) {
             if (!RLWorkshop.empty() && currentWorkshopIndex >= 0 && currentWorkshopIndex < (int)RLWorkshop.size()) {
                 std::string filePath = RLWorkshop[currentWorkshopIndex].filePath;
-                gameWrapper->SetTimeout([this, filePath](GameWrapper* gw) {
+                timerWheel.Schedule(std::chrono::milliseconds(0), [this, filePath]() {
                     cvarManager->executeCommand("load_workshop \"" + filePath + "\"");
-                }, 0.0f);
+                }, kMapLoadTimerKey);
             }
         }
         if (ImGui::IsItemHovered()) {
@@ -544,7 +543,7 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             cvarManager->getCvar("suitespot_delay_workshop_sec").setValue(delayWorkshopSec);
         }
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Wait this many seconds after match ends before loading Workshop");
+            ImGui::SetTooltip("Longest wait after match end before loading Workshop.\nLoads sooner once the match has settled; 0 loads immediately.");
         }
     }
 
@@ -557,44 +556,50 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             ImGui::Spacing();
             
             if (loadoutManager) {
-                // Get current loadout name
-                static std::string currentLoadoutName;
-                static std::vector<std::string> loadoutNames;
-                static int selectedLoadoutIndex = 0;
-                static bool loadoutsInitialized = false;
+                // Results of finished loadout tasks; nothing here waits on the game thread.
+                // The preset list is a shared snapshot, so reading it copies no names.
+                const LoadoutManager::State loadoutState = loadoutManager->GetState();
+                const LoadoutSnapshot& presets = *loadoutState.presets;
+                const auto& loadoutNames = presets.names;
+                static std::string selectedLoadout;
+                static uint64_t selectedGeneration = 0;
                 
-                // Initialize loadout list on first render
-                if (!loadoutsInitialized) {
-                    loadoutNames = loadoutManager->GetLoadoutNames();
-                    currentLoadoutName = loadoutManager->GetCurrentLoadoutName();
-                    loadoutsInitialized = true;
+                // Keep the selection by name; drop it if a new generation removed that preset
+                if (selectedGeneration != presets.generation) {
+                    selectedGeneration = presets.generation;
+                    if (!presets.presetIndex.contains(selectedLoadout)) {
+                        selectedLoadout = loadoutNames.empty() ? std::string() : loadoutNames.front();
+                    }
                 }
                 
                 // Display current active loadout
                 ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "Current Loadout:");
                 ImGui::SameLine();
-                if (currentLoadoutName.empty()) {
+                if (presets.current.empty()) {
                     ImGui::TextUnformatted("<Unknown>");
                 } else {
-                    ImGui::TextUnformatted(currentLoadoutName.c_str());
+                    ImGui::TextUnformatted(presets.current.c_str());
                 }
                 if (ImGui::IsItemHovered()) {
                     ImGui::SetTooltip("Your currently equipped loadout preset");
                 }
+                if (loadoutState.pending > 0) {
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(updating...)");
+                }
                 
                 ImGui::Spacing();
                 
                 // Loadout selection dropdown
-                const char* comboLabel = loadoutNames.empty() ? "<No loadouts found>" : 
-                    (selectedLoadoutIndex >= 0 && selectedLoadoutIndex < (int)loadoutNames.size() ? 
-                        loadoutNames[selectedLoadoutIndex].c_str() : "<Select loadout>");
+                const char* comboLabel = loadoutNames.empty() ? (presets.ready ? "<No loadouts found>" : "<Loading...>") :
+                    (!selectedLoadout.empty() ? selectedLoadout.c_str() : "<Select loadout>");
                 
                 ImGui::SetNextItemWidth(220);
                 if (ImGui::BeginCombo("##loadout_combo", comboLabel)) {
-                    for (int i = 0; i < (int)loadoutNames.size(); ++i) {
-                        bool isSelected = (i == selectedLoadoutIndex);
-                        if (ImGui::Selectable(loadoutNames[i].c_str(), isSelected)) {
-                            selectedLoadoutIndex = i;
+                    for (const auto& name : loadoutNames) {
+                        bool isSelected = (name == selectedLoadout);
+                        if (ImGui::Selectable(name.c_str(), isSelected)) {
+                            selectedLoadout = name;
                         }
                         if (isSelected) {
                             ImGui::SetItemDefaultFocus();
@@ -606,24 +611,15 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
                     ImGui::SetTooltip("Select a loadout preset to equip");
                 }
                 
-                // Apply loadout button
+                // Apply loadout button; the label above updates when the switch finishes
                 ImGui::SameLine();
                 if (ImGui::Button("Apply Loadout")) {
-                    if (selectedLoadoutIndex >= 0 && selectedLoadoutIndex < (int)loadoutNames.size()) {
-                        std::string selectedName = loadoutNames[selectedLoadoutIndex];
-                        gameWrapper->SetTimeout([this, selectedName](GameWrapper* gw) {
-                            if (loadoutManager) {
-                                bool success = loadoutManager->SwitchLoadout(selectedName);
-                                if (success) {
-                                    LOG("SuiteSpot: Successfully switched to loadout: " + selectedName);
-                                } else {
-                                    LOG("SuiteSpot: Failed to switch to loadout: " + selectedName);
-                                }
+                    if (!selectedLoadout.empty()) {
+                        loadoutManager->SwitchLoadout(selectedLoadout, [](const LoadoutResult& result) {
+                            if (!result.Ok()) {
+                                LOG("SuiteSpot: Failed to switch loadout: " + result.error);
                             }
-                        }, 0.0f);
-                        
-                        // Update current loadout display
-                        currentLoadoutName = selectedName;
+                        });
                     }
                 }
                 if (ImGui::IsItemHovered()) {
@@ -633,27 +629,57 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
                 // Refresh loadouts button
                 ImGui::SameLine();
                 if (ImGui::Button("Refresh Loadouts")) {
-                    // Reset initialization flag to force refresh on next render
-                    loadoutsInitialized = false;
-                    
-                    gameWrapper->SetTimeout([this](GameWrapper* gw) {
-                        if (loadoutManager) {
-                            loadoutManager->RefreshLoadoutCache();
-                            LOG("SuiteSpot: Loadout list refreshed, found " + 
-                                std::to_string(loadoutManager->GetLoadoutNames().size()) + " loadout(s)");
+                    loadoutManager->RefreshLoadoutCache([](const LoadoutResult& result) {
+                        if (result.Ok()) {
+                            LOG("SuiteSpot: Loadout list refreshed, found " + std::to_string(result.names.size()) + " loadout(s)");
                         }
-                    }, 0.0f);
+                    });
                 }
                 if (ImGui::IsItemHovered()) {
                     ImGui::SetTooltip("Refresh the list of available loadout presets");
                 }
                 
+                if (!loadoutState.lastError.empty()) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "%s", loadoutState.lastError.c_str());
+                }
+                
                 // Display loadout count
                 ImGui::Spacing();
                 ImGui::TextDisabled(("Available loadouts: " + std::to_string(loadoutNames.size())).c_str());
                 if (ImGui::IsItemHovered() && loadoutNames.empty()) {
                     ImGui::SetTooltip("No loadout presets found. Create loadouts in-game in the Garage menu.");
                 }
+                
+                // Per-mode rules, applied by the post-match sequence
+                ImGui::Spacing();
+                ImGui::Separator();
+                ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "Switch Automatically After Matches");
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Equip a preset as SuiteSpot loads the next map or queues.\nThe preset is looked up ahead of time, so switching adds no delay.");
+                }
+                for (size_t i = 0; i < kLoadoutRuleCount; ++i) {
+                    const auto rule = static_cast<LoadoutRule>(i);
+                    const std::string ruleName = LoadoutRuleName(rule);
+                    const std::string rulePreset = loadoutManager->GetRule(rule);
+                    const bool missing = !rulePreset.empty() && presets.ready && !presets.presetIndex.contains(rulePreset);
+                    
+                    ImGui::SetNextItemWidth(220);
+                    if (ImGui::BeginCombo(("On " + ruleName + "##loadout_rule").c_str(), rulePreset.empty() ? "<Keep current>" : rulePreset.c_str())) {
+                        if (ImGui::Selectable("<Keep current>", rulePreset.empty())) {
+                            cvarManager->getCvar("suitespot_loadout_" + ruleName).setValue("");
+                        }
+                        for (const auto& name : loadoutNames) {
+                            if (ImGui::Selectable(name.c_str(), name == rulePreset)) {
+                                cvarManager->getCvar("suitespot_loadout_" + ruleName).setValue(name);
+                            }
+                        }
+                        ImGui::EndCombo();
+                    }
+                    if (missing) {
+                        ImGui::SameLine();
+                        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "(preset not found)");
+                    }
+                }
             } else {
                 ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "LoadoutManager not initialized");
             }
@@ -695,6 +721,13 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
                 ImGui::SameLine();
                 ImGui::SetNextItemWidth(180);
                 ImGui::SliderFloat("Offset Y##overlay", &overlayOffsetY, -500.0f, 500.0f, "%.0f");
+
+                if (ImGui::Checkbox("Match Timeline", &matchTimelineEnabled)) {
+                    cvarManager->getCvar("suitespot_match_timeline").setValue(matchTimelineEnabled);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Sample every player's score, goals and saves once a second during matches\nand plot team points under the scoreboard (cost: ss_timeline)");
+                }
             }
 
             // === TEAM SECTIONS ===
@@ -818,16 +851,209 @@ if (ImGui::InputInt("Delay Queue (sec)", &delayQueueSec)) {
             ImGui::EndTabItem();
         } // End Prejump Packs tab
 
+        // ===== LATENCY TAB =====
+        if (ImGui::BeginTabItem("Latency")) {
+            RenderLatencyTab();
+            ImGui::EndTabItem();
+        } // End Latency tab
+
+        // ===== HISTORY TAB =====
+        if (ImGui::BeginTabItem("History")) {
+            RenderHistoryTab();
+            ImGui::EndTabItem();
+        } // End History tab
+
         // Close the tab bar
         ImGui::EndTabBar();
     } // End tab bar
 }
 
+// #detailed comments: RenderLatencyTab
+// Purpose: Per-mode post-match latency from PostMatchLatency. Each stage
+// gets its percentiles and a histogram with one bar per power of two
+// (bar 0 is everything under 2 ms), so load time and SuiteSpot's own
+// wait can be told apart at a glance.
+void SuiteSpot::RenderLatencyTab() {
+    ImGui::Spacing();
+    ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "Time from match end to the next activity");
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "wait: until the load command | load: game load time | total: match end to map loaded | queue: match end to queue");
+    ImGui::Spacing();
+
+    const char* modeNames[] = { "Freeplay", "Training", "Workshop" };
+    ImGui::SetNextItemWidth(160);
+    ImGui::Combo("Mode##latency", &latencyPanelMode, modeNames, IM_ARRAYSIZE(modeNames));
+    latencyPanelMode = std::clamp(latencyPanelMode, 0, static_cast<int>(LatencyMode::Count) - 1);
+    ImGui::SameLine();
+    if (ImGui::Button("Reset##latency")) {
+        postMatchLatency.Reset();
+    }
+
+    const auto snapshot = postMatchLatency.GetSnapshot();
+    const auto& stats = snapshot[latencyPanelMode];
+    ImGui::Text("%llu matches, %llu steps started at fallback", static_cast<unsigned long long>(stats.matches),
+                static_cast<unsigned long long>(stats.fallbacks));
+    ImGui::Separator();
+
+    for (size_t st = 0; st < stats.stages.size(); ++st) {
+        const auto stage = static_cast<LatencyStage>(st);
+        const LatencyHistogram& histogram = stats.Get(stage);
+        ImGui::PushID(static_cast<int>(st));
+        if (histogram.Count() == 0) {
+            ImGui::TextDisabled("%s: no samples", LatencyStageName(stage));
+        } else {
+            char overlay[96];
+            snprintf(overlay, sizeof(overlay), "p50 %.2fs  p90 %.2fs  p99 %.2fs",
+                     histogram.Percentile(0.50) / 1000.0, histogram.Percentile(0.90) / 1000.0, histogram.Percentile(0.99) / 1000.0);
+            const auto counts = histogram.OctaveCounts();
+            ImGui::Text("%s (n=%llu, max %.2fs)", LatencyStageName(stage), static_cast<unsigned long long>(histogram.Count()), histogram.Max() / 1000.0);
+            ImGui::PlotHistogram("##latency", counts.data(), static_cast<int>(counts.size()), 0, overlay,
+                                 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+        }
+        ImGui::PopID();
+    }
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Bars: <2ms, 2ms, 4ms ... 65s (each bar doubles)");
+}
+
+// #detailed comments: RenderHistoryTab
+// Purpose: Browse MatchHistory. Totals come from the history's running
+// aggregates, and the list only reads the rows on screen (a list clipper
+// over the mapped index), so the tab costs the same with 50 matches or
+// 50,000. Selecting a row decodes that one record for its scoreboard.
+void SuiteSpot::RenderHistoryTab() {
+    ImGui::Spacing();
+    ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "Every match result SuiteSpot has captured");
+    if (!matchHistory.IsOpen()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Match history is unavailable - see the console for the reason");
+        return;
+    }
+    ImGui::Spacing();
+
+    std::string currentName = historyPanelPlaylist == 0 ? std::string() : matchHistory.PlaylistName(historyPanelPlaylist);
+    if (currentName.empty()) {
+        historyPanelPlaylist = 0;
+        currentName = "All playlists";
+    }
+    ImGui::SetNextItemWidth(220);
+    if (ImGui::BeginCombo("Playlist##history", currentName.c_str())) {
+        if (ImGui::Selectable("All playlists", historyPanelPlaylist == 0)) {
+            historyPanelPlaylist = 0;
+        }
+        for (const auto& playlist : matchHistory.Playlists()) {
+            char label[128];
+            snprintf(label, sizeof(label), "%s (%u)##%u", playlist.name.c_str(), playlist.stats.games, playlist.hash);
+            if (ImGui::Selectable(label, historyPanelPlaylist == playlist.hash)) {
+                historyPanelPlaylist = playlist.hash;
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    const MatchAggregate stats = matchHistory.Stats(historyPanelPlaylist);
+    ImGui::Text("%u games (%u W - %u L)  |  win rate %.0f%%  |  %.2f goals/game  |  MVP %.0f%%  |  %u overtime",
+                stats.games, stats.wins, stats.games - stats.wins, stats.WinRate() * 100.0, stats.GoalsPerGame(),
+                stats.MvpRate() * 100.0, stats.overtimes);
+    if (stats.trendCount > 0) {
+        char overlay[96];
+        snprintf(overlay, sizeof(overlay), "last %u: win %.0f%%, %.2f goals/game", stats.trendCount,
+                 stats.TrendWinRate() * 100.0, stats.TrendGoalsPerGame());
+        const auto series = stats.TrendGoalsSeries();
+        ImGui::PlotLines("##historytrend", series.data(), static_cast<int>(series.size()), 0, overlay,
+                         0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 50.0f));
+    }
+    ImGui::Separator();
+
+    const size_t count = matchHistory.Count(historyPanelPlaylist);
+    if (count == 0) {
+        ImGui::TextDisabled("No matches recorded yet");
+        return;
+    }
+
+    ImGui::BeginChild("##historylist", ImVec2(0, 220), true);
+    ImGui::Columns(5, "HistoryColumns", true);
+    ImGui::TextUnformatted("When"); ImGui::NextColumn();
+    ImGui::TextUnformatted("Playlist"); ImGui::NextColumn();
+    ImGui::TextUnformatted("Score"); ImGui::NextColumn();
+    ImGui::TextUnformatted("G / A / Sv / Sh"); ImGui::NextColumn();
+    ImGui::TextUnformatted("MVP"); ImGui::NextColumn();
+    ImGui::Separator();
+
+    ImGuiListClipper clipper(static_cast<int>(count));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            MatchIndexEntry entry;
+            if (!matchHistory.GetNewest(historyPanelPlaylist, static_cast<size_t>(i), entry)) {
+                entry = MatchIndexEntry{};
+            }
+
+            char when[48] = "-";
+            const std::time_t t = static_cast<std::time_t>(entry.unixTime);
+            if (const std::tm* tm = std::localtime(&t)) {
+                std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M", tm);
+            }
+            char label[96];
+            snprintf(label, sizeof(label), "%s##%llu", when, static_cast<unsigned long long>(entry.offset));
+            if (ImGui::Selectable(label, historySelectedOffset == entry.offset, ImGuiSelectableFlags_SpanAllColumns)) {
+                historySelectedOffset = historySelectedOffset == entry.offset ? UINT64_MAX : entry.offset;
+            }
+            ImGui::NextColumn();
+
+            ImGui::TextUnformatted(matchHistory.PlaylistName(entry.playlistHash).c_str());
+            ImGui::NextColumn();
+
+            const bool win = (entry.flags & MatchIndexEntry::kWin) != 0;
+            ImGui::TextColored(win ? ImVec4(0.4f, 1.0f, 0.4f, 1.0f) : ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "%u - %u%s",
+                               entry.myScore, entry.oppScore, (entry.flags & MatchIndexEntry::kOvertime) ? " OT" : "");
+            ImGui::NextColumn();
+
+            if (entry.flags & MatchIndexEntry::kHasLocal) {
+                ImGui::Text("%u / %u / %u / %u", entry.goals, entry.assists, entry.saves, entry.shots);
+            } else {
+                ImGui::TextDisabled("-");
+            }
+            ImGui::NextColumn();
+
+            ImGui::TextUnformatted((entry.flags & MatchIndexEntry::kLocalMvp) ? "MVP" : "");
+            ImGui::NextColumn();
+        }
+    }
+    ImGui::Columns(1);
+    ImGui::EndChild();
+
+    if (historySelectedOffset == UINT64_MAX) {
+        ImGui::TextDisabled("Select a match to see its scoreboard");
+        return;
+    }
+    MatchIndexEntry selected;
+    selected.offset = historySelectedOffset;
+    MatchRecord record;
+    if (!matchHistory.ReadRecord(selected, record)) {
+        historySelectedOffset = UINT64_MAX;
+        return;
+    }
+    ImGui::Text("%s %d - %d %s%s  (%s)", record.myTeamName.c_str(), record.myScore, record.oppScore,
+                record.oppTeamName.c_str(), record.overtime ? " (OT)" : "", record.playlist.c_str());
+    ImGui::Columns(4, "HistoryPlayers", false);
+    for (const auto& row : record.players) {
+        const ImVec4 color = row.teamIndex == 1 ? ImVec4(1.0f, 0.7f, 0.4f, 1.0f) : ImVec4(0.5f, 0.8f, 1.0f, 1.0f);
+        ImGui::TextColored(color, "%s%s", row.name.c_str(), row.isLocal ? " (you)" : "");
+        ImGui::NextColumn();
+        ImGui::Text("%d pts", row.score);
+        ImGui::NextColumn();
+        ImGui::Text("%d / %d / %d / %d", row.goals, row.assists, row.saves, row.shots);
+        ImGui::NextColumn();
+        ImGui::TextUnformatted(row.isMVP ? "MVP" : "");
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+}
+
 // #detailed comments: RenderPrejumpPacksTab
 // Purpose: Render the Prejump Packs browser UI with filtering, sorting, and shuffle integration
 // This tab provides access to the 2,000+ training packs scraped from prejump.com
 // with direct loading and shuffle bag management capabilities.
 void SuiteSpot::RenderPrejumpPacksTab() {
+    SS_PROFILE_SCOPE("RenderPrejumpPacksTab");
+    SS_TRACE_SCOPE("render", "RenderPrejumpPacksTab");
     ImGui::Spacing();
 
     // ===== HEADER SECTION =====
@@ -881,7 +1107,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
 
     // ===== SHUFFLE BAG STATUS & CONTROLS =====
     if (ImGui::CollapsingHeader("Shuffle Bag Manager", ImGuiTreeNodeFlags_DefaultOpen)) {
-        int shufflePackCount = static_cast<int>(trainingShuffleBag.size());
+        int shufflePackCount = static_cast<int>(trainingShuffleBag.Size());
         
         if (shufflePackCount > 0) {
             ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Current Bag: %d pack%s", shufflePackCount, shufflePackCount == 1 ? "" : "s");
@@ -906,8 +1132,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
 
             ImGui::SameLine();
             if (ImGui::Button("Clear Bag")) {
-                trainingShuffleBag.clear();
-                selectedTrainingIndices.clear();
+                trainingShuffleBag.Clear();
                 SaveShuffleBag();
                 LOG("SuiteSpot: Shuffle bag cleared");
             }
@@ -920,6 +1145,20 @@ void SuiteSpot::RenderPrejumpPacksTab() {
             if (ImGui::Checkbox("Shuffle Active", &trainingShuffleEnabled)) {
                 cvarManager->getCvar("suitespot_training_shuffle").setValue(trainingShuffleEnabled);
             }
+
+            // Rotation order: every pack plays once before any repeats
+            static const char* weightingItems[] = { "Uniform", "By Likes", "By Plays", "Manual" };
+            int weighting = static_cast<int>(shuffleScheduler.GetWeightMode());
+            ImGui::SetNextItemWidth(150);
+            if (ImGui::Combo("Rotation Weighting", &weighting, weightingItems, IM_ARRAYSIZE(weightingItems))) {
+                cvarManager->getCvar("suitespot_shuffle_weighting").setValue(weighting);
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Each rotation plays every pack in the bag once, in random order.\nWeighted modes bring popular (or manually weighted, see ss_shuffle_weight) packs up earlier.");
+            }
+            ImGui::SameLine();
+            ImGui::TextDisabled("Rotation %llu: %zu/%zu played", static_cast<unsigned long long>(shuffleScheduler.GetRotationCount()),
+                shuffleScheduler.GetCursor(), shuffleScheduler.GetRotationSize());
         } else {
             ImGui::TextDisabled("Shuffle Bag: Empty");
             ImGui::TextWrapped("Add packs to your bag using the '+Shuffle' buttons in the table below to create a rotation.");
@@ -949,17 +1188,18 @@ void SuiteSpot::RenderPrejumpPacksTab() {
     static int lastSortColumn = 0;
     static bool lastSortAscending = true;
 
-    bool filtersChanged = (strcmp(prejumpSearchText, lastSearchText) != 0) ||
+    // Widget edits regenerate the query text; sort and query edits rebuild the rows
+    bool widgetsChanged = (strcmp(prejumpSearchText, lastSearchText) != 0) ||
                           (prejumpDifficultyFilter != lastDifficultyFilter) ||
                           (prejumpTagFilter != lastTagFilter) ||
-                          (prejumpMinShots != lastMinShots) ||
-                          (prejumpSortColumn != lastSortColumn) ||
+                          (prejumpMinShots != lastMinShots);
+    bool filtersChanged = (prejumpSortColumn != lastSortColumn) ||
                           (prejumpSortAscending != lastSortAscending);
 
     // Search box
     ImGui::SetNextItemWidth(300);
     if (ImGui::InputText("##search", prejumpSearchText, IM_ARRAYSIZE(prejumpSearchText))) {
-        filtersChanged = true;
+        widgetsChanged = true;
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Search by pack name, creator, or tag");
@@ -974,7 +1214,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
             bool selected = (prejumpDifficultyFilter == difficulties[i]);
             if (ImGui::Selectable(difficulties[i], selected)) {
                 prejumpDifficultyFilter = difficulties[i];
-                filtersChanged = true;
+                widgetsChanged = true;
             }
         }
         ImGui::EndCombo();
@@ -987,7 +1227,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
     ImGui::SameLine();
     ImGui::SetNextItemWidth(200);
     if (ImGui::SliderInt("Min Shots", &prejumpMinShots, 0, 50)) {
-        filtersChanged = true;
+        widgetsChanged = true;
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Minimum number of shots in pack");
@@ -1005,7 +1245,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
         std::set<std::string> uniqueTags;
         for (const auto& pack : prejumpPacks) {
             for (const auto& tag : pack.tags) {
-                uniqueTags.insert(tag);
+                uniqueTags.emplace(tag);
             }
         }
         availableTags.clear();
@@ -1023,7 +1263,7 @@ void SuiteSpot::RenderPrejumpPacksTab() {
             bool selected = (tag == displayTag);
             if (ImGui::Selectable(tag.c_str(), selected)) {
                 prejumpTagFilter = (tag == "All Tags") ? "" : tag;
-                filtersChanged = true;
+                widgetsChanged = true;
             }
         }
         ImGui::EndCombo();
@@ -1039,8 +1279,43 @@ void SuiteSpot::RenderPrejumpPacksTab() {
         prejumpTagFilter = "";
         prejumpMinShots = 0;
         prejumpMaxShots = 100;
+        widgetsChanged = true;
+    }
+
+    // Query box: the widgets write their equivalent query here, and typing
+    // directly unlocks OR, negation and ranges the widgets cannot express
+    if (widgetsChanged) {
+        const std::string generated = BuildPackQuery(prejumpSearchText, prejumpDifficultyFilter, prejumpTagFilter, prejumpMinShots);
+        strncpy_s(prejumpQueryText, generated.c_str(), sizeof(prejumpQueryText) - 1);
+
+        strncpy_s(lastSearchText, prejumpSearchText, sizeof(lastSearchText) - 1);
+        lastDifficultyFilter = prejumpDifficultyFilter;
+        lastTagFilter = prejumpTagFilter;
+        lastMinShots = prejumpMinShots;
+    }
+
+    ImGui::SetNextItemWidth(600);
+    ImGui::InputText("Query", prejumpQueryText, IM_ARRAYSIZE(prejumpQueryText));
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Terms are ANDed; use OR and ( ) to group, '-' to exclude.\n"
+                          "  wall  \"air roll\"  name:reset  creator:wayprotein\n"
+                          "  tag:aerial  -tag:ground  diff:gold..champion  diff>=plat\n"
+                          "  shots>=10  likes>100  plays:1000..5000  code:XXXX-XXXX-XXXX-XXXX\n"
+                          "Changing the widgets above replaces the query.");
+    }
+
+    // Compile only when the text changes; the cache also serves repeated queries
+    static char lastQueryText[512] = {0};
+    static std::shared_ptr<const PackQuery> activeQuery;
+    if (!activeQuery || strcmp(prejumpQueryText, lastQueryText) != 0) {
+        activeQuery = prejumpQueryCache.Get(prejumpQueryText);
+        strncpy_s(lastQueryText, prejumpQueryText, sizeof(lastQueryText) - 1);
         filtersChanged = true;
     }
+    if (!activeQuery->IsValid()) {
+        // Keep showing the last good result while the query is being typed
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Query error: %s", activeQuery->GetError().c_str());
+    }
 
     ImGui::Spacing();
     ImGui::Separator();
@@ -1048,104 +1323,43 @@ void SuiteSpot::RenderPrejumpPacksTab() {
 
     // ===== FILTERED & SORTED PACK LIST (cached) =====
 
-    // Static cache for filtered/sorted results
-    static std::vector<TrainingEntry> filteredPacks;
+    // Cached row indices into prejumpPacks; rebuilt only when the filters
+    // or the catalog itself change (never copies pack data)
+    static std::vector<int> filteredRows;
+    static unsigned int lastCatalogVersion = 0;
+    if (lastCatalogVersion != prejumpCatalogVersion) {
+        // The rows index the old catalog. Drop them now: the rebuild below
+        // is skipped while the query is invalid, and a smaller catalog
+        // would make them read out of bounds.
+        filteredRows.clear();
+        lastCatalogVersion = prejumpCatalogVersion;
+        filtersChanged = true;
+    }
 
     // Rebuild filtered list only when needed
-    if (filtersChanged) {
-        filteredPacks.clear();
-
-        // Convert search text to lowercase once
-        std::string searchLower(prejumpSearchText);
-        std::transform(searchLower.begin(), searchLower.end(), searchLower.begin(), ::tolower);
-
-        for (const auto& pack : prejumpPacks) {
-            // Skip if doesn't match search
-            if (searchLower.length() > 0) {
-                std::string nameLower = pack.name;
-                std::string creatorLower = pack.creator;
-                std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(), ::tolower);
-                std::transform(creatorLower.begin(), creatorLower.end(), creatorLower.begin(), ::tolower);
-
-                bool matchesSearch = false;
-                if (nameLower.find(searchLower) != std::string::npos) matchesSearch = true;
-                if (creatorLower.find(searchLower) != std::string::npos) matchesSearch = true;
-
-                // Check tags
-                for (const auto& tag : pack.tags) {
-                    std::string tagLower = tag;
-                    std::transform(tagLower.begin(), tagLower.end(), tagLower.begin(), ::tolower);
-                    if (tagLower.find(searchLower) != std::string::npos) {
-                        matchesSearch = true;
-                        break;
-                    }
-                }
-
-                if (!matchesSearch) continue;
-            }
-
-            // Skip if doesn't match difficulty filter
-            if (prejumpDifficultyFilter != "All" && pack.difficulty != prejumpDifficultyFilter) {
-                continue;
-            }
-
-            // Skip if doesn't match tag filter
-            if (!prejumpTagFilter.empty()) {
-                bool hasTag = false;
-                for (const auto& tag : pack.tags) {
-                    if (tag == prejumpTagFilter) {
-                        hasTag = true;
-                        break;
-                    }
-                }
-                if (!hasTag) continue;
-            }
-
-            // Skip if doesn't match shot count filter
-            if (pack.shotCount < prejumpMinShots) {
-                continue;
-            }
-
-            filteredPacks.push_back(pack);
+    // (a catalog reload re-runs the already compiled query; nothing is re-parsed)
+    if (filtersChanged && prejumpFilterEngine && activeQuery->IsValid()) {
+        SS_TRACE_SCOPE("catalog", "FilterRebuild");
+        PackFilterCriteria criteria;
+        criteria.query = activeQuery;
+        criteria.sortColumn = prejumpSortColumn;
+        criteria.sortAscending = prejumpSortAscending;
+        try {
+            filteredRows = prejumpFilterEngine->Run(prejumpPacks, criteria);
+        } catch (const std::exception& e) {
+            // Partial results are not shown as if they were complete
+            filteredRows.clear();
+            ERRORLOG("SuiteSpot: Prejump filter failed: {}", e.what());
         }
-
-        // Sort the filtered packs
-        std::sort(filteredPacks.begin(), filteredPacks.end(), [this](const TrainingEntry& a, const TrainingEntry& b) {
-            int cmp = 0;
-            switch (prejumpSortColumn) {
-                case 0: // Name
-                    cmp = a.name.compare(b.name);
-                    break;
-                case 1: // Creator
-                    cmp = a.creator.compare(b.creator);
-                    break;
-                case 2: // Difficulty
-                    cmp = a.difficulty.compare(b.difficulty);
-                    break;
-                case 3: // Shots
-                    cmp = (a.shotCount < b.shotCount) ? -1 : (a.shotCount > b.shotCount) ? 1 : 0;
-                    break;
-                case 4: // Likes
-                    cmp = (a.likes < b.likes) ? -1 : (a.likes > b.likes) ? 1 : 0;
-                    break;
-                case 5: // Plays
-                    cmp = (a.plays < b.plays) ? -1 : (a.plays > b.plays) ? 1 : 0;
-                    break;
-            }
-            return prejumpSortAscending ? (cmp < 0) : (cmp > 0);
-        });
+        SS_TRACE_COUNTER("catalog", "FilteredRows", filteredRows.size());
 
         // Update cached filter state
-        strncpy_s(lastSearchText, prejumpSearchText, sizeof(lastSearchText) - 1);
-        lastDifficultyFilter = prejumpDifficultyFilter;
-        lastTagFilter = prejumpTagFilter;
-        lastMinShots = prejumpMinShots;
         lastSortColumn = prejumpSortColumn;
         lastSortAscending = prejumpSortAscending;
     }
 
     // Display filtered count
-    ImGui::Text("Showing %d of %d packs", (int)filteredPacks.size(), prejumpPackCount);
+    ImGui::Text("Showing %d of %d packs", (int)filteredRows.size(), prejumpPackCount);
     ImGui::Spacing();
 
     // ===== TABLE WITH RESIZABLE COLUMNS (ImGui 1.75 Columns API) =====
@@ -1191,13 +1405,13 @@ void SuiteSpot::RenderPrejumpPacksTab() {
     ImGui::NextColumn();
 
     // Likes column header
-    if (SortableColumnHeader("Likes", 5, prejumpSortColumn, prejumpSortAscending)) {
+    if (SortableColumnHeader("Likes", 4, prejumpSortColumn, prejumpSortAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
 
     // Plays column header
-    if (SortableColumnHeader("Plays", 6, prejumpSortColumn, prejumpSortAscending)) {
+    if (SortableColumnHeader("Plays", 5, prejumpSortColumn, prejumpSortAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
@@ -1209,8 +1423,8 @@ void SuiteSpot::RenderPrejumpPacksTab() {
     ImGui::Separator();
 
     // ===== RENDER PACK ROWS =====
-    for (size_t row = 0; row < filteredPacks.size(); row++) {
-        const auto& pack = filteredPacks[row];
+    for (size_t row = 0; row < filteredRows.size(); row++) {
+        const auto& pack = prejumpPacks[filteredRows[row]];
 
         // Name column
         ImGui::TextUnformatted(pack.name.c_str());
@@ -1291,11 +1505,13 @@ void SuiteSpot::RenderPrejumpPacksTab() {
         std::string loadLabel = "Load##" + std::to_string(row);
         if (ImGui::SmallButton(loadLabel.c_str())) {
             // Directly load the training pack
-            gameWrapper->SetTimeout([this, pack](GameWrapper* gw) {
-                std::string cmd = "load_training " + pack.code;
+            std::string packCode(pack.code);
+            std::string packName(pack.name);
+            timerWheel.Schedule(std::chrono::milliseconds(0), [this, packCode, packName]() {
+                std::string cmd = "load_training " + packCode;
                 cvarManager->executeCommand(cmd);
-                LOG("SuiteSpot: Loading prejump pack: " + pack.name);
-            }, 0.0f);
+                LOG("SuiteSpot: Loading prejump pack: " + packName);
+            }, kMapLoadTimerKey);
         }
         if (ImGui::IsItemHovered()) {
             ImGui::SetTooltip("Load this pack now");
@@ -1306,9 +1522,8 @@ void SuiteSpot::RenderPrejumpPacksTab() {
         // Add to Shuffle button with visual feedback
         std::string shuffleLabel = "+Shuffle##" + std::to_string(row);
 
-        // Check if pack already in shuffle bag
-        bool inShuffleBag = std::find_if(trainingShuffleBag.begin(), trainingShuffleBag.end(),
-            [&pack](const TrainingEntry& e) { return e.code == pack.code; }) != trainingShuffleBag.end();
+        // Check if pack already in shuffle bag (one bit test per row)
+        bool inShuffleBag = trainingShuffleBag.ContainsRow(TrainingCodeSource::Prejump, filteredRows[row]);
 
         if (inShuffleBag) {
             ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.6f, 0.2f, 1.0f));
@@ -1317,16 +1532,16 @@ void SuiteSpot::RenderPrejumpPacksTab() {
         if (ImGui::SmallButton(shuffleLabel.c_str())) {
             if (!inShuffleBag) {
                 // Add to shuffle bag
-                trainingShuffleBag.push_back(pack);
+                if (const auto code = TrainingCode::Parse(pack.code)) {
+                    trainingShuffleBag.Add(*code, pack.name);
+                }
                 SaveShuffleBag();
                 LOG("SuiteSpot: Added to shuffle: " + pack.name);
             } else {
                 // Remove from shuffle bag
-                trainingShuffleBag.erase(
-                    std::remove_if(trainingShuffleBag.begin(), trainingShuffleBag.end(),
-                        [&pack](const TrainingEntry& e) { return e.code == pack.code; }),
-                    trainingShuffleBag.end()
-                );
+                if (const auto code = TrainingCode::Parse(pack.code)) {
+                    trainingShuffleBag.Remove(*code);
+                }
                 SaveShuffleBag();
                 LOG("SuiteSpot: Removed from shuffle: " + pack.name);
             }
@@ -1374,35 +1589,119 @@ void SuiteSpot::RenderWindow() {
     ImGui::Separator();
     ImGui::TextUnformatted("Post-Match Statistics:");
     
-    if (postMatch.active) {
+    const PostMatchInfo& postMatch = postMatchBuffer.Read();
+    const bool overlayActive = postMatch.active &&
+        std::chrono::duration<float>(std::chrono::steady_clock::now() - postMatch.start).count() < postMatchDurationSec;
+    if (overlayActive) {
         ImGui::Text("Overlay is currently ACTIVE");
     } else {
         ImGui::Text("Overlay is currently INACTIVE");
     }
 
     if (ImGui::Button("Trigger Test Overlay")) {
-        // Mock some data if empty
-        if (postMatch.players.empty()) {
-            postMatch.myTeamName = "Blue Team";
-            postMatch.oppTeamName = "Orange Team";
-            postMatch.myScore = 3;
-            postMatch.oppScore = 2;
-            postMatch.playlist = "Competitive Doubles";
-            postMatch.overtime = false;
-            
-            PostMatchPlayerRow p1; p1.name = "LocalPlayer"; p1.score = 650; p1.goals = 2; p1.isLocal = true; p1.teamIndex = 0; p1.isMVP = true;
-            PostMatchPlayerRow p2; p2.name = "Teammate"; p2.score = 400; p2.goals = 1; p2.isLocal = false; p2.teamIndex = 0;
-            PostMatchPlayerRow p3; p3.name = "Opponent 1"; p3.score = 500; p3.goals = 1; p3.isLocal = false; p3.teamIndex = 1; p3.isMVP = true;
-            PostMatchPlayerRow p4; p4.name = "Opponent 2"; p4.score = 300; p4.goals = 1; p4.isLocal = false; p4.teamIndex = 1;
-            
-            postMatch.players = { p1, p2, p3, p4 };
-        }
-        
-        postMatch.start = std::chrono::steady_clock::now();
-        postMatch.active = true;
+        // The snapshot buffer is written on the game thread only
+        gameWrapper->Execute([this](GameWrapper* gw) { ToggleTestOverlay(); });
     }
     
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Show the post-match stats overlay for testing");
     }
 }
+
+// #detailed comments: RenderProfilerWindow
+// Purpose: The ss_profiler window. The table is each marker's rolling
+// p50/p99 from Profiler::Stats; the plot is the plugin's top-level time on
+// the render thread per frame, so a spike there points at a row below.
+// The frame view replays the last complete frame on the vendored timeline
+// widget, one row per scope, indented by nesting depth. The widget lets
+// bars be dragged, so it only ever gets copies of the times.
+void SuiteSpot::RenderProfilerWindow() {
+    if (profilerWindowToggle.exchange(false)) {
+        profilerWindowOpen = !profilerWindowOpen;
+    }
+    if (!profilerWindowOpen) return;
+
+    ImGui::SetNextWindowSize(ImVec2(640, 560), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("SuiteSpot Profiler", &profilerWindowOpen)) {
+        ImGui::End();
+        return;
+    }
+
+#if SUITESPOT_PROFILING
+    Profiler& profiler = Profiler::Get();
+    bool recording = profiler.Enabled();
+    if (ImGui::Checkbox("Record", &recording)) {
+        profiler.SetEnabled(recording);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset##profiler")) {
+        profiler.Reset();
+    }
+
+    const std::vector<float> frameCost = profiler.FrameCostHistory();
+    if (!frameCost.empty()) {
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "last %.2f ms, max %.2f ms", frameCost.back(),
+                 *std::max_element(frameCost.begin(), frameCost.end()));
+        ImGui::PlotLines("##profilerframecost", frameCost.data(), static_cast<int>(frameCost.size()), 0, overlay,
+                         0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+    }
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Plugin time per frame on the render thread (top-level markers)");
+    ImGui::Separator();
+
+    // Allocation columns: per frame, inclusive of nested markers
+    constexpr bool showAllocs = AllocTrackingEnabled();
+    ImGui::Columns(showAllocs ? 8 : 6, "ProfilerColumns", true);
+    ImGui::TextUnformatted("Marker"); ImGui::NextColumn();
+    ImGui::TextUnformatted("Calls"); ImGui::NextColumn();
+    ImGui::TextUnformatted("Last frame"); ImGui::NextColumn();
+    ImGui::TextUnformatted("p50"); ImGui::NextColumn();
+    ImGui::TextUnformatted("p99"); ImGui::NextColumn();
+    ImGui::TextUnformatted("Max"); ImGui::NextColumn();
+    if (showAllocs) {
+        ImGui::TextUnformatted("Allocs/frame"); ImGui::NextColumn();
+        ImGui::TextUnformatted("Peak"); ImGui::NextColumn();
+    }
+    ImGui::Separator();
+    for (const auto& site : profiler.Stats()) {
+        ImGui::TextUnformatted(site.name.c_str()); ImGui::NextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(site.calls)); ImGui::NextColumn();
+        ImGui::Text("%ux %.1f us", site.callsLastFrame, site.lastFrameUs); ImGui::NextColumn();
+        ImGui::Text("%.1f us", site.p50Us); ImGui::NextColumn();
+        ImGui::Text("%.1f us", site.p99Us); ImGui::NextColumn();
+        ImGui::Text("%.1f us", site.maxUs); ImGui::NextColumn();
+        if (showAllocs) {
+            ImGui::Text("%llu (%.1f KB)", static_cast<unsigned long long>(site.allocsLastFrame), site.bytesLastFrame / 1024.0); ImGui::NextColumn();
+            ImGui::Text("%llu (%.1f KB)", static_cast<unsigned long long>(site.peakAllocsPerFrame), site.peakBytesPerFrame / 1024.0); ImGui::NextColumn();
+        }
+    }
+    ImGui::Columns(1);
+    if (!showAllocs) {
+        ImGui::TextDisabled("Allocation counts need SUITESPOT_ALLOC_TRACKING=1");
+    }
+    ImGui::Separator();
+
+    // Game-thread scopes that began before the frame are clamped to its start
+    constexpr size_t kMaxFrameRows = 64;
+    const auto& frame = profiler.LastFrame();
+    const int64_t frameStart = profiler.LastFrameStartNs();
+    const float frameMs = std::max(0.001f, (profiler.LastFrameEndNs() - frameStart) / 1e6f);
+    ImGui::Text("Last frame: %.2f ms, %zu scopes", frameMs, frame.size());
+    ImGui::BeginTimeline("##profilerframe", frameMs);
+    for (size_t i = 0; i < frame.size() && i < kMaxFrameRows; ++i) {
+        const ProfileEvent& event = frame[i];
+        float times[2];
+        times[0] = std::clamp((event.startNs - frameStart) / 1e6f, 0.0f, frameMs);
+        times[1] = std::clamp((event.startNs + event.durationNs - frameStart) / 1e6f, times[0], frameMs);
+        char label[96];
+        snprintf(label, sizeof(label), "%*s%s##%zu", static_cast<int>(event.depth) * 2, "",
+                 profiler.SiteName(event.site).c_str(), i);
+        ImGui::TimelineEvent(label, times);
+    }
+    ImGui::EndTimeline();
+#else
+    ImGui::TextDisabled("Built without profiling markers (rebuild with SUITESPOT_PROFILING=1)");
+#endif
+
+    ImGui::End();
+}
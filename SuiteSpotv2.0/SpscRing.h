@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// SpscRing: Lock-free single-writer ring that readers copy from
+//
+// Purpose: A fixed-capacity history of the last Capacity values. The
+// writer never blocks, never allocates and never waits for readers; once
+// full, each Push overwrites the oldest value. Items are numbered by how
+// many were pushed before them, so a reader can ask for "items [first,
+// end)" and tell which of them are gone.
+//
+// Torn copies: a reader may copy a slot while the writer overwrites it.
+// Push announces the index it is about to write (writing_) before
+// touching the slot, and Copy re-reads that announcement after copying,
+// seqlock style; any item the writer may have reached is dropped from the
+// result. T must be trivially copyable for that copy to be harmless.
+//
+// Rules:
+// - Exactly one writer thread (Push). Any number of reader threads (Copy).
+//
+// Usage Example:
+//   // game thread
+//   ring.Push(sample);
+//   // render thread
+//   std::array<Sample, 64> out;
+//   const uint64_t end = ring.Written();
+//   size_t n = ring.Copy(end > 64 ? end - 64 : 0, end, out.data());
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(std::is_trivially_copyable_v<T>, "readers copy slots the writer may be overwriting");
+    static_assert(Capacity > 0);
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Writer
+    void Push(const T& value)
+    {
+        const uint64_t n = written_.load(std::memory_order_relaxed);
+        writing_.store(n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slots_[n % Capacity], &value, sizeof(T));
+        written_.store(n + 1, std::memory_order_release);
+    }
+
+    // Number of items ever pushed; the next item's index
+    uint64_t Written() const { return written_.load(std::memory_order_acquire); }
+
+    // Copies the intact items of [first, end) to out, oldest first, and
+    // returns how many were copied; *firstCopied gets the index of out[0].
+    // end must not exceed Written(). Overwritten items are skipped, so the
+    // result is the newest part of the range.
+    size_t Copy(uint64_t first, uint64_t end, T* out, uint64_t* firstCopied = nullptr) const
+    {
+        if (end > Capacity) first = std::max(first, end - Capacity);
+        if (first >= end) {
+            if (firstCopied) *firstCopied = end;
+            return 0;
+        }
+        for (uint64_t i = first; i < end; ++i) {
+            std::memcpy(&out[i - first], &slots_[i % Capacity], sizeof(T));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // The writer may be inside any Push up to writing_, each of which
+        // overwrites the item Capacity before it
+        const uint64_t writing = writing_.load(std::memory_order_relaxed);
+        const uint64_t minValid = writing > Capacity ? writing - Capacity : 0;
+        size_t count = static_cast<size_t>(end - first);
+        if (first < minValid) {
+            const size_t dropped = static_cast<size_t>(std::min<uint64_t>(minValid - first, count));
+            std::memmove(out, out + dropped, (count - dropped) * sizeof(T));
+            count -= dropped;
+            first += dropped;
+        }
+        if (firstCopied) *firstCopied = first;
+        return count;
+    }
+
+private:
+    std::array<T, Capacity> slots_{};
+    std::atomic<uint64_t> written_{ 0 };   // Items fully written
+    std::atomic<uint64_t> writing_{ 0 };   // Items the writer has started
+};
@@ -1,6 +1,9 @@
 #include "pch.h"
 #include "SuiteSpot.h"
 #include "MapList.h"
+#include "Benchmark.h"
+#include "CatalogIO.h"
+#include "IMGUI/imguivariouscontrols.h"
 #include <fstream>
 #include <string>
 #include <algorithm>
@@ -11,6 +14,9 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <climits>
+#include <iterator>
+#include <ctime>
 
 // #detailed comments: INTERNAL HELPERS NAMESPACE
 // The functions declared in this unnamed namespace are intentionally
@@ -18,8 +24,9 @@
 // (SuiteSpot.cpp). Keeping these helpers local avoids accidental
 // dependencies from other compilation units and simplifies reasoning
 // about side-effects. They are small, focused utilities used by the
-// SuiteSpot class implementation below (string trimming, case-insensitive
-// compares, env expansion, etc.).
+// SuiteSpot class implementation below (string trimming, quoting, env
+// expansion, etc.). The catalog file parsers and their helpers live in
+// CatalogIO.cpp so they can be built without the plugin.
 //
 // INVARIANT: These helpers must not be promoted to public API because
 // other code assumes SuiteSpot's public interface remains the single
@@ -101,57 +108,6 @@ namespace
         return expanded;
     }
 
-    int CaseInsensitiveCompare(const std::string& a, const std::string& b)
-    {
-        const size_t len = std::min(a.size(), b.size());
-        for (size_t i = 0; i < len; ++i)
-        {
-            const unsigned char ca = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(a[i])));
-            const unsigned char cb = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(b[i])));
-            if (ca < cb) return -1;
-            if (ca > cb) return 1;
-        }
-
-        if (a.size() < b.size()) return -1;
-        if (a.size() > b.size()) return 1;
-        return 0;
-    }
-
-    bool StartsWithCaseInsensitive(const std::string& value, const std::string& prefix)
-    {
-        if (value.size() < prefix.size()) return false;
-        for (size_t i = 0; i < prefix.size(); ++i)
-        {
-            if (std::tolower(static_cast<unsigned char>(value[i])) != std::tolower(static_cast<unsigned char>(prefix[i])))
-            {
-                return false;
-            }
-        }
-        return true;
-    }
-
-int ParseTrailingShots(const std::string& nameField)
-{
-        // Legacy format: "Name (#)" or "Name( # )"
-        const auto openPos = nameField.find_last_of('(');
-        const auto closePos = nameField.find_last_of(')');
-        if (openPos == std::string::npos || closePos == std::string::npos || closePos <= openPos) {
-            return 0;
-        }
-        std::string inside = Trim(nameField.substr(openPos + 1, closePos - openPos - 1));
-        // Expect something like "12" or "Shots:12" but in legacy it was just number.
-        if (StartsWithCaseInsensitive(inside, "shots")) {
-            auto colonPos = inside.find(':');
-            if (colonPos != std::string::npos) {
-                inside = Trim(inside.substr(colonPos + 1));
-            }
-        }
-        try {
-            return std::max(0, std::stoi(inside));
-        } catch (...) {
-            return 0;
-        }
-    }
 }
 
 
@@ -164,6 +120,11 @@ std::filesystem::path SuiteSpot::GetDataRoot() const {
 std::filesystem::path SuiteSpot::GetSuiteTrainingDir() const { return GetDataRoot() / "SuiteTraining"; }
 std::filesystem::path SuiteSpot::GetTrainingFilePath() const { return GetSuiteTrainingDir() / "SuiteSpotTrainingMaps.txt"; }
 std::filesystem::path SuiteSpot::GetShuffleBagPath() const { return GetSuiteTrainingDir() / "SuiteShuffleBag.txt"; }
+std::filesystem::path SuiteSpot::GetShuffleStatePath() const { return GetSuiteTrainingDir() / "SuiteShuffleState.txt"; }
+std::filesystem::path SuiteSpot::GetAdaptiveDelaysPath() const { return GetSuiteTrainingDir() / "SuiteAdaptiveDelays.txt"; }
+std::filesystem::path SuiteSpot::GetMatchHistoryPath() const { return GetSuiteTrainingDir() / "SuiteMatchHistory.log"; }
+std::filesystem::path SuiteSpot::GetLogFilePath() const { return GetSuiteTrainingDir() / "SuiteSpot.log"; }
+std::filesystem::path SuiteSpot::GetTraceFilePath() const { return GetSuiteTrainingDir() / "SuiteSpot.trace.json"; }
 void SuiteSpot::EnsureDataDirectories() const {
     std::error_code ec;
     auto root = GetDataRoot();
@@ -173,26 +134,61 @@ void SuiteSpot::EnsureDataDirectories() const {
 
 
 
-int SuiteSpot::GetRandomTrainingIndex() const {
-    if (trainingShuffleBag.empty()) {
+int SuiteSpot::GetRandomTrainingIndex() {
+    const auto code = NextShufflePack();
+    if (!code) {
         return 0;
     }
     
-    static std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(trainingShuffleBag.size()) - 1);
-    int bagIndex = dist(rng);
-    
-    // Attempt to find in RLTraining (local packs)
-    auto it = std::find_if(RLTraining.begin(), RLTraining.end(),
-        [&](const TrainingEntry& e) { return e.code == trainingShuffleBag[bagIndex].code; });
-    
-    if (it != RLTraining.end()) {
-        return static_cast<int>(std::distance(RLTraining.begin(), it));
+    // Index of the pack in RLTraining (local packs). If it is not there it
+    // might be a Prejump pack; the GameEndedEvent will handle loading by
+    // code if we can't find an index.
+    return trainingCodeIndex.IndexOf(TrainingCodeSource::Training, *code);
+}
+
+// A draw only moves the cursor; the rotation file is rewritten once for
+// every draw in the next few seconds, and on unload
+std::optional<TrainingCode> SuiteSpot::NextShufflePack() {
+    const auto code = shuffleScheduler.Next(trainingShuffleBag, [this](TrainingCode c) { return FindTrainingEntry(c); });
+    if (code && !shuffleStateDirty) {
+        shuffleStateDirty = true;
+        timerWheel.Schedule(std::chrono::seconds(5), [this]() { FlushShuffleState(); });
+    }
+    return code;
+}
+
+const TrainingEntry* SuiteSpot::FindTrainingEntry(TrainingCode code) const {
+    const auto* location = trainingCodeIndex.Find(code);
+    if (!location) return nullptr;
+    if (location->Get(TrainingCodeSource::Training) >= 0) return &RLTraining[location->Get(TrainingCodeSource::Training)];
+    if (location->Get(TrainingCodeSource::Prejump) >= 0) return &prejumpPacks[location->Get(TrainingCodeSource::Prejump)];
+    return nullptr;
+}
+
+// #detailed comments: ReindexTrainingCodes
+// Purpose: Keep trainingCodeIndex and the shuffle bag's row bits in step
+// with the catalog vectors. Must be called whenever RLTraining or
+// prejumpPacks is reloaded, re-sorted or edited, since both store row
+// numbers. Duplicate codes within a catalog are logged here once per load.
+void SuiteSpot::ReindexTrainingCodes(TrainingCodeSource source) {
+    const std::vector<TrainingEntry>* rows = nullptr;
+    const char* label = "";
+    switch (source) {
+        case TrainingCodeSource::Training: rows = &RLTraining; label = "training list"; break;
+        case TrainingCodeSource::Prejump: rows = &prejumpPacks; label = "Prejump catalog"; break;
+        default: return;
+    }
+
+    const TrainingCodeIndexReport report = trainingCodeIndex.Reindex(source, *rows);
+    trainingShuffleBag.RebindRows(source, rows->size());
+    if (report.duplicates > 0 || report.invalid > 0) {
+        LOG("SuiteSpot: " + std::string(label) + " has " + std::to_string(report.duplicates) +
+            " duplicate and " + std::to_string(report.invalid) + " invalid pack code(s); first occurrence kept");
+    }
+    if (report.shared > 0) {
+        LOG("SuiteSpot: " + std::to_string(report.shared) + " pack(s) in the " + std::string(label) +
+            " also appear in another catalog");
     }
-    
-    // If not in RLTraining, it might be a Prejump pack. 
-    // The GameEndedEvent will handle loading by code if we can't find an index.
-    return -1; 
 }
 
 // #detailed comments: LoadTrainingMaps
@@ -202,19 +198,14 @@ int SuiteSpot::GetRandomTrainingIndex() const {
 // trailing "(N)" shot counts) while normalizing into the modern CSV
 // form: code,name,Shots:N.
 //
-// Important parsing invariants:
-//  - Lines are split on commas but whitespace is trimmed from parts.
-//  - If only two parts exist, ParseTrailingShots attempts to extract a
-//    trailing shot count from the name in parentheses and strips it.
-//  - Errors or malformed lines are skipped silently: this avoids
-//    throwing during startup due to a single malformed line in the file.
-//
-// DO NOT CHANGE: The sort order is case-insensitive; changing the
-// comparator could alter user-visible ordering of maps in the UI.
+// Parsing and the case-insensitive sort are ReadTrainingMaps (CatalogIO);
+// malformed lines are skipped, listed at debug level and summarized once.
 void SuiteSpot::LoadTrainingMaps() {
+    SS_TRACE_SCOPE("catalog", "LoadTrainingMaps");
     EnsureDataDirectories();
     EnsureReadmeFiles();
     RLTraining.clear();
+    ReindexTrainingCodes(TrainingCodeSource::Training);
     auto f = GetTrainingFilePath();
     std::error_code ec;
     
@@ -227,87 +218,16 @@ void SuiteSpot::LoadTrainingMaps() {
         return;
     }
 
-    std::string line;
-    bool sawLegacyFormat = false;
-    int lineNum = 0;
-
-    while (std::getline(in, line)) {
-        lineNum++;
-        if (line.empty()) continue;
-
-        // Expected format: code, Name, Shots:#  (shots optional for backward compatibility)
-        std::vector<std::string> parts;
-        size_t start = 0;
-        while (start <= line.size())
-        {
-            const auto commaPos = line.find(',', start);
-            if (commaPos == std::string::npos)
-            {
-                parts.push_back(Trim(line.substr(start)));
-                break;
-            }
-            parts.push_back(Trim(line.substr(start, commaPos - start)));
-            start = commaPos + 1;
-        }
-
-        if (parts.size() < 2) {
-            LOG("SuiteSpot: Malformed entry on line {}: '{}' - expected 'code,name'", lineNum, line);
-            continue; 
-        }
-
-        std::string code = parts[0];
-        std::string name = parts[1];
-        int shots = 0;
-        
-        // Legacy: shots embedded in name "(#)" when only 2 parts existed.
-        if (parts.size() == 2) {
-            shots = ParseTrailingShots(name);
-            if (shots > 0) {
-                sawLegacyFormat = true;
-            }
-            // strip trailing "(#)" from name if present
-            const auto openPos = name.find_last_of('(');
-            const auto closePos = name.find_last_of(')');
-            if (openPos != std::string::npos && closePos != std::string::npos && closePos > openPos) {
-                name = Trim(name.substr(0, openPos));
-            }
-        }
-        
-        if (parts.size() >= 3) {
-            std::string shotsPart = parts[2];
-            if (StartsWithCaseInsensitive(shotsPart, "shots:")) {
-                auto valStr = Trim(shotsPart.substr(6));
-                try {
-                    shots = std::stoi(valStr);
-                } catch (const std::invalid_argument&) {
-                    LOG("SuiteSpot: Invalid shot count on line {}: '{}'", lineNum, valStr);
-                    shots = 0;
-                } catch (const std::out_of_range&) {
-                    LOG("SuiteSpot: Shot count out of range on line {}: '{}'", lineNum, valStr);
-                    shots = 0;
-                } catch (...) {
-                    LOG("SuiteSpot: Unknown error parsing shots on line {}", lineNum);
-                    shots = 0;
-                }
-            }
-        }
+    const CatalogReadReport report = ReadTrainingMaps(in, RLTraining);
+    ReindexTrainingCodes(TrainingCodeSource::Training);
 
-        if (!code.empty() && !name.empty()) {
-            TrainingEntry entry;
-            entry.code = code;
-            entry.name = name;
-            entry.shotCount = shots;
-            RLTraining.push_back(entry);
-        } else {
-             LOG("SuiteSpot: Empty code or name on line {}", lineNum);
-        }
+    // Per-line details go to DEBUGLOG; one summary at warn
+    for (const auto& problem : report.problems) {
+        DEBUGLOG("SuiteSpot: {}: {}", f.string(), problem);
+    }
+    if (report.skipped > 0) {
+        WARNLOG("SuiteSpot: Skipped {} malformed line(s) in {} (suitespot_log_level 1 lists them)", report.skipped, f.string());
     }
-
-    std::sort(RLTraining.begin(), RLTraining.end(),
-        [](const TrainingEntry& lhs, const TrainingEntry& rhs)
-        {
-            return CaseInsensitiveCompare(lhs.name, rhs.name) < 0;
-        });
 
     if (RLTraining.empty())
     {
@@ -319,7 +239,7 @@ void SuiteSpot::LoadTrainingMaps() {
     }
 
     // If we saw legacy entries, rewrite file in new format so future loads are clean.
-    if (sawLegacyFormat) {
+    if (report.sawLegacyFormat) {
         LOG("SuiteSpot: Upgrading legacy training file format...");
         SaveTrainingMaps();
     }
@@ -334,56 +254,206 @@ void SuiteSpot::LoadTrainingMaps() {
 // DO NOT CHANGE: The output format is intentionally kept stable since
 // downstream tooling and user scripts depend on the exact CSV layout.
 void SuiteSpot::SaveTrainingMaps() const {
+    SS_TRACE_SCOPE("io", "SaveTrainingMaps");
     auto f = GetTrainingFilePath();
     EnsureDataDirectories();
     EnsureReadmeFiles();
     std::ofstream out(f.string(), std::ios::trunc);
     if (!out.is_open()) return;
-    auto sorted = RLTraining;
-    std::sort(sorted.begin(), sorted.end(),
-        [](const TrainingEntry& lhs, const TrainingEntry& rhs)
-        {
-            return CaseInsensitiveCompare(lhs.name, rhs.name) < 0;
-        });
-    for (const auto& e : sorted) {
-        out << e.code << "," << e.name << ",Shots:" << e.shotCount << "\n";
-    }
+    WriteTrainingMaps(out, RLTraining);
 }
 
 void SuiteSpot::LoadShuffleBag() {
-    trainingShuffleBag.clear();
-    selectedTrainingIndices.clear();
+    SS_TRACE_SCOPE("catalog", "LoadShuffleBag");
+    trainingShuffleBag.Clear();
     auto f = GetShuffleBagPath();
     std::error_code ec;
     if (!std::filesystem::exists(f, ec)) return;
     std::ifstream in(f.string());
     if (!in.is_open()) return;
-    std::string line;
-    while (std::getline(in, line)) {
-        if (line.empty()) continue;
-        auto pos = line.find(',');
-        if (pos == std::string::npos) continue;
-        std::string code = Trim(line.substr(0, pos));
-        std::string name = Trim(line.substr(pos + 1));
-        if (!code.empty() && !name.empty()) {
-            trainingShuffleBag.push_back({ code, name });
-            auto it = std::find_if(RLTraining.begin(), RLTraining.end(),
-                [&](const TrainingEntry& e) { return e.code == code; });
-            if (it != RLTraining.end()) {
-                selectedTrainingIndices.insert(static_cast<int>(std::distance(RLTraining.begin(), it)));
-            }
+    ReadShuffleBag(in, trainingShuffleBag);
+}
+
+// #detailed comments: LoadShuffleState
+// Purpose: Restore the shuffle rotation (order, cursor, weighting, manual
+// weights) saved next to the bag, so a restart continues the rotation
+// instead of starting a new one. Must run after LoadShuffleBag; packs that
+// left the bag while the game was closed are skipped on draw.
+void SuiteSpot::LoadShuffleState() {
+    auto f = GetShuffleStatePath();
+    std::error_code ec;
+    if (!std::filesystem::exists(f, ec)) return;
+    std::ifstream in(f.string());
+    if (!in.is_open()) return;
+    if (!shuffleScheduler.Deserialize(in)) {
+        LOG("SuiteSpot: Ignoring unreadable shuffle state: " + f.string());
+        return;
+    }
+    LOG("SuiteSpot: Resumed shuffle rotation {} at {}/{}", shuffleScheduler.GetRotationCount(),
+        shuffleScheduler.GetCursor(), shuffleScheduler.GetRotationSize());
+}
+
+void SuiteSpot::SaveShuffleState() const {
+    SS_TRACE_SCOPE("io", "SaveShuffleState");
+    auto f = GetShuffleStatePath();
+    EnsureDataDirectories();
+    std::ofstream out(f.string(), std::ios::trunc);
+    if (!out.is_open()) return;
+    shuffleScheduler.Serialize(out);
+}
+
+void SuiteSpot::FlushShuffleState() {
+    if (!shuffleStateDirty) return;
+    shuffleStateDirty = false;
+    SaveShuffleState();
+}
+
+void SuiteSpot::LoadAdaptiveDelays() {
+    auto f = GetAdaptiveDelaysPath();
+    std::error_code ec;
+    if (!std::filesystem::exists(f, ec)) return;
+    std::ifstream in(f.string());
+    if (!in.is_open()) return;
+    if (!adaptiveDelayTable.Deserialize(in)) {
+        LOG("SuiteSpot: Ignoring unreadable adaptive delays: " + f.string());
+    }
+}
+
+void SuiteSpot::SaveAdaptiveDelays() const {
+    SS_TRACE_SCOPE("io", "SaveAdaptiveDelays");
+    auto f = GetAdaptiveDelaysPath();
+    EnsureDataDirectories();
+    std::ofstream out(f.string(), std::ios::trunc);
+    if (!out.is_open()) return;
+    adaptiveDelayTable.Serialize(out);
+}
+
+// The index sits next to the log (SuiteMatchHistory.idx)
+void SuiteSpot::OpenMatchHistory() {
+    auto log = GetMatchHistoryPath();
+    auto index = log;
+    index.replace_extension(".idx");
+    std::string error;
+    if (!matchHistory.Open(log, index, error)) {
+        LOG("SuiteSpot: Match history unavailable: " + error);
+        return;
+    }
+    LOG("SuiteSpot: Match history loaded ({} matches)", matchHistory.Count());
+}
+
+// Large lists parse on the filter engine's pool; ParseBulkImport stays
+// inline below two chunks, so a short ss_bag_add never wakes a worker.
+// A render-side filter that finds the pool busy runs inline meanwhile.
+BulkImportResult SuiteSpot::ParseBulkText(std::string_view text) {
+    try {
+        return ParseBulkImport(text, prejumpFilterEngine ? &prejumpFilterEngine->Pool() : nullptr);
+    } catch (const std::exception& e) {
+        ERRORLOG("SuiteSpot: Bulk import parse failed: {}", e.what());
+        return {};
+    }
+}
+
+// Relative paths are tried as given, then under SuiteTraining
+bool SuiteSpot::ReadBulkImportFile(const std::string& pathArg, std::string& text, std::filesystem::path& resolved) const {
+    std::filesystem::path path = ExpandEnvAndHome(StripQuotes(Trim(pathArg)));
+    std::error_code ec;
+    if (path.is_relative() && !std::filesystem::exists(path, ec)) {
+        path = GetSuiteTrainingDir() / path;
+    }
+    resolved = path;
+    std::ifstream in(path.string(), std::ios::binary);
+    if (!in.is_open()) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+// #detailed comments: ApplyBulkShuffleAdd
+// Purpose: Add every parsed pack to the shuffle bag, then save once. Names
+// come from the line, else from the catalogs, else the code itself. Codes
+// that no loaded catalog knows are still added (they load by code) but are
+// counted so a typo-heavy file shows up in the summary.
+void SuiteSpot::ApplyBulkShuffleAdd(const BulkImportResult& parsed, const std::string& command) {
+    size_t added = 0;
+    size_t present = 0;
+    size_t uncataloged = 0;
+    for (const auto& entry : parsed.entries) {
+        if (trainingShuffleBag.Contains(entry.code)) {
+            ++present;
+            continue;
+        }
+        const TrainingEntry* known = FindTrainingEntry(entry.code);
+        if (!known) ++uncataloged;
+        std::string name = entry.name;
+        if (name.empty()) name = known ? std::string(known->name) : entry.code.ToString();
+        if (trainingShuffleBag.Add(entry.code, name)) ++added;
+    }
+
+    if (added > 0) {
+        SaveShuffleBag();
+        trainingBagSize = static_cast<int>(trainingShuffleBag.Size());
+        cvarManager->getCvar("suitespot_training_bag_size").setValue(trainingBagSize);
+    }
+    LOG("SuiteSpot: {}: added {} pack(s) to the shuffle bag ({} already in bag, {} not in any catalog, {} invalid, {} duplicate line(s)); bag now {}",
+        command, added, present, uncataloged, parsed.invalid, parsed.duplicates, trainingShuffleBag.Size());
+    for (int line : parsed.invalidLines) {
+        LOG("SuiteSpot: {}: invalid code on line {}", command, line);
+    }
+}
+
+// #detailed comments: ApplyBulkTrainingImport
+// Purpose: Append every new pack to RLTraining, then sort, reindex and
+// save once (the one-at-a-time form saves and reloads per pack). A pack
+// needs a name: from the line, else from the Prejump catalog; lines with
+// neither are rejected. The selected training pack is kept selected even
+// though the re-sort moves its row.
+void SuiteSpot::ApplyBulkTrainingImport(const BulkImportResult& parsed, const std::string& command) {
+    const std::string selectedCode = (currentTrainingIndex >= 0 && currentTrainingIndex < static_cast<int>(RLTraining.size()))
+        ? std::string(RLTraining[currentTrainingIndex].code) : std::string();
+
+    size_t added = 0;
+    size_t present = 0;
+    size_t unnamed = 0;
+    RLTraining.reserve(RLTraining.size() + parsed.entries.size());
+    for (const auto& entry : parsed.entries) {
+        if (trainingCodeIndex.IndexOf(TrainingCodeSource::Training, entry.code) >= 0) {
+            ++present;
+            continue;
         }
+        const TrainingEntry* known = FindTrainingEntry(entry.code);
+        if (entry.name.empty() && !known) {
+            ++unnamed;
+            continue;
+        }
+        TrainingEntry pack(entry.code.ToString(), entry.name.empty() ? std::string_view(known->name) : std::string_view(entry.name));
+        pack.shotCount = entry.shots > 0 ? entry.shots : (known ? known->shotCount : 0);
+        RLTraining.push_back(std::move(pack));
+        ++added;
+    }
+
+    if (added > 0) {
+        SortTrainingRows(RLTraining);
+        ReindexTrainingCodes(TrainingCodeSource::Training);
+        const int row = trainingCodeIndex.IndexOf(TrainingCodeSource::Training, selectedCode);
+        currentTrainingIndex = row >= 0 ? row : 0;
+        cvarManager->getCvar("suitespot_current_training_index").setValue(currentTrainingIndex);
+        SaveTrainingMaps();
+    }
+    LOG("SuiteSpot: {}: added {} training pack(s) ({} already saved, {} without a name, {} invalid, {} duplicate line(s)); list now {}",
+        command, added, present, unnamed, parsed.invalid, parsed.duplicates, RLTraining.size());
+    for (int line : parsed.invalidLines) {
+        LOG("SuiteSpot: {}: invalid code on line {}", command, line);
     }
 }
 
 void SuiteSpot::SaveShuffleBag() const {
+    SS_TRACE_SCOPE("io", "SaveShuffleBag");
     auto f = GetShuffleBagPath();
     EnsureDataDirectories();
     std::ofstream out(f.string(), std::ios::trunc);
     if (!out.is_open()) return;
-    for (const auto& e : trainingShuffleBag) {
-        out << e.code << "," << e.name << "\n";
-    }
+    WriteShuffleBag(out, trainingShuffleBag);
 }
 
 // Mirror src directory recursively into dst
@@ -506,33 +576,6 @@ std::filesystem::path SuiteSpot::ResolveConfiguredWorkshopRoot() const
 }
 
 
-void SuiteSpot::DiscoverWorkshopInDir(const std::filesystem::path& dir) {
-    std::error_code ec;
-    if (!std::filesystem::exists(dir, ec) || !std::filesystem::is_directory(dir, ec)) return;
-    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
-        if (ec) { ec.clear(); continue; }
-        if (!entry.is_directory()) continue;
-
-        // Look for any .upk file in the directory
-        std::string foundMapFile;
-        for (const auto& file : std::filesystem::directory_iterator(entry.path(), ec)) {
-            if (ec) { ec.clear(); continue; }
-            if (!file.is_regular_file()) continue;
-            
-            const auto& path = file.path();
-            if (path.extension().string() == ".upk") {
-                foundMapFile = path.string();
-                break;
-            }
-        }
-        
-        if (!foundMapFile.empty()) {
-            RLWorkshop.push_back({ foundMapFile, entry.path().filename().string() });
-        }
-    }
-}
-
-
 void SuiteSpot::SaveWorkshopMaps() const {
     // No-op
 }
@@ -552,6 +595,10 @@ void PostMatchOverlayWindow::Close() {
 }
 
 void PostMatchOverlayWindow::Render() {
+    Render(plugin_->postMatchBuffer.Read());
+}
+
+void PostMatchOverlayWindow::Render(const PostMatchInfo& postMatch) {
     if (!isWindowOpen_) return;
 
     ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
@@ -563,7 +610,8 @@ void PostMatchOverlayWindow::Render() {
                              ImGuiWindowFlags_NoBackground;
 
     ImVec2 display = ImGui::GetIO().DisplaySize;
-    const ImVec2 overlaySize = ImVec2(std::max(400.0f, plugin_->overlayWidth), std::max(180.0f, plugin_->overlayHeight));
+    const ImVec2 overlaySize = ImVec2(std::max(400.0f, plugin_->overlayWidth),
+                                      std::max(180.0f, plugin_->overlayHeight) + plugin_->GetOverlayTimelineHeight(postMatch));
     ImVec2 pos = ImVec2((display.x - overlaySize.x) * 0.5f + plugin_->overlayOffsetX, display.y * 0.08f + plugin_->overlayOffsetY);
 
     ImGui::SetNextWindowPos(pos, ImGuiCond_Always);
@@ -575,12 +623,12 @@ void PostMatchOverlayWindow::Render() {
         return;
     }
 
-    RenderWindow();
+    plugin_->RenderPostMatchOverlay(postMatch);
     ImGui::End();
 }
 
 void PostMatchOverlayWindow::RenderWindow() {
-    plugin_->RenderPostMatchOverlay();
+    plugin_->RenderPostMatchOverlay(plugin_->postMatchBuffer.Read());
 }
 
 std::filesystem::path SuiteSpot::GetPrejumpPacksPath() const {
@@ -627,108 +675,52 @@ std::string SuiteSpot::FormatLastUpdatedTime() const {
 }
 
 void SuiteSpot::LoadPrejumpPacksFromFile(const std::filesystem::path& filePath) {
+    SS_TRACE_SCOPE("catalog", "LoadPrejumpPacks");
     if (!std::filesystem::exists(filePath)) {
         LOG("SuiteSpot: Prejump packs file not found: " + filePath.string());
         return;
     }
     
-    try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            LOG("SuiteSpot: Failed to open Prejump packs file");
-            return;
-        }
-        
-        // Parse JSON using nlohmann/json
-        nlohmann::json jsonData;
-        file >> jsonData;
-        file.close();
-        
-        // Clear existing prejump packs
-        prejumpPacks.clear();
-        
-        // Validate JSON structure
-        if (!jsonData.contains("packs") || !jsonData["packs"].is_array()) {
-            LOG("SuiteSpot: Invalid Prejump packs file format - missing 'packs' array");
-            return;
-        }
-        
-        // Parse each pack
-        for (const auto& pack : jsonData["packs"]) {
-            TrainingEntry entry;
-            
-            // Required fields
-            if (pack.contains("code") && pack["code"].is_string()) {
-                entry.code = pack["code"].get<std::string>();
-            }
-            if (pack.contains("name") && pack["name"].is_string()) {
-                entry.name = pack["name"].get<std::string>();
-            }
-            
-            // Skip if missing required fields
-            if (entry.code.empty() || entry.name.empty()) {
-                continue;
-            }
-            
-            // Optional Prejump metadata
-            if (pack.contains("creator") && pack["creator"].is_string()) {
-                entry.creator = pack["creator"].get<std::string>();
-            }
-            if (pack.contains("creatorSlug") && pack["creatorSlug"].is_string()) {
-                entry.creatorSlug = pack["creatorSlug"].get<std::string>();
-            }
-            if (pack.contains("difficulty") && pack["difficulty"].is_string()) {
-                entry.difficulty = pack["difficulty"].get<std::string>();
-            }
-            if (pack.contains("shotCount") && pack["shotCount"].is_number()) {
-                entry.shotCount = pack["shotCount"].get<int>();
-            }
-            if (pack.contains("staffComments") && pack["staffComments"].is_string()) {
-                entry.staffComments = pack["staffComments"].get<std::string>();
-            }
-            if (pack.contains("notes") && pack["notes"].is_string()) {
-                entry.notes = pack["notes"].get<std::string>();
-            }
-            if (pack.contains("videoUrl") && pack["videoUrl"].is_string()) {
-                entry.videoUrl = pack["videoUrl"].get<std::string>();
-            }
-            if (pack.contains("likes") && pack["likes"].is_number()) {
-                entry.likes = pack["likes"].get<int>();
-            }
-            if (pack.contains("plays") && pack["plays"].is_number()) {
-                entry.plays = pack["plays"].get<int>();
-            }
-            if (pack.contains("status") && pack["status"].is_number()) {
-                entry.status = pack["status"].get<int>();
-            }
-            
-            // Parse tags array
-            if (pack.contains("tags") && pack["tags"].is_array()) {
-                for (const auto& tag : pack["tags"]) {
-                    if (tag.is_string()) {
-                        entry.tags.push_back(tag.get<std::string>());
-                    }
-                }
-            }
-            
-            prejumpPacks.push_back(entry);
-        }
-        
-        prejumpPackCount = static_cast<int>(prejumpPacks.size());
-        LOG("SuiteSpot: Loaded " + std::to_string(prejumpPackCount) + " prejump packs from file");
-        
-    } catch (const std::exception& e) {
-        LOG("SuiteSpot: Error loading Prejump packs: " + std::string(e.what()));
-        prejumpPacks.clear();
-        prejumpPackCount = 0;
+    const auto loadStart = std::chrono::steady_clock::now();
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG("SuiteSpot: Failed to open Prejump packs file");
+        return;
     }
+
+    // Parse into a fresh arena sized from the file; the old catalog and
+    // its arena are released in one step once the new one is ready
+    std::error_code sizeEc;
+    const auto fileBytes = std::filesystem::file_size(filePath, sizeEc);
+    auto arena = std::make_unique<CatalogArena>(CatalogArena::SizeForFile(sizeEc ? 0 : fileBytes));
+    std::vector<TrainingEntry> packs;
+    const CatalogReadReport report = ReadPrejumpPacks(file, *arena, packs);
+
+    prejumpPacks.clear();
+    if (report.Ok()) {
+        prejumpPacks = std::move(packs);
+        prejumpArena = std::move(arena);
+    } else {
+        LOG("SuiteSpot: Error loading Prejump packs: " + report.error);
+        prejumpArena.reset();
+    }
+    prejumpPackCount = static_cast<int>(prejumpPacks.size());
+    ++prejumpCatalogVersion;
+    ReindexTrainingCodes(TrainingCodeSource::Prejump);
+    if (!report.Ok()) return;
+
+    SS_TRACE_COUNTER("catalog", "PrejumpPacks", prejumpPackCount);
+    const CatalogArenaStats arenaStats = prejumpArena->GetStats();
+    LOG("SuiteSpot: Loaded {} prejump packs from file in {:.1f} ms ({} skipped; {} allocations in {} arena block(s), {} KB used of {} KB)",
+        prejumpPackCount, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count(),
+        report.skipped, arenaStats.allocations, arenaStats.blocks, arenaStats.bytesRequested / 1024, arenaStats.bytesReserved / 1024);
 }
 
 // #detailed comments: ScrapeAndLoadPrejumpPacks
 // Purpose: Launches an external PowerShell script to scrape Prejump.com
 // and write a JSON cache to disk. This is intentionally performed in a
-// background task (scheduled via gameWrapper->SetTimeout) to avoid any
-// blocking on the UI/game thread.
+// background task (scheduled on timerWheel) to avoid any blocking on the
+// UI thread.
 //
 // Safety and behavior notes:
 //  - prejumpScrapingInProgress is a guard flag ensuring only one scrape
@@ -741,7 +733,7 @@ void SuiteSpot::LoadPrejumpPacksFromFile(const std::filesystem::path& filePath)
 //  - The script path is hard-coded to the repo dev path; callers should
 //    ensure that the script is present when invoking this routine.
 //
-// DO NOT CHANGE: Modifying timing (the 0.1f scheduling) or the way the
+// DO NOT CHANGE: Modifying timing (the 100 ms scheduling) or the way the
 // result is checked could resurface race conditions that previously
 // required this exact coordination.
 void SuiteSpot::ScrapeAndLoadPrejumpPacks() {
@@ -766,10 +758,12 @@ void SuiteSpot::ScrapeAndLoadPrejumpPacks() {
     
     prejumpScrapingInProgress = true;
     LOG("SuiteSpot: Started Prejump scraper...");
+    SS_TRACE_INSTANT("scrape", "PrejumpScrapeQueued");
     
     // Execute in background (detached process)
     // On Windows, we use system() which creates a detached process by default
-    gameWrapper->SetTimeout([this, cmd, outputPath](GameWrapper* gw) {
+    timerWheel.Schedule(std::chrono::milliseconds(100), [this, cmd, outputPath]() {
+        SS_TRACE_SCOPE("scrape", "PrejumpScrape");
         int result = system(cmd.c_str());
         
         if (result == 0) {
@@ -782,7 +776,7 @@ void SuiteSpot::ScrapeAndLoadPrejumpPacks() {
         }
         
         prejumpScrapingInProgress = false;
-    }, 0.1f);  // Execute next frame to avoid blocking
+    }, "prejump.scrape");  // Execute next frame to avoid blocking
 }
 
 
@@ -791,7 +785,7 @@ using namespace std::filesystem;
 
 void SuiteSpot::LoadWorkshopMaps()
 {
-    RLWorkshop.clear();
+    SS_TRACE_SCOPE("catalog", "LoadWorkshopMaps");
 
     std::vector<std::filesystem::path> roots;
     if (const auto configured = ResolveConfiguredWorkshopRoot(); !configured.empty())
@@ -803,36 +797,7 @@ void SuiteSpot::LoadWorkshopMaps()
     roots.emplace_back(R"(C:\Program Files\Epic Games\rocketleague\TAGame\CookedPCConsole\mods)");
     roots.emplace_back(R"(C:\Program Files (x86)\Steam\steamapps\common\rocketleague\TAGame\CookedPCConsole\mods)");
 
-    for (const auto& root : roots)
-    {
-        if (!root.empty())
-        {
-            DiscoverWorkshopInDir(root);
-        }
-    }
-
-    std::unordered_set<std::string> seen;
-    std::vector<WorkshopEntry> unique;
-    unique.reserve(RLWorkshop.size());
-    for (const auto& entry : RLWorkshop)
-    {
-        if (seen.insert(entry.filePath).second)
-        {
-            unique.push_back(entry);
-        }
-    }
-    RLWorkshop.swap(unique);
-
-    std::sort(RLWorkshop.begin(), RLWorkshop.end(),
-        [](const WorkshopEntry& lhs, const WorkshopEntry& rhs)
-        {
-            const int cmp = CaseInsensitiveCompare(lhs.name, rhs.name);
-            if (cmp == 0)
-            {
-                return lhs.filePath < rhs.filePath;
-            }
-            return cmp < 0;
-        });
+    RLWorkshop = DiscoverWorkshopMaps(roots);
 
     if (RLWorkshop.empty())
     {
@@ -856,6 +821,92 @@ void SuiteSpot::LoadHooks() {
     // Re-queue/transition at match end or when main menu appears after a match
     gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.EventMatchEnded", bind(&SuiteSpot::GameEndedEvent, this, placeholders::_1));
     gameWrapper->HookEvent("Function TAGame.AchievementManager_TA.HandleMatchEnded", bind(&SuiteSpot::GameEndedEvent, this, placeholders::_1));
+
+    // Transitions the post-match sequence waits for
+    gameWrapper->HookEvent("Function TAGame.GFxData_MainMenu_TA.MainMenuAdded", [this](std::string) {
+        SS_TRACE_SCOPE("hook", "MainMenuAdded");
+        postMatchSequencer.Raise(PostMatchEvent::Settled);
+    });
+    gameWrapper->HookEvent("Function ProjectX.EngineShare_X.EventPreLoadMap", [this](std::string) {
+        SS_TRACE_SCOPE("hook", "EventPreLoadMap");
+        postMatchSequencer.Raise(PostMatchEvent::LoadStarted);
+    });
+    gameWrapper->HookEvent("Function TAGame.LoadingScreen_TA.HandlePostLoadMap", [this](std::string) {
+        SS_TRACE_SCOPE("hook", "HandlePostLoadMap");
+        postMatchLatency.MapLoaded();
+        postMatchSequencer.Raise(PostMatchEvent::MapLoaded);
+    });
+
+    // Drives timerWheel: one game-thread tick for every deferred action
+    gameWrapper->HookEvent("Function Engine.GameViewportClient.Tick", [this](std::string) {
+        TraceRecorder& trace = TraceRecorder::Get();
+        if (trace.Recording()) {
+            trace.NameThread("Game");
+            trace.Drain();
+        }
+        SS_TRACE_SCOPE("hook", "Tick");
+        GlobalLogger().DrainConsole();
+        timerWheel.Advance();
+        if (loadoutManager) {
+            loadoutManager->Poll();
+        }
+    });
+}
+
+void SuiteSpot::PublishPostMatch(bool active) {
+    PostMatchInfo& slot = postMatchBuffer.WriteSlot();
+    slot.active = active;
+    slot.start = std::chrono::steady_clock::now();
+    slot.sequence = ++postMatchSequence;
+    postMatchShown = active;
+    postMatchShownAt = slot.start;
+    postMatchBuffer.Publish();
+}
+
+// #detailed comments: ToggleTestOverlay
+// Purpose: Backs ss_testoverlay and the "Trigger Test Overlay" button.
+// Must run on the game thread (the buffer's only writer); the button
+// forwards here through gameWrapper->Execute.
+void SuiteSpot::ToggleTestOverlay() {
+    const float shownFor = std::chrono::duration<float>(std::chrono::steady_clock::now() - postMatchShownAt).count();
+    if (postMatchShown && shownFor < postMatchDurationSec) {
+        PublishPostMatch(false);
+        LOG("SuiteSpot: Test overlay DEACTIVATED");
+        return;
+    }
+
+    PostMatchInfo& slot = postMatchBuffer.WriteSlot();
+    if (lastCapturedMatch.playerCount > 0) {
+        slot = lastCapturedMatch;
+    } else {
+        // Sample data until a real match has been captured
+        slot.myTeamName = "Blue Team";
+        slot.oppTeamName = "Orange Team";
+        slot.myScore = 3;
+        slot.oppScore = 2;
+        slot.playlist = "Competitive Doubles";
+        slot.overtime = false;
+        slot.timelineSession = 0;
+        slot.playerCount = 4;
+        const struct { const char* name; int score; int goals; bool isLocal; int teamIndex; bool isMVP; } sample[] = {
+            { "LocalPlayer", 650, 2, true, 0, true },
+            { "Teammate", 400, 1, false, 0, false },
+            { "Opponent 1", 500, 1, false, 1, true },
+            { "Opponent 2", 300, 1, false, 1, false },
+        };
+        for (size_t i = 0; i < slot.playerCount; ++i) {
+            PostMatchPlayerRow& row = slot.rows[i];
+            row = PostMatchPlayerRow{};
+            row.name = sample[i].name;
+            row.score = sample[i].score;
+            row.goals = sample[i].goals;
+            row.isLocal = sample[i].isLocal;
+            row.teamIndex = sample[i].teamIndex;
+            row.isMVP = sample[i].isMVP;
+        }
+    }
+    PublishPostMatch(true);
+    LOG("SuiteSpot: Test overlay ACTIVATED");
 }
 
 // #detailed comments: GameEndedEvent
@@ -866,20 +917,65 @@ void SuiteSpot::LoadHooks() {
 // are caught and logged to avoid destabilizing the host.
 //
 // Timing and ordering notes:
+//  - Both match-ended hooks normally fire for the same match; the
+//    matchEndPipeline gate lets only the first one through, so capture
+//    and the scheduled commands run once per match.
 //  - Capture scores and PRIs immediately; the game may transition state
 //    between frames so delaying capture risks losing final values.
 //  - The postMatch.start timestamp is recorded with steady_clock so
 //    overlay lifetime calculations are not affected by system clock
 //    adjustments.
-//
-// DO NOT CHANGE: The safeExecute lambda intentionally accepts a delay
-// (in seconds) and either executes immediately or schedules via
-// gameWrapper->SetTimeout. Changing its semantics will alter when
-// external commands (load_freeplay, queue, etc.) are run relative to
-// overlay presentation.
+//  - RunPostMatchActions resolves the map and queue immediately but runs
+//    them from a coroutine (RunPostMatchSequence) that waits for the game
+//    to be ready; the configured delays only bound those waits.
+//  - Loadout rules are resolved by LoadoutManager long before this runs,
+//    so equipping the mode's preset adds one EquipPreset to the sequence.
 void SuiteSpot::GameEndedEvent(std::string name) {
+    SS_PROFILE_SCOPE("GameEndedEvent");
+    SS_TRACE_SCOPE("hook", "GameEndedEvent");
     if (!enabled) return;
 
+    // Both match-ended hooks usually fire for one match; only the first counts
+    std::string matchGuid;
+    uint64_t eventAddress = 0;
+    GetMatchEvent(matchGuid, eventAddress);
+    std::string matchKey;
+    if (!AcceptMatchEnd(matchEndPipeline, matchGuid, eventAddress, name, matchKey)) {
+        DEBUGLOG("SuiteSpot: Ignoring duplicate match end from {} (match {})", name, matchKey.empty() ? "unknown" : matchKey);
+        return;
+    }
+
+    CaptureMatchResult();
+    RunPostMatchActions();
+}
+
+// Server match GUID and game event address; empty and 0 outside a match
+void SuiteSpot::GetMatchEvent(std::string& matchGuid, uint64_t& eventAddress) {
+    try {
+        auto server = gameWrapper->GetGameEventAsServer();
+        if (server.IsNull()) return;
+        matchGuid = server.GetMatchGUID();
+        eventAddress = static_cast<uint64_t>(server.memory_address);
+    } catch (...) {
+        matchGuid.clear();
+        eventAddress = 0;
+    }
+}
+
+// #detailed comments: CaptureMatchResult
+// Purpose: Read final scores, team names and PRIs into the post-match
+// buffer's write slot and publish it; the render thread opens the overlay
+// when it sees the new snapshot. Runs once per match (GameEndedEvent
+// filters duplicates).
+void SuiteSpot::CaptureMatchResult() {
+    // Close the timeline with the final stats; the overlay plots this session
+    uint64_t timelineSession = 0;
+    if (matchTimelineEnabled && statSampler.Active()) {
+        SampleMatchStats();
+        timelineSession = statSampler.Session();
+    }
+    statSampler.End();
+
     // Capture final scores before any transitions
     try {
         auto server = gameWrapper->GetGameEventAsServer();
@@ -919,35 +1015,37 @@ void SuiteSpot::GameEndedEvent(std::string name) {
             }
 
             if (!myTeam.IsNull() && !oppTeam.IsNull()) {
-                auto nameFromTeam = [](TeamWrapper& t, const std::string& fallback) {
-                    std::string result = fallback;
+                // Filled in place: the back slot is private to this thread
+                // until PublishPostMatch, and its strings keep their capacity
+                PostMatchInfo& postMatch = postMatchBuffer.WriteSlot();
+                auto nameFromTeam = [](TeamWrapper& t, const char* fallback, std::string& result) {
+                    result.assign(fallback);
                     auto custom = t.GetCustomTeamName();
                     if (!custom.IsNull()) {
                         auto str = custom.ToString();
-                        if (!str.empty()) result = str;
+                        if (!str.empty()) result.assign(str);
                     }
                     auto baseName = t.GetTeamName();
                     if (!baseName.IsNull()) {
                         auto str = baseName.ToString();
-                        if (!str.empty()) result = str;
+                        if (!str.empty()) result.assign(str);
                     }
-                    return result;
                 };
 
                 // Build player rows from PRIs
-                postMatch.players.clear();
+                postMatch.playerCount = 0;
                 try {
                     auto pris = server.GetPRIs();
-                    for (int i = 0; i < pris.Count(); ++i) {
+                    for (int i = 0; i < pris.Count() && postMatch.playerCount < kMaxPostMatchPlayers; ++i) {
                         PriWrapper pri = pris.Get(i);
                         if (pri.IsNull()) continue;
 
-                        PostMatchPlayerRow row;
+                        PostMatchPlayerRow& row = postMatch.rows[postMatch.playerCount];
                         row.teamIndex = pri.GetTeam().IsNull() ? -1 : pri.GetTeam().GetTeamIndex();
                         row.isLocal = pri.IsLocalPlayerPRI();
 
                         auto name = pri.GetPlayerName();
-                        row.name = name.IsNull() ? "" : name.ToString();
+                        if (name.IsNull()) row.name.clear(); else row.name.assign(name.ToString());
                         row.score = pri.GetMatchScore();
                         row.goals = pri.GetMatchGoals();
                         row.assists = pri.GetMatchAssists();
@@ -961,86 +1059,101 @@ void SuiteSpot::GameEndedEvent(std::string name) {
                         // Simple MVP detection (highest score on team for now)
                         row.isMVP = false; // Will be calculated after all players are collected
 
-                        postMatch.players.push_back(row);
+                        ++postMatch.playerCount;
                     }
                 } catch (...) {
                     // ignore; overlay still shows team scores
                 }
 
                 // Sort rows by team, score desc then name
-                std::sort(postMatch.players.begin(), postMatch.players.end(), [](const PostMatchPlayerRow& a, const PostMatchPlayerRow& b) {
+                auto players = postMatch.Players();
+                std::sort(players.begin(), players.end(), [](const PostMatchPlayerRow& a, const PostMatchPlayerRow& b) {
                     if (a.teamIndex != b.teamIndex) return a.teamIndex < b.teamIndex;
                     if (a.score != b.score) return a.score > b.score;
                     return a.name < b.name;
                 });
 
-                // Mark MVPs (highest scoring player on each team)
-                std::map<int, int> teamHighScores;
-                for (auto& row : postMatch.players) {
-                    if (teamHighScores.find(row.teamIndex) == teamHighScores.end() || 
-                        row.score > teamHighScores[row.teamIndex]) {
-                        teamHighScores[row.teamIndex] = row.score;
-                    }
+                // Mark MVPs (highest scoring player on each team; index 0 = no team)
+                int teamHighScores[3] = { INT_MIN, INT_MIN, INT_MIN };
+                auto teamSlot = [](int teamIndex) { return (teamIndex == 0 || teamIndex == 1) ? teamIndex + 1 : 0; };
+                for (const auto& row : players) {
+                    teamHighScores[teamSlot(row.teamIndex)] = std::max(teamHighScores[teamSlot(row.teamIndex)], row.score);
                 }
-                for (auto& row : postMatch.players) {
-                    row.isMVP = (row.score == teamHighScores[row.teamIndex] && row.score > 0);
+                for (auto& row : players) {
+                    row.isMVP = (row.score == teamHighScores[teamSlot(row.teamIndex)] && row.score > 0);
                 }
 
                 postMatch.myScore = myTeam.GetScore();
                 postMatch.oppScore = oppTeam.GetScore();
-                postMatch.myTeamName = nameFromTeam(myTeam, "My Team");
-                postMatch.oppTeamName = nameFromTeam(oppTeam, "Opponents");
-                postMatch.playlist = server.GetMatchTypeName();
+                nameFromTeam(myTeam, "My Team", postMatch.myTeamName);
+                nameFromTeam(oppTeam, "Opponents", postMatch.oppTeamName);
+                postMatch.playlist.assign(server.GetMatchTypeName());
                 postMatch.overtime = !!server.GetbOverTime();
-                postMatch.myColor = myTeam.GetFontColor();
-                postMatch.oppColor = oppTeam.GetFontColor();
-
-                postMatch.start = std::chrono::steady_clock::now();
-                postMatch.active = true;
-                if (postMatchOverlayWindow) {
-                    postMatchOverlayWindow->Open();
+                postMatch.timelineSession = timelineSession;
+                const LinearColor myFont = myTeam.GetFontColor();
+                const LinearColor oppFont = oppTeam.GetFontColor();
+                postMatch.myColor = { myFont.R, myFont.G, myFont.B, myFont.A };
+                postMatch.oppColor = { oppFont.R, oppFont.G, oppFont.B, oppFont.A };
+
+                PublishPostMatch(true);
+
+                // The published slot is read-only now; copying it for the
+                // test overlay happens after the renderer can already see it
+                lastCapturedMatch = postMatch;
+                lastCapturedTime = static_cast<int64_t>(std::time(nullptr));
+
+                // The append writes and remaps two files; it runs on the next
+                // tick so RunPostMatchActions is not held up behind the disk.
+                // It reads lastCapturedMatch then: capturing only this keeps
+                // the callback inside std::function's inline storage.
+                if (matchHistory.IsOpen()) {
+                    timerWheel.Schedule(std::chrono::milliseconds(0), [this]() {
+                        SS_TRACE_SCOPE("io", "MatchHistoryAppend");
+                        std::string historyError;
+                        if (matchHistory.IsOpen() && !matchHistory.Append(lastCapturedMatch, lastCapturedTime, historyError)) {
+                            WARNLOG("SuiteSpot: Match history disabled: {}", historyError);
+                        }
+                    });
                 }
-                LOG("SuiteSpot: Post-match overlay activated - {} vs {}, Score: {}-{}",
-                    postMatch.myTeamName, postMatch.oppTeamName, postMatch.myScore, postMatch.oppScore);
+                DEBUGLOG("SuiteSpot: Post-match overlay activated - {} vs {}, Score: {}-{}",
+                    lastCapturedMatch.myTeamName, lastCapturedMatch.oppTeamName, lastCapturedMatch.myScore, lastCapturedMatch.oppScore);
                 // Overlay is now independent from settings window - no menu toggle needed
             }
         }
     } catch (const std::exception& e) {
-        LOG("SuiteSpot: Failed to capture post-match overlay data: {}", e.what());
+        ERRORLOG("SuiteSpot: Failed to capture post-match overlay data: {}", e.what());
     }
+}
 
-    auto safeExecute = [&](int delaySec, const std::string& cmd) {
-        if (delaySec <= 0) {
-            cvarManager->executeCommand(cmd);
-        } else {
-            gameWrapper->SetTimeout([this, cmd](GameWrapper* gw) { cvarManager->executeCommand(cmd); }, static_cast<float>(delaySec));
-        }
-    };
-
-    int mapLoadDelay = 0;
+// #detailed comments: RunPostMatchActions
+// Purpose: Resolve the configured map load and auto-queue after a match
+// and start the sequence that runs them. A sequence still waiting from
+// the previous match is cancelled first.
+void SuiteSpot::RunPostMatchActions() {
+    PostMatchPlan plan;
 
     // Dispatch based on mapType
     if (mapType == 0) { // Freeplay
         if (currentIndex < 0 || currentIndex >= (int)RLMaps.size()) {
             LOG("SuiteSpot: Freeplay index out of range; skipping load.");
         } else {
-            safeExecute(delayFreeplaySec, "load_freeplay " + RLMaps[currentIndex].code);
-            mapLoadDelay = delayFreeplaySec;
-            LOG("SuiteSpot: Loading freeplay map: " + RLMaps[currentIndex].name);
+            plan.loadCommand = "load_freeplay " + RLMaps[currentIndex].code;
+            plan.loadName = RLMaps[currentIndex].name;
+            plan.loadDelaySec = delayFreeplaySec;
         }
     } else if (mapType == 1) { // Training
-        if (RLTraining.empty() && trainingShuffleBag.empty()) {
+        if (RLTraining.empty() && trainingShuffleBag.Empty()) {
             LOG("SuiteSpot: No training maps configured.");
         } else {
             std::string codeToLoad = "";
             std::string nameToLoad = "";
 
-            if (trainingShuffleEnabled && !trainingShuffleBag.empty()) {
-                static std::mt19937 rng(std::random_device{}());
-                std::uniform_int_distribution<int> dist(0, static_cast<int>(trainingShuffleBag.size()) - 1);
-                int bagIndex = dist(rng);
-                codeToLoad = trainingShuffleBag[bagIndex].code;
-                nameToLoad = trainingShuffleBag[bagIndex].name;
+            if (trainingShuffleEnabled && !trainingShuffleBag.Empty()) {
+                if (const auto code = NextShufflePack()) {
+                    codeToLoad = code->ToString();
+                    const TrainingEntry* entry = FindTrainingEntry(*code);
+                    nameToLoad = entry ? std::string(entry->name) : codeToLoad;
+                }
             } else if (!RLTraining.empty()) {
                 currentTrainingIndex = std::clamp(currentTrainingIndex, 0, (int)RLTraining.size() - 1);
                 codeToLoad = RLTraining[currentTrainingIndex].code;
@@ -1048,9 +1161,9 @@ void SuiteSpot::GameEndedEvent(std::string name) {
             }
 
             if (!codeToLoad.empty()) {
-                safeExecute(delayTrainingSec, "load_training " + codeToLoad);
-                mapLoadDelay = delayTrainingSec;
-                LOG("SuiteSpot: Loading training map: " + nameToLoad);
+                plan.loadCommand = "load_training " + codeToLoad;
+                plan.loadName = nameToLoad;
+                plan.loadDelaySec = delayTrainingSec;
             }
         }
     } else if (mapType == 2) { // Workshop
@@ -1058,31 +1171,223 @@ void SuiteSpot::GameEndedEvent(std::string name) {
             LOG("SuiteSpot: No workshop maps configured.");
         } else {
             currentWorkshopIndex = std::clamp(currentWorkshopIndex, 0, (int)RLWorkshop.size()-1);
-            safeExecute(delayWorkshopSec, "load_workshop \"" + RLWorkshop[currentWorkshopIndex].filePath + "\"");
-            mapLoadDelay = delayWorkshopSec;
-            LOG("SuiteSpot: Loading workshop map: " + RLWorkshop[currentWorkshopIndex].name);
+            plan.loadCommand = "load_workshop \"" + RLWorkshop[currentWorkshopIndex].filePath + "\"";
+            plan.loadName = RLWorkshop[currentWorkshopIndex].name;
+            plan.loadDelaySec = delayWorkshopSec;
+        }
+    }
+
+    plan.mode = static_cast<LatencyMode>(std::clamp(mapType, 0, static_cast<int>(LatencyMode::Count) - 1));
+    plan.loadoutRule = static_cast<LoadoutRule>(plan.mode);  // Same order: freeplay, training, workshop
+    plan.queue = autoQueue;
+    plan.queueDelaySec = delayQueueSec;
+    plan.adaptive = adaptiveDelaysEnabled;
+    try {
+        auto server = gameWrapper->GetGameEventAsServer();
+        if (!server.IsNull()) plan.playlist = server.GetMatchTypeName();
+    } catch (...) {
+    }
+
+    postMatchSequencer.CancelAll();
+    RunPostMatchSequence(std::move(plan));
+    SchedulePostMatchTick();
+}
+
+// #detailed comments: RunPostMatchSequence
+// Purpose: The post-match steps as one coroutine. Each step starts on a
+// game event and falls back to its configured delay (measured from match
+// end, as before) when the event does not come:
+//  - the map load waits until the match is settled (see IsMatchSettled)
+//  - queue waits for the loaded map to finish loading, or for the match
+//    to settle when no map is loaded. Queueing into a map that is still
+//    loading is the race the old fixed delays were padded against, so a
+//    load always gets at least kMapLoadFallbackSec.
+// A zero delay skips the wait for a settled match (the old immediate path).
+//
+// With adaptive delays each command instead goes out at its learned delay
+// (adaptiveDelayTable, keyed by action, mode and playlist) and is
+// confirmed: a load must start loading within kConfirmSec, a queue must
+// start searching. An unconfirmed command is a failure at that delay and
+// is retried, up to kMaxAttempts in all.
+PostMatchSequencer::Task SuiteSpot::RunPostMatchSequence(PostMatchPlan plan) {
+    constexpr double kMapLoadFallbackSec = 15.0;
+    constexpr double kConfirmSec = 5.0;
+    constexpr int kMaxAttempts = 3;
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsedSec = [start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    const auto describe = [](PostMatchWaitResult result) {
+        return result == PostMatchWaitResult::Event ? "on cue" : "at fallback";
+    };
+    // Rule presets were resolved to indices ahead of time; this is one EquipPreset
+    const auto applyLoadout = [this](LoadoutRule rule) {
+        if (loadoutManager) loadoutManager->ApplyRule(rule);
+    };
+    postMatchLatency.BeginMatch(plan.mode, start);
+
+    if (!plan.loadCommand.empty()) {
+        if (plan.adaptive) {
+            const std::string key = AdaptiveDelayTable::Key("load", LatencyModeName(plan.mode), plan.playlist);
+            co_await postMatchSequencer.Sleep(adaptiveDelayTable.GetDelay(key, plan.loadDelaySec) - elapsedSec());
+            applyLoadout(plan.loadoutRule);
+            for (int attempt = 1; attempt <= kMaxAttempts; ++attempt) {
+                const double issuedAt = elapsedSec();
+                cvarManager->executeCommand(plan.loadCommand);
+                if (attempt == 1) {
+                    postMatchLatency.LoadIssued(true);
+                    LOG("SuiteSpot: Loading map {:.1f}s after match end (learned delay): {}", issuedAt, plan.loadName);
+                }
+                if (co_await postMatchSequencer.WaitFor(PostMatchEvent::LoadStarted, kConfirmSec) == PostMatchWaitResult::Event) {
+                    adaptiveDelayTable.RecordSuccess(key, issuedAt, plan.loadDelaySec);
+                    break;
+                }
+                adaptiveDelayTable.RecordFailure(key, issuedAt, plan.loadDelaySec);
+                LOG("SuiteSpot: Map load was not accepted {:.1f}s after match end ({}/{})", issuedAt, attempt, kMaxAttempts);
+            }
+            SaveAdaptiveDelays();
+        } else {
+            const auto ready = co_await postMatchSequencer.WaitFor(PostMatchEvent::Settled, plan.loadDelaySec);
+            applyLoadout(plan.loadoutRule);
+            cvarManager->executeCommand(plan.loadCommand);
+            postMatchLatency.LoadIssued(plan.loadDelaySec <= 0 || ready == PostMatchWaitResult::Event);
+            LOG("SuiteSpot: Loading map {:.1f}s after match end ({}): {}", elapsedSec(),
+                plan.loadDelaySec > 0 ? describe(ready) : "no delay", plan.loadName);
+        }
+    }
+
+    if (plan.queue) {
+        const bool loaded = !plan.loadCommand.empty();
+        double timeout = plan.queueDelaySec - elapsedSec();
+        if (loaded) timeout = std::max(timeout, kMapLoadFallbackSec);
+
+        if (plan.adaptive) {
+            // Never queue into a loading screen; then hold to the learned delay
+            if (loaded) co_await postMatchSequencer.WaitFor(PostMatchEvent::MapLoaded, timeout);
+            const std::string key = AdaptiveDelayTable::Key("queue", LatencyModeName(plan.mode), plan.playlist);
+            co_await postMatchSequencer.Sleep(adaptiveDelayTable.GetDelay(key, plan.queueDelaySec) - elapsedSec());
+            applyLoadout(LoadoutRule::Queue);
+            for (int attempt = 1; attempt <= kMaxAttempts; ++attempt) {
+                const double issuedAt = elapsedSec();
+                cvarManager->executeCommand("queue");
+                if (attempt == 1) {
+                    postMatchLatency.QueueIssued(true);
+                    LOG("SuiteSpot: Auto-Queuing {:.1f}s after match end (learned delay)", issuedAt);
+                }
+                if (co_await postMatchSequencer.WaitFor(PostMatchEvent::QueueStarted, kConfirmSec) == PostMatchWaitResult::Event) {
+                    adaptiveDelayTable.RecordSuccess(key, issuedAt, plan.queueDelaySec);
+                    break;
+                }
+                adaptiveDelayTable.RecordFailure(key, issuedAt, plan.queueDelaySec);
+                LOG("SuiteSpot: Queue was not accepted {:.1f}s after match end ({}/{})", issuedAt, attempt, kMaxAttempts);
+            }
+            SaveAdaptiveDelays();
+        } else {
+            const auto ready = co_await postMatchSequencer.WaitFor(loaded ? PostMatchEvent::MapLoaded : PostMatchEvent::Settled, timeout);
+            applyLoadout(LoadoutRule::Queue);
+            cvarManager->executeCommand("queue");
+            postMatchLatency.QueueIssued(timeout <= 0.0 || ready == PostMatchWaitResult::Event);
+            LOG("SuiteSpot: Auto-Queuing {:.1f}s after match end ({})", elapsedSec(),
+                timeout > 0.0 ? describe(ready) : "no delay");
         }
     }
+}
+
+// Results are recorded once an online match's MMR update has landed;
+// offline matches have nothing to wait for
+bool SuiteSpot::IsMatchSettled() {
+    if (!gameWrapper->IsInOnlineGame()) return true;
+    return !gameWrapper->GetMMRWrapper().IsSyncing(gameWrapper->GetUniqueID());
+}
+
+// Re-arms itself while suitespot_match_timeline is on; the interval comes
+// from the sampler, which backs off when a sample runs over budget
+void SuiteSpot::ScheduleStatSample() {
+    if (!matchTimelineEnabled) return;
+    timerWheel.Schedule(statSampler.Interval(), [this]() {
+        SampleMatchStats();
+        ScheduleStatSample();
+    }, "stats.sample");
+}
 
-    // Auto-queue runs independently of map load
-    if (autoQueue) {
-        safeExecute(delayQueueSec, "queue");
-        LOG("SuiteSpot: Auto-Queuing scheduled with delay: " + std::to_string(delayQueueSec) + "s.");
+// #detailed comments: SampleMatchStats
+// Purpose: One timeline sample of every PRI's score, goals and saves. A
+// new match identity starts a new session; a session the match-end
+// capture has closed takes no more samples. The whole read is timed and
+// reported to the sampler, which owns the cost budget.
+void SuiteSpot::SampleMatchStats() {
+    const auto start = MatchStatSampler::Clock::now();
+    try {
+        auto server = gameWrapper->GetGameEventAsServer();
+        if (server.IsNull()) return;
+        std::string identity = MatchIdentity(server.GetMatchGUID(), static_cast<uint64_t>(server.memory_address));
+        if (identity != statSamplerMatch) {
+            statSamplerMatch = std::move(identity);
+            statSampler.Begin(start);
+        }
+        if (!statSampler.Active()) return;
+
+        std::array<StatReading, kMaxPostMatchPlayers> readings;
+        size_t count = 0;
+        auto pris = server.GetPRIs();
+        for (int i = 0; i < pris.Count() && count < readings.size(); ++i) {
+            PriWrapper pri = pris.Get(i);
+            if (pri.IsNull()) continue;
+            StatReading& reading = readings[count++];
+            reading.id = pri.memory_address;
+            reading.team = pri.GetTeam().IsNull() ? -1 : pri.GetTeam().GetTeamIndex();
+            reading.score = pri.GetMatchScore();
+            reading.goals = pri.GetMatchGoals();
+            reading.saves = pri.GetMatchSaves();
+        }
+        statSampler.Record({ readings.data(), count }, start);
+    } catch (...) {
+        return;
     }
+    statSampler.RecordCost(MatchStatSampler::Clock::now() - start);
+}
+
+// Drives the sequencer while a sequence is suspended: raises the polled
+// events (Settled, QueueStarted) and fires expired fallbacks. The key
+// keeps a single tick pending however often this is called.
+void SuiteSpot::SchedulePostMatchTick() {
+    constexpr auto kTick = std::chrono::milliseconds(100);
+    if (!postMatchSequencer.HasPending()) return;
+    timerWheel.Schedule(kTick, [this]() {
+        if (postMatchSequencer.IsWaitingFor(PostMatchEvent::Settled) && IsMatchSettled()) {
+            postMatchSequencer.Raise(PostMatchEvent::Settled);
+        }
+        if (postMatchSequencer.IsWaitingFor(PostMatchEvent::QueueStarted) && gameWrapper->GetMatchmakingWrapper().IsSearching()) {
+            postMatchSequencer.Raise(PostMatchEvent::QueueStarted);
+        }
+        postMatchSequencer.Poll();
+        SchedulePostMatchTick();
+    }, "postmatch.tick");
 }
 
 void SuiteSpot::onLoad() {
     _globalCvarManager = cvarManager;
+    // From here LOG only queues; the logger's thread writes the log file and
+    // the tick hook passes console lines on (see AsyncLogger)
+    GlobalLogger().Start([cvars = cvarManager](LogLevel level, const std::string& line) {
+        cvars->log(level >= LogLevel::Warn ? "[" + std::string(LogLevelName(level)) + "] " + line : line);
+    });
     LOG("SuiteSpot loaded");
     EnsureDataDirectories();
     EnsureReadmeFiles();
     LoadTrainingMaps();
     LoadWorkshopMaps();
     LoadShuffleBag();
+    LoadShuffleState();
+    LoadAdaptiveDelays();
+    OpenMatchHistory();
     
     // Initialize LoadoutManager
-    loadoutManager = std::make_unique<LoadoutManager>(gameWrapper);
+    loadoutManager = std::make_unique<LoadoutManager>(gameWrapper, timerWheel);
     LOG("SuiteSpot: LoadoutManager initialized");
+
+    // Browser filter engine (worker threads park until a large catalog is filtered)
+    prejumpFilterEngine = std::make_unique<PackFilterEngine>();
     
     // Check Prejump cache and load if available
     prejumpLastUpdated = FormatLastUpdatedTime();
@@ -1102,34 +1407,413 @@ void SuiteSpot::onLoad() {
 
     // Register test overlay toggle
     cvarManager->registerNotifier("ss_testoverlay", [this](std::vector<std::string> args) {
-        // Mock data if empty for testing
-        if (postMatch.players.empty()) {
-            postMatch.myTeamName = "Blue Team";
-            postMatch.oppTeamName = "Orange Team";
-            postMatch.myScore = 3;
-            postMatch.oppScore = 2;
-            postMatch.playlist = "Competitive Doubles";
-            postMatch.overtime = false;
-            
-            PostMatchPlayerRow p1; p1.name = "LocalPlayer"; p1.score = 650; p1.goals = 2; p1.isLocal = true; p1.teamIndex = 0; p1.isMVP = true;
-            PostMatchPlayerRow p2; p2.name = "Teammate"; p2.score = 400; p2.goals = 1; p2.isLocal = false; p2.teamIndex = 0;
-            PostMatchPlayerRow p3; p3.name = "Opponent 1"; p3.score = 500; p3.goals = 1; p3.isLocal = false; p3.teamIndex = 1; p3.isMVP = true;
-            PostMatchPlayerRow p4; p4.name = "Opponent 2"; p4.score = 300; p4.goals = 1; p4.isLocal = false; p4.teamIndex = 1;
-            
-            postMatch.players = { p1, p2, p3, p4 };
+        ToggleTestOverlay();
+    }, "Toggle the SuiteSpot test overlay", PERMISSION_ALL);
+
+    // The ss_bench_* commands run on the game thread and freeze it while
+    // they do, so their defaults stay small; larger sizes are opt-in through
+    // the arguments (suitespot_bench has no such limit)
+    constexpr size_t kBenchDefaultItems = 10000;
+
+    // Filter engine scaling benchmark: ss_bench_filter [maxThreads] [sizes...]
+    cvarManager->registerNotifier("ss_bench_filter", [this](std::vector<std::string> args) {
+        size_t maxThreads = prejumpFilterEngine ? prejumpFilterEngine->GetConcurrency() : 1;
+        std::vector<size_t> sizes;
+        try {
+            if (args.size() > 1) maxThreads = static_cast<size_t>(std::max(1, std::stoi(args[1])));
+            for (size_t i = 2; i < args.size(); ++i) {
+                sizes.push_back(static_cast<size_t>(std::stoul(args[i])));
+            }
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_filter [maxThreads] [sizes...]");
+            return;
         }
-        
-        if (!postMatch.active) {
-            postMatch.start = std::chrono::steady_clock::now();
-            postMatch.active = true;
-            postMatchOverlayWindow->Open();
-            LOG("SuiteSpot: Test overlay ACTIVATED via ss_testoverlay");
+        // The default stops at real catalog scale
+        if (sizes.empty()) sizes = { kBenchDefaultItems, 100000 };
+
+        LOG("SuiteSpot: Running filter benchmark (up to {} threads)...", maxThreads);
+        for (const auto& result : RunFilterScalingBenchmark(sizes, maxThreads)) {
+            LOG("SuiteSpot: " + FormatBenchmarkResult(result));
+        }
+    }, "Benchmark catalog filter throughput and thread scaling", PERMISSION_ALL);
+
+    // Catalog allocation benchmark: ss_bench_catalog [packs]
+    cvarManager->registerNotifier("ss_bench_catalog", [](std::vector<std::string> args) {
+        size_t packs = kBenchDefaultItems;
+        try {
+            if (args.size() > 1) packs = static_cast<size_t>(std::stoul(args[1]));
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_catalog [packs]");
+            return;
+        }
+
+        LOG("SuiteSpot: Running catalog allocation benchmark ({} packs)...", packs);
+        for (const auto& result : RunCatalogAllocationBenchmark(packs)) {
+            LOG("SuiteSpot: " + FormatCatalogBenchmarkResult(result));
+        }
+    }, "Compare per-string heap allocation with the catalog arena", PERMISSION_ALL);
+
+    // Catalog file parse/write and workshop scan cost: ss_bench_io [packs] [folders]
+    cvarManager->registerNotifier("ss_bench_io", [](std::vector<std::string> args) {
+        size_t packs = kBenchDefaultItems;
+        size_t folders = 200;
+        try {
+            if (args.size() > 1) packs = static_cast<size_t>(std::stoul(args[1]));
+            if (args.size() > 2) folders = static_cast<size_t>(std::stoul(args[2]));
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_io [packs] [folders]");
+            return;
+        }
+
+        LOG("SuiteSpot: Running catalog I/O benchmark ({} packs, {} workshop folders)...", packs, folders);
+        for (const auto& result : RunCatalogIOBenchmark(packs)) {
+            LOG("SuiteSpot: " + FormatBenchmarkResult(result));
+        }
+        std::error_code ec;
+        const auto root = std::filesystem::temp_directory_path(ec) / "SuiteSpotBenchWorkshop";
+        if (!ec && folders > 0) {
+            for (const auto& result : RunWorkshopDiscoveryBenchmark(root, folders)) {
+                LOG("SuiteSpot: " + FormatBenchmarkResult(result));
+            }
+        }
+    }, "Benchmark catalog file loads/saves and workshop discovery on synthetic data", PERMISSION_ALL);
+
+    // Learned delays: ss_adaptive_delays [reset]
+    cvarManager->registerNotifier("ss_adaptive_delays", [this](std::vector<std::string> args) {
+        if (args.size() > 1 && args[1] == "reset") {
+            adaptiveDelayTable.Clear();
+            SaveAdaptiveDelays();
+            LOG("SuiteSpot: Learned delays cleared; configured delays apply again");
+            return;
+        }
+        if (adaptiveDelayTable.Entries().empty()) {
+            LOG("SuiteSpot: No learned delays yet (suitespot_adaptive_delays is {})", adaptiveDelaysEnabled ? "on" : "off");
+            return;
+        }
+        for (const auto& [key, entry] : adaptiveDelayTable.Entries()) {
+            LOG("SuiteSpot: {}: {:.2f}s (floor {:.2f}s, {} ok, {} not accepted)", key, entry.delaySec, entry.floorSec,
+                entry.successes, entry.failures);
+        }
+    }, "List (or reset) the learned post-match delays", PERMISSION_ALL);
+
+    // Post-match latency percentiles: ss_latency [freeplay|training|workshop|reset]
+    cvarManager->registerNotifier("ss_latency", [this](std::vector<std::string> args) {
+        const std::string arg = args.size() > 1 ? args[1] : "";
+        if (arg == "reset") {
+            postMatchLatency.Reset();
+            LOG("SuiteSpot: Latency histograms cleared");
+            return;
+        }
+
+        const auto snapshot = postMatchLatency.GetSnapshot();
+        bool shown = false;
+        for (size_t m = 0; m < snapshot.size(); ++m) {
+            const auto mode = static_cast<LatencyMode>(m);
+            if (!arg.empty() && arg != LatencyModeName(mode)) continue;
+            shown = true;
+            const auto& stats = snapshot[m];
+            LOG("SuiteSpot: {} - {} matches, {} steps started at fallback", LatencyModeName(mode), stats.matches, stats.fallbacks);
+            for (size_t st = 0; st < stats.stages.size(); ++st) {
+                const auto stage = static_cast<LatencyStage>(st);
+                if (stats.Get(stage).Count() == 0) continue;
+                LOG("SuiteSpot:   " + FormatLatencyHistogram(LatencyStageName(stage), stats.Get(stage)));
+            }
+        }
+        if (!shown) {
+            LOG("SuiteSpot: Usage: ss_latency [freeplay|training|workshop|reset]");
+        }
+    }, "Show match-end to map-loaded/queue latency percentiles per mode", PERMISSION_ALL);
+
+    // Match history aggregates: ss_history [playlist]
+    cvarManager->registerNotifier("ss_history", [this](std::vector<std::string> args) {
+        if (!matchHistory.IsOpen()) {
+            LOG("SuiteSpot: Match history is unavailable");
+            return;
+        }
+        // Playlist names have spaces; match them case-insensitively
+        std::string filter;
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (!filter.empty()) filter += ' ';
+            filter += args[i];
+        }
+        auto lower = [](std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return s;
+        };
+        filter = lower(filter);
+
+        if (filter.empty()) {
+            LOG("SuiteSpot: " + FormatMatchAggregate("All playlists", matchHistory.Stats()));
+        }
+        bool shown = filter.empty();
+        for (const auto& playlist : matchHistory.Playlists()) {
+            if (!filter.empty() && lower(playlist.name) != filter) continue;
+            shown = true;
+            LOG("SuiteSpot: " + FormatMatchAggregate(playlist.name, playlist.stats));
+        }
+        if (!shown) {
+            LOG("SuiteSpot: No matches recorded for '{}'. Usage: ss_history [playlist]", filter);
+        }
+    }, "Show win rate, goals and MVP rate per playlist from the match history", PERMISSION_ALL);
+
+    // Stat sampler cost: ss_timeline
+    cvarManager->registerNotifier("ss_timeline", [this](std::vector<std::string> args) {
+        const StatSamplerCost cost = statSampler.Cost();
+        LOG("SuiteSpot: Match timeline {} - {} samples, mean {:.1f} us, max {:.1f} us, {} over the {} us budget, sampling every {:.0f} s",
+            matchTimelineEnabled ? "on" : "off (suitespot_match_timeline 1)", cost.samples, cost.MeanUs(), cost.maxNs / 1000.0,
+            cost.overBudget, std::chrono::duration_cast<std::chrono::microseconds>(MatchStatSampler::kBudget).count(), cost.intervalSec);
+    }, "Show the in-match stat sampler's per-sample cost", PERMISSION_ALL);
+
+    // Scoped-marker profiler: ss_profiler [on|off|reset|dump]
+    cvarManager->registerNotifier("ss_profiler", [this](std::vector<std::string> args) {
+#if SUITESPOT_PROFILING
+        Profiler& profiler = Profiler::Get();
+        const std::string action = args.size() > 1 ? args[1] : "";
+        if (action.empty()) {
+            // Opening the window starts recording; closing it leaves recording as is
+            profiler.SetEnabled(true);
+            profilerWindowToggle.store(true);
+        } else if (action == "on" || action == "off") {
+            profiler.SetEnabled(action == "on");
+            LOG("SuiteSpot: Profiler recording {}", action);
+        } else if (action == "reset") {
+            profiler.Reset();
+            LOG("SuiteSpot: Profiler reset");
+        } else if (action == "dump") {
+            for (const auto& site : profiler.Stats()) {
+                LOG("SuiteSpot: {} - {} calls, p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us, last frame {}x {:.1f} us, {} allocs ({} bytes), peak {} allocs ({} bytes)",
+                    site.name, site.calls, site.p50Us, site.p99Us, site.maxUs, site.callsLastFrame, site.lastFrameUs,
+                    site.allocsLastFrame, site.bytesLastFrame, site.peakAllocsPerFrame, site.peakBytesPerFrame);
+            }
         } else {
-            postMatch.active = false;
-            postMatchOverlayWindow->Close();
-            LOG("SuiteSpot: Test overlay DEACTIVATED via ss_testoverlay");
+            LOG("SuiteSpot: Usage: ss_profiler [on|off|reset|dump]");
         }
-    }, "Toggle the SuiteSpot test overlay", PERMISSION_ALL);
+#else
+        LOG("SuiteSpot: Built without profiling markers (rebuild with SUITESPOT_PROFILING=1)");
+#endif
+    }, "Open the profiler window, or turn recording on/off, reset or dump per-marker timings", PERMISSION_ALL);
+
+    // Trace-event capture: ss_trace start|stop [file]
+    cvarManager->registerNotifier("ss_trace", [this](std::vector<std::string> args) {
+        TraceRecorder& recorder = TraceRecorder::Get();
+        const std::string action = args.size() > 1 ? args[1] : "";
+        // Paths have spaces
+        std::string pathArg;
+        for (size_t i = 2; i < args.size(); ++i) {
+            if (!pathArg.empty()) pathArg += ' ';
+            pathArg += args[i];
+        }
+        if (!pathArg.empty()) {
+            traceFilePath = ExpandEnvAndHome(StripQuotes(Trim(pathArg)));
+            if (traceFilePath.is_relative()) traceFilePath = GetSuiteTrainingDir() / traceFilePath;
+        }
+
+        if (action == "start") {
+            if (!recorder.Start()) {
+                LOG("SuiteSpot: Trace already recording ({} events); ss_trace stop [file] writes it", recorder.SessionEvents());
+                return;
+            }
+            LOG("SuiteSpot: Trace recording (up to {} events); ss_trace stop [file] writes it", TraceRecorder::kMaxSessionEvents);
+        } else if (action == "stop") {
+            EnsureDataDirectories();
+            const std::filesystem::path path = traceFilePath.empty() ? GetTraceFilePath() : traceFilePath;
+            const bool stopped = recorder.Stop(path, [](const TraceWriteResult& result) {
+                if (result.ok) {
+                    LOG("SuiteSpot: Wrote {} trace events to {} ({} dropped); open it in ui.perfetto.dev or chrome://tracing",
+                        result.events, result.path.string(), result.dropped);
+                } else {
+                    WARNLOG("SuiteSpot: Could not write trace to {}: {}", result.path.string(), result.error);
+                }
+            });
+            if (!stopped) {
+                LOG("SuiteSpot: No trace is recording. Usage: ss_trace start|stop [file]");
+            }
+        } else {
+            LOG("SuiteSpot: Trace {}. Usage: ss_trace start|stop [file]",
+                recorder.Recording() ? "recording (" + std::to_string(recorder.SessionEvents()) + " events)" : "not recording");
+        }
+    }, "Record trace events from the plugin's hot paths and write them as a Chrome/Perfetto trace", PERMISSION_ALL);
+
+    // Post-match overlay frame cost: ss_bench_overlay [frames]
+    cvarManager->registerNotifier("ss_bench_overlay", [](std::vector<std::string> args) {
+        size_t frames = kBenchDefaultItems;
+        try {
+            if (args.size() > 1) frames = static_cast<size_t>(std::stoul(args[1]));
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_overlay [frames]");
+            return;
+        }
+
+        LOG("SuiteSpot: Running overlay frame benchmark ({} frames)...", frames);
+        for (const auto& result : RunOverlayFrameBenchmark(frames)) {
+            LOG("SuiteSpot: {} ({:.3f} us/frame)", FormatBenchmarkResult(result), result.millis * 1000.0 / result.items);
+        }
+    }, "Benchmark per-frame CPU cost of the post-match overlay", PERMISSION_ALL);
+
+    // Render-path allocations per frame, checked against budgets: ss_bench_allocs [frames]
+    cvarManager->registerNotifier("ss_bench_allocs", [](std::vector<std::string> args) {
+        if (!AllocTrackingEnabled()) {
+            LOG("SuiteSpot: Allocation tracking is not built in (rebuild with SUITESPOT_ALLOC_TRACKING=1)");
+            return;
+        }
+        size_t frames = 1000;
+        try {
+            if (args.size() > 1) frames = static_cast<size_t>(std::stoul(args[1]));
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_allocs [frames]");
+            return;
+        }
+
+        size_t failed = 0;
+        for (const auto& result : RunRenderAllocationBenchmark(frames)) {
+            if (result.Passed()) {
+                LOG("SuiteSpot: {}", FormatAllocationBenchmarkResult(result));
+            } else {
+                ++failed;
+                WARNLOG("SuiteSpot: {}", FormatAllocationBenchmarkResult(result));
+            }
+        }
+        LOG("SuiteSpot: Allocation budgets {}", failed == 0 ? "met" : std::to_string(failed) + " exceeded");
+    }, "Count heap allocations per frame in the overlay render paths and check them against their budgets", PERMISSION_ALL);
+
+    // Font atlas memory and bake time, bitmap vs SDF: ss_bench_fontatlas [ttf]
+    cvarManager->registerNotifier("ss_bench_fontatlas", [this](std::vector<std::string> args) {
+        const std::string pathArg = args.size() > 1 ? args[1] : "%WINDIR%\\Fonts\\segoeui.ttf";
+        const std::filesystem::path path = ExpandEnvAndHome(StripQuotes(Trim(pathArg)));
+        std::ifstream in(path.string(), std::ios::binary);
+        if (!in.is_open()) {
+            LOG("SuiteSpot: Could not open font '{}'. Usage: ss_bench_fontatlas [ttf]", path.string());
+            return;
+        }
+        const std::vector<uint8_t> ttf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        const std::vector<float> sizes = { mainFontSize, headerFontSize, teamHeaderFontSize, mainFontSize * mvpCheckmarkSize };
+        LOG("SuiteSpot: Running font atlas benchmark ({})...", path.filename().string());
+        for (const auto& result : RunFontAtlasBenchmark(ttf, sizes)) {
+            LOG("SuiteSpot: " + FormatFontAtlasBenchmarkResult(result));
+        }
+    }, "Compare per-size bitmap font atlases with a single SDF atlas", PERMISSION_ALL);
+
+    // Shuffle draw cost at bag scale: ss_bench_shuffle [bagSize]
+    cvarManager->registerNotifier("ss_bench_shuffle", [](std::vector<std::string> args) {
+        size_t bagSize = kBenchDefaultItems;
+        try {
+            if (args.size() > 1) bagSize = static_cast<size_t>(std::stoul(args[1]));
+        } catch (...) {
+            LOG("SuiteSpot: Usage: ss_bench_shuffle [bagSize]");
+            return;
+        }
+
+        LOG("SuiteSpot: Running shuffle benchmark ({} packs)...", bagSize);
+        for (const auto& result : RunShuffleBenchmark(bagSize)) {
+            LOG("SuiteSpot: " + FormatBenchmarkResult(result));
+        }
+    }, "Benchmark shuffle rotation builds and draws", PERMISSION_ALL);
+
+    // Manual shuffle weight: ss_shuffle_weight <code> <weight> (1 = default)
+    cvarManager->registerNotifier("ss_shuffle_weight", [this](std::vector<std::string> args) {
+        const auto code = args.size() > 2 ? TrainingCode::Parse(args[1]) : std::nullopt;
+        double weight = 1.0;
+        try {
+            if (code) weight = std::stod(args[2]);
+        } catch (...) {
+            weight = -1.0;
+        }
+        if (!code || weight <= 0.0) {
+            LOG("SuiteSpot: Usage: ss_shuffle_weight <code> <weight>");
+            return;
+        }
+        shuffleScheduler.SetManualWeight(*code, weight);
+        SaveShuffleState();
+        LOG("SuiteSpot: Shuffle weight for {} set to {:.2f} (applies from the next rotation)", code->ToString(),
+            shuffleScheduler.GetManualWeight(*code));
+    }, "Set a manual shuffle weight for a training pack (used when suitespot_shuffle_weighting is 3)", PERMISSION_ALL);
+
+    // Bulk shuffle bag edits: one validation pass, one SaveShuffleBag per command
+    cvarManager->registerNotifier("ss_bag_add", [this](std::vector<std::string> args) {
+        if (args.size() < 2) {
+            LOG("SuiteSpot: Usage: ss_bag_add <code> [code ...]");
+            return;
+        }
+        std::string text;
+        for (size_t i = 1; i < args.size(); ++i) {
+            text += args[i];
+            text += '\n';
+        }
+        ApplyBulkShuffleAdd(ParseBulkText(text), "ss_bag_add");
+    }, "Add one or more training pack codes to the shuffle bag", PERMISSION_ALL);
+
+    cvarManager->registerNotifier("ss_bag_import", [this](std::vector<std::string> args) {
+        std::string text;
+        std::filesystem::path path;
+        if (args.size() < 2) {
+            LOG("SuiteSpot: Usage: ss_bag_import <file> (lines of code[,name])");
+            return;
+        }
+        if (!ReadBulkImportFile(args[1], text, path)) {
+            LOG("SuiteSpot: ss_bag_import: cannot read {}", path.string());
+            return;
+        }
+        ApplyBulkShuffleAdd(ParseBulkText(text), "ss_bag_import");
+    }, "Add every pack listed in a file to the shuffle bag", PERMISSION_ALL);
+
+    cvarManager->registerNotifier("ss_training_import", [this](std::vector<std::string> args) {
+        std::string text;
+        std::filesystem::path path;
+        if (args.size() < 2) {
+            LOG("SuiteSpot: Usage: ss_training_import <file> (lines of code[,name[,Shots:N]])");
+            return;
+        }
+        if (!ReadBulkImportFile(args[1], text, path)) {
+            LOG("SuiteSpot: ss_training_import: cannot read {}", path.string());
+            return;
+        }
+        ApplyBulkTrainingImport(ParseBulkText(text), "ss_training_import");
+    }, "Add every pack listed in a file to the saved training list", PERMISSION_ALL);
+
+    // ss_bag_from_query <query>: same language as the Prejump browser's Query box
+    cvarManager->registerNotifier("ss_bag_from_query", [this](std::vector<std::string> args) {
+        std::string text;
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (i > 1) text += ' ';
+            text += args[i];
+        }
+        if (Trim(text).empty()) {
+            LOG("SuiteSpot: Usage: ss_bag_from_query <query> (e.g. ss_bag_from_query diff:gold..champion shots>=10)");
+            return;
+        }
+
+        PackFilterCriteria criteria;
+        criteria.query = prejumpQueryCache.Get(text);
+        if (!criteria.query->IsValid()) {
+            LOG("SuiteSpot: ss_bag_from_query: {}", criteria.query->GetError());
+            return;
+        }
+        if (!prejumpFilterEngine) {
+            prejumpFilterEngine = std::make_unique<PackFilterEngine>();
+        }
+
+        std::vector<int> rows;
+        try {
+            rows = prejumpFilterEngine->Run(prejumpPacks, criteria);
+        } catch (const std::exception& e) {
+            ERRORLOG("SuiteSpot: ss_bag_from_query: filter failed: {}", e.what());
+            return;
+        }
+
+        BulkImportResult matches;
+        for (int row : rows) {
+            const TrainingEntry& pack = prejumpPacks[row];
+            ++matches.lines;
+            if (const auto code = TrainingCode::Parse(pack.code)) {
+                matches.entries.push_back({ *code, std::string(pack.name), pack.shotCount, row + 1 });
+            } else {
+                ++matches.invalid;
+            }
+        }
+        LOG("SuiteSpot: ss_bag_from_query: {} Prejump pack(s) match '{}'", matches.lines, text);
+        ApplyBulkShuffleAdd(matches, "ss_bag_from_query");
+    }, "Add every Prejump pack matching a browser query to the shuffle bag", PERMISSION_ALL);
 
     // Enable/Disable plugin
     cvarManager->registerCvar("suitespot_enabled", "0", "Enable SuiteSpot", true, true, 0, true, 1)
@@ -1155,29 +1839,81 @@ void SuiteSpot::onLoad() {
             trainingShuffleEnabled = cvar.getBoolValue();
         });
 
+    // Shuffle weighting: 0=Uniform, 1=Likes, 2=Plays, 3=Manual (ss_shuffle_weight)
+    cvarManager->registerCvar("suitespot_shuffle_weighting", std::to_string(static_cast<int>(shuffleScheduler.GetWeightMode())),
+        "Shuffle weighting: 0=Uniform, 1=Likes, 2=Plays, 3=Manual", true, true, 0, true, 3)
+        .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
+            const auto mode = static_cast<ShuffleScheduler::WeightMode>(cvar.getIntValue());
+            if (mode == shuffleScheduler.GetWeightMode()) return;
+            shuffleScheduler.SetWeightMode(mode);
+            SaveShuffleState();
+        });
+
     // Training shuffle bag size (legacy; now reflects selected count)
-    cvarManager->registerCvar("suitespot_training_bag_size", "0", "Shuffle bag size (legacy, reflects selected count)", true, true, 0, true, 1000)
+    cvarManager->registerCvar("suitespot_training_bag_size", "0", "Shuffle bag size (legacy, reflects selected count)", true, true, 0, false, 0)
         .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
             trainingBagSize = cvar.getIntValue();
         });
 
+    // Adaptive delays: learned per mode and playlist, configured delays are the starting point
+    cvarManager->registerCvar("suitespot_adaptive_delays", "0", "Learn the shortest reliable load/queue delays (ss_adaptive_delays)", true, true, 0, true, 1)
+        .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
+            adaptiveDelaysEnabled = cvar.getBoolValue();
+        });
+
+    // In-match stat timeline on the post-match overlay (opt-in)
+    cvarManager->registerCvar("suitespot_match_timeline", "0", "Sample player stats during matches for the post-match timeline (ss_timeline)", true, true, 0, true, 1)
+        .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
+            matchTimelineEnabled = cvar.getBoolValue();
+            if (matchTimelineEnabled) {
+                ScheduleStatSample();
+            } else {
+                timerWheel.CancelKey("stats.sample");
+            }
+        });
+
+    // Logging: 0=trace 1=debug 2=info 3=warn 4=error 5=off
+    cvarManager->registerCvar("suitespot_log_level", "2", "Lowest log level shown: 0=trace 1=debug 2=info 3=warn 4=error 5=off", true, true, 0, true, 5)
+        .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
+            logLevel = std::clamp(cvar.getIntValue(), 0, static_cast<int>(LogLevel::Off));
+            GlobalLogger().SetLevel(static_cast<LogLevel>(logLevel));
+        });
+
+    cvarManager->registerCvar("suitespot_log_file", "0", "Also write the log to SuiteTraining\\SuiteSpot.log (rotating)", true, true, 0, true, 1)
+        .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
+            logToFile = cvar.getBoolValue();
+            GlobalLogger().SetFile(logToFile ? GetLogFilePath() : std::filesystem::path());
+        });
+
+    // Per-mode loadout rules: preset name to equip as the post-match load/queue goes out
+    for (size_t i = 0; i < kLoadoutRuleCount; ++i) {
+        const auto rule = static_cast<LoadoutRule>(i);
+        cvarManager->registerCvar(std::string("suitespot_loadout_") + LoadoutRuleName(rule), "",
+            std::string("Loadout preset to equip for ") + LoadoutRuleName(rule) + " (empty = keep current)", true, false, 0, false, 0)
+            .addOnValueChanged([this, rule](string oldValue, CVarWrapper cvar) {
+                if (loadoutManager) {
+                    loadoutManager->SetRule(rule, cvar.getStringValue());
+                }
+            });
+    }
+
     // Delay settings (in seconds)
-    cvarManager->registerCvar("suitespot_delay_queue_sec", "0", "Delay before queuing (seconds)", true, true, 0, true, 300)
+    cvarManager->registerCvar("suitespot_delay_queue_sec", "0", "Longest wait before queuing (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
             delayQueueSec = std::max(0, cvar.getIntValue());
         });
 
-    cvarManager->registerCvar("suitespot_delay_freeplay_sec", "0", "Delay before loading freeplay map (seconds)", true, true, 0, true, 300)
+    cvarManager->registerCvar("suitespot_delay_freeplay_sec", "0", "Longest wait before loading freeplay map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
             delayFreeplaySec = std::max(0, cvar.getIntValue());
         });
 
-    cvarManager->registerCvar("suitespot_delay_training_sec", "0", "Delay before loading training map (seconds)", true, true, 0, true, 300)
+    cvarManager->registerCvar("suitespot_delay_training_sec", "0", "Longest wait before loading training map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
             delayTrainingSec = std::max(0, cvar.getIntValue());
         });
 
-    cvarManager->registerCvar("suitespot_delay_workshop_sec", "0", "Delay before loading workshop map (seconds)", true, true, 0, true, 300)
+    cvarManager->registerCvar("suitespot_delay_workshop_sec", "0", "Longest wait before loading workshop map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](string oldValue, CVarWrapper cvar) {
             delayWorkshopSec = std::max(0, cvar.getIntValue());
         });
@@ -1222,9 +1958,13 @@ void SuiteSpot::onLoad() {
     cvarManager->getCvar("suitespot_map_type").setValue(mapType);
     cvarManager->getCvar("suitespot_auto_queue").setValue(autoQueue ? 1 : 0);
     cvarManager->getCvar("suitespot_training_shuffle").setValue(trainingShuffleEnabled ? 1 : 0);
-    trainingBagSize = static_cast<int>(trainingShuffleBag.size());
+    trainingBagSize = static_cast<int>(trainingShuffleBag.Size());
     cvarManager->getCvar("suitespot_training_bag_size").setValue(trainingBagSize);
     cvarManager->getCvar("suitespot_delay_queue_sec").setValue(delayQueueSec);
+    cvarManager->getCvar("suitespot_adaptive_delays").setValue(adaptiveDelaysEnabled ? 1 : 0);
+    cvarManager->getCvar("suitespot_match_timeline").setValue(matchTimelineEnabled ? 1 : 0);
+    cvarManager->getCvar("suitespot_log_level").setValue(logLevel);
+    cvarManager->getCvar("suitespot_log_file").setValue(logToFile ? 1 : 0);
     cvarManager->getCvar("suitespot_delay_freeplay_sec").setValue(delayFreeplaySec);
     cvarManager->getCvar("suitespot_delay_training_sec").setValue(delayTrainingSec);
     cvarManager->getCvar("suitespot_delay_workshop_sec").setValue(delayWorkshopSec);
@@ -1245,7 +1985,11 @@ void SuiteSpot::onLoad() {
 
 
 
-void SuiteSpot::RenderPostMatchOverlay() {
+// postMatch is the snapshot the caller read this frame; reading the buffer
+// again here could swap in a newer match than the window was sized for
+void SuiteSpot::RenderPostMatchOverlay(const PostMatchInfo& postMatch) {
+    SS_PROFILE_SCOPE("RenderPostMatchOverlay");
+    SS_TRACE_SCOPE("render", "RenderPostMatchOverlay");
     if (!ImGui::GetCurrentContext()) {
         if (imguiCtx) {
             ImGui::SetCurrentContext(imguiCtx);
@@ -1258,9 +2002,8 @@ void SuiteSpot::RenderPostMatchOverlay() {
     const auto now = std::chrono::steady_clock::now();
     const float elapsed = std::chrono::duration<float>(now - postMatch.start).count();
     
-    // Auto-hide after duration
-    if (postMatch.active && elapsed >= postMatchDurationSec) {
-        postMatch.active = false;
+    // Auto-hide after duration (or when a hide was published)
+    if (!postMatch.active || elapsed >= postMatchDurationSec) {
         if (postMatchOverlayWindow) {
             postMatchOverlayWindow->Close();
         }
@@ -1277,148 +2020,165 @@ void SuiteSpot::RenderPostMatchOverlay() {
         }
     }
 
-    ImVec2 display = ImGui::GetIO().DisplaySize;
-    const ImVec2 overlaySize = ImVec2(std::max(400.0f, overlayWidth), std::max(180.0f, overlayHeight));
-    ImVec2 pos = ImVec2((display.x - overlaySize.x) * 0.5f + overlayOffsetX, display.y * 0.08f + overlayOffsetY);
-
-    ImDrawList* dl = ImGui::GetWindowDrawList();
-    ImVec2 winPos = pos; // Use pos as start for drawing since we are in the overlay window context
-    ImVec2 winSize = overlaySize;
-    ImVec2 winEnd = ImVec2(winPos.x + winSize.x, winPos.y + winSize.y);
-
-    // Set window pos and size for the draw list if needed, but since we are called inside Begin/End 
-    // of PostMatchOverlayWindow::Render(), the draw list coordinates are usually absolute or relative to window.
-    // However, PostMatchOverlayWindow::Render() calls SetNextWindowPos/Size.
-    
-    // Let's adjust to use window pos
-    winPos = ImGui::GetWindowPos();
-    winSize = ImGui::GetWindowSize();
-    winEnd = ImVec2(winPos.x + winSize.x, winPos.y + winSize.y);
-
-    // Draw background
-    ImU32 baseBg = ImGui::GetColorU32(ImVec4(0.f, 0.f, 0.f, backgroundAlpha * alpha));
-    dl->AddRectFilled(winPos, winEnd, baseBg, 8.0f);
-    
-    // Draw header
-    ImU32 headerBg = ImGui::GetColorU32(ImVec4(0.f, 0.f, 0.f, headerAlpha * alpha));
-    dl->AddRectFilled(winPos, ImVec2(winEnd.x, winPos.y + 34.0f), headerBg, 8.0f);
-    
-    // Title
-    ImU32 titleColor = ImGui::GetColorU32(ImVec4(1.f, 1.f, 1.f, alpha));
-    std::string title = "MATCH COMPLETE";
-    if (postMatch.overtime) title += " - OVERTIME";
-    dl->AddText(ImGui::GetFont(), teamHeaderFontSize, ImVec2(winPos.x + 12.0f, winPos.y + 8.0f), titleColor, title.c_str());
-    
-    // Match info line
-    std::string matchInfo = postMatch.playlist + " | " + postMatch.myTeamName + " " + 
-                           std::to_string(postMatch.myScore) + " - " + 
-                           std::to_string(postMatch.oppScore) + " " + postMatch.oppTeamName;
-    
-    dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + 12.0f, winPos.y + 45.0f), titleColor, matchInfo.c_str());
-    
-    // Column headers if enabled
-    float contentY = winPos.y + 70.0f;
-    if (showColumnHeaders) {
-        ImU32 headerTextColor = ImGui::GetColorU32(ImVec4(0.7f, 0.7f, 0.7f, alpha));
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + nameColumnX, contentY), headerTextColor, "Player");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + scoreColumnX, contentY), headerTextColor, "Score");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + goalsColumnX, contentY), headerTextColor, "Goals");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + assistsColumnX, contentY), headerTextColor, "Assists");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + savesColumnX, contentY), headerTextColor, "Saves");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + shotsColumnX, contentY), headerTextColor, "Shots");
-        dl->AddText(ImGui::GetFont(), headerFontSize, ImVec2(winPos.x + pingColumnX, contentY), headerTextColor, "Ping");
-        contentY += playerRowHeight;
+    // Positions are relative to the overlay window, which
+    // PostMatchOverlayWindow::Render() has already placed and sized
+    const ImVec2 winPos = ImGui::GetWindowPos();
+    const ImVec2 winSize = ImGui::GetWindowSize();
+
+    // Lay out once per snapshot/setting change; frames only apply the fade.
+    // The timeline strip, when there is one, sits below the layout.
+    const float timelineHeight = GetOverlayTimelineHeight(postMatch);
+    const PostMatchLayoutStyle style = GetOverlayLayoutStyle(winSize.x, winSize.y - timelineHeight);
+    if (!postMatchLayout.IsCurrent(postMatch.sequence, style)) {
+        postMatchLayout.Build(postMatch, style);
     }
-    
-    // Render players by team
-    for (int teamIdx = 0; teamIdx <= 1; teamIdx++) {
-        // Team header
-        bool isMyTeam = false;
-        for (const auto& p : postMatch.players) {
-            if (p.isLocal && p.teamIndex == teamIdx) {
-                isMyTeam = true;
-                break;
-            }
-        }
-        
-        std::string teamName = isMyTeam ? postMatch.myTeamName : postMatch.oppTeamName;
-        int teamScore = isMyTeam ? postMatch.myScore : postMatch.oppScore;
-        
-        // Team section
-        ImU32 teamColor;
-        auto hsvToRgb = [](float h, float s, float v, float a) -> ImVec4 {
-            float c = v * s;
-            float x = c * (1 - abs(fmod(h / 60.0f, 2) - 1));
-            float m = v - c;
-            float r = 0, g = 0, b = 0;
-            if (h < 60) { r = c; g = x; b = 0; }
-            else if (h < 120) { r = x; g = c; b = 0; }
-            else if (h < 180) { r = 0; g = c; b = x; }
-            else if (h < 240) { r = 0; g = x; b = c; }
-            else if (h < 300) { r = x; g = 0; b = c; }
-            else { r = c; g = 0; b = x; }
-            return ImVec4(r + m, g + m, b + m, a);
-        };
 
-        if (teamIdx == 0) {
-            teamColor = ImGui::GetColorU32(hsvToRgb(blueTeamHue, blueTeamSat, blueTeamVal, alpha));
-        } else {
-            teamColor = ImGui::GetColorU32(hsvToRgb(orangeTeamHue, orangeTeamSat, orangeTeamVal, alpha));
+    struct DrawListSink {
+        ImDrawList* dl;
+        ImFont* font;
+        ImVec2 origin;
+
+        void Rect(const OverlayDrawItem& item, uint32_t color) {
+            dl->AddRectFilled(ImVec2(origin.x + item.x0, origin.y + item.y0), ImVec2(origin.x + item.x1, origin.y + item.y1), color, item.size);
         }
-        
-        std::string teamHeader = teamName;
-        if (showTeamScores) {
-            teamHeader += " - " + std::to_string(teamScore);
+        void Text(const OverlayDrawItem& item, const char* begin, const char* end, uint32_t color) {
+            dl->AddText(font, item.size, ImVec2(origin.x + item.x0, origin.y + item.y0), color, begin, end);
         }
-        
-        dl->AddRectFilled(ImVec2(winPos.x + sectionPadding, contentY), 
-                         ImVec2(winEnd.x - sectionPadding, contentY + teamHeaderHeight), 
-                         teamColor, 4.0f);
-        dl->AddText(ImGui::GetFont(), teamHeaderFontSize, ImVec2(winPos.x + nameColumnX, contentY + 4.0f), titleColor, teamHeader.c_str());
-        contentY += teamHeaderHeight + 4.0f;
-        
-        // Players in this team
-        for (const auto& player : postMatch.players) {
-            if (player.teamIndex != teamIdx) continue;
-            
-            ImU32 playerColor = player.isMVP && showMvpGlow ? 
-                              ImGui::GetColorU32(ImVec4(1.f, 0.84f, 0.f, alpha)) : titleColor;
-            
-            // MVP indicator
-            if (player.isMVP) {
-                dl->AddText(ImGui::GetFont(), mainFontSize * mvpCheckmarkSize, 
-                           ImVec2(winPos.x + nameColumnX - 20.0f, contentY), 
-                           ImGui::GetColorU32(ImVec4(1.f, 0.84f, 0.f, alpha)), "★");
-            }
-            
-            // Player stats
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + nameColumnX, contentY), playerColor, player.name.c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + scoreColumnX, contentY), playerColor, std::to_string(player.score).c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + goalsColumnX, contentY), playerColor, std::to_string(player.goals).c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + assistsColumnX, contentY), playerColor, std::to_string(player.assists).c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + savesColumnX, contentY), playerColor, std::to_string(player.saves).c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + shotsColumnX, contentY), playerColor, std::to_string(player.shots).c_str());
-            dl->AddText(ImGui::GetFont(), mainFontSize, ImVec2(winPos.x + pingColumnX, contentY), playerColor, std::to_string(player.ping).c_str());
-            
-            contentY += playerRowHeight;
-        }
-        
-        contentY += teamSectionSpacing;
+    };
+    DrawListSink sink{ ImGui::GetWindowDrawList(), ImGui::GetFont(), winPos };
+    // GetColorU32 used to fold in the global style alpha; keep doing so
+    postMatchLayout.Emit(alpha * ImGui::GetStyle().Alpha, sink);
+
+    if (timelineHeight > 0.0f) {
+        ImGui::SetCursorPos(ImVec2(style.sectionPadding, winSize.y - timelineHeight));
+        RenderOverlayTimeline(postMatch, alpha);
     }
 }
 
+namespace
+{
+    constexpr float kOverlayTimelineHeight = 90.0f;
+}
+
+float SuiteSpot::GetOverlayTimelineHeight(const PostMatchInfo& postMatch) const {
+    return matchTimelineEnabled && postMatch.timelineSession != 0 ? kOverlayTimelineHeight : 0.0f;
+}
+
+// #detailed comments: RenderOverlayTimeline
+// Purpose: Team point totals over the match, one curve per team in the
+// overlay's team colours. The session is copied out of the sampler once
+// per snapshot into a buffer sized on first use; frames only plot.
+void SuiteSpot::RenderOverlayTimeline(const PostMatchInfo& postMatch, float alpha) {
+    if (timelineSeriesSession != postMatch.timelineSession) {
+        timelineSeriesSession = postMatch.timelineSession;
+        timelineSamples.resize(MatchStatSampler::kCapacity);
+        const size_t count = statSampler.CopySession(postMatch.timelineSession, timelineSamples);
+        timelineSeries.Build({ timelineSamples.data(), count });
+    }
+    if (timelineSeries.Empty()) return;
+
+    auto teamColor = [alpha](float hue, float sat, float val) {
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB(hue / 360.0f, sat, val, r, g, b);
+        return ImGui::GetColorU32(ImVec4(r, g, b, alpha));
+    };
+    const ImU32 colors[2] = {
+        teamColor(blueTeamHue, blueTeamSat, blueTeamVal),
+        teamColor(orangeTeamHue, orangeTeamSat, orangeTeamVal),
+    };
+    auto getter = [](void* data, float x, int team) {
+        return static_cast<const StatTimelineSeries*>(data)->PointsAt(x, team);
+    };
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "points over %.0f:%02.0f", std::floor(timelineSeries.Duration() / 60.0f),
+             std::fmod(timelineSeries.Duration(), 60.0f));
+    ImGui::PushStyleVar(ImGuiStyleVar_Alpha, alpha * ImGui::GetStyle().Alpha);
+    ImGui::PlotCurve("##timeline", getter, &timelineSeries, 2, overlay,
+                     ImVec2(0.0f, std::max(100.0f, timelineSeries.maxPoints * 1.1f)),
+                     ImVec2(0.0f, std::max(1.0f, timelineSeries.Duration())),
+                     ImVec2(ImGui::GetContentRegionAvail().x, kOverlayTimelineHeight - 10.0f),
+                     nullptr, 2.0f, 0.0f, colors, 2);
+    ImGui::PopStyleVar();
+}
+
+PostMatchLayoutStyle SuiteSpot::GetOverlayLayoutStyle(float width, float height) const {
+    PostMatchLayoutStyle style;
+    style.width = width;
+    style.height = height;
+    style.teamHeaderHeight = teamHeaderHeight;
+    style.playerRowHeight = playerRowHeight;
+    style.teamSectionSpacing = teamSectionSpacing;
+    style.sectionPadding = sectionPadding;
+    style.nameColumnX = nameColumnX;
+    style.scoreColumnX = scoreColumnX;
+    style.goalsColumnX = goalsColumnX;
+    style.assistsColumnX = assistsColumnX;
+    style.savesColumnX = savesColumnX;
+    style.shotsColumnX = shotsColumnX;
+    style.pingColumnX = pingColumnX;
+    style.mainFontSize = mainFontSize;
+    style.headerFontSize = headerFontSize;
+    style.teamHeaderFontSize = teamHeaderFontSize;
+    style.blueTeamHue = blueTeamHue;
+    style.blueTeamSat = blueTeamSat;
+    style.blueTeamVal = blueTeamVal;
+    style.orangeTeamHue = orangeTeamHue;
+    style.orangeTeamSat = orangeTeamSat;
+    style.orangeTeamVal = orangeTeamVal;
+    style.backgroundAlpha = backgroundAlpha;
+    style.headerAlpha = headerAlpha;
+    style.mvpCheckmarkSize = mvpCheckmarkSize;
+    style.showMvpGlow = showMvpGlow;
+    style.showTeamScores = showTeamScores;
+    style.showColumnHeaders = showColumnHeaders;
+    return style;
+}
+
 void SuiteSpot::Render() {
+    // Repeats within a frame (RenderSettings also marks) are ignored
+    Profiler::Get().MarkFrame(ImGui::GetFrameCount());
+    if (TraceRecorder::Get().Recording()) {
+        TraceRecorder::Get().NameThread("Render");
+    }
+    SS_TRACE_SCOPE("render", "Render");
+
     // Call base class Render() which handles isWindowOpen_, ImGui::Begin/End, and calling RenderWindow() for the main control window
     PluginWindowBase::Render();
     
-    // Call Render() for the overlay window
+    // Call Render() for the overlay window. Opening and closing follow the
+    // published snapshot, so only the render thread touches the window; the
+    // buffer is read once here and the same snapshot sizes and draws it.
     if (postMatchOverlayWindow) {
-        postMatchOverlayWindow->Render();
+        const PostMatchInfo& snapshot = postMatchBuffer.Read();
+        if (snapshot.sequence != overlaySequenceSeen) {
+            overlaySequenceSeen = snapshot.sequence;
+            if (snapshot.active) {
+                postMatchOverlayWindow->Open();
+            } else {
+                postMatchOverlayWindow->Close();
+            }
+        }
+        postMatchOverlayWindow->Render(snapshot);
     }
+
+    RenderProfilerWindow();
 }
 
 void SuiteSpot::onUnload() {
     gameWrapper->UnhookEvent("Function TAGame.GameEvent_Soccar_TA.EventMatchEnded");
     gameWrapper->UnhookEvent("Function TAGame.AchievementManager_TA.HandleMatchEnded");
+    gameWrapper->UnhookEvent("Function TAGame.GFxData_MainMenu_TA.MainMenuAdded");
+    gameWrapper->UnhookEvent("Function ProjectX.EngineShare_X.EventPreLoadMap");
+    gameWrapper->UnhookEvent("Function TAGame.LoadingScreen_TA.HandlePostLoadMap");
+    gameWrapper->UnhookEvent("Function Engine.GameViewportClient.Tick");
+    timerWheel.Shutdown();
+    FlushShuffleState();  // Its timer was just cancelled
+    postMatchSequencer.CancelAll();
+    matchHistory.Close();
+    // Finishes a trace still being written
+    TraceRecorder::Get().Shutdown();
     LOG("SuiteSpot unloaded");
+    // Flushes what is queued; later LOG calls write directly
+    GlobalLogger().Stop();
 }
@@ -4,11 +4,31 @@
 #include "bakkesmod/plugin/pluginwindow.h"
 #include "bakkesmod/plugin/PluginSettingsWindow.h"
 #include "MapList.h"
+#include "AdaptiveDelay.h"
+#include "BulkImport.h"
+#include "CatalogArena.h"
+#include "LatencyStats.h"
 #include "LoadoutManager.h"
+#include "MatchEndPipeline.h"
+#include "MatchHistory.h"
+#include "MatchStatSampler.h"
+#include "PackFilter.h"
+#include "PostMatchInfo.h"
+#include "PostMatchLayout.h"
+#include "PostMatchSequencer.h"
+#include "Profiler.h"
+#include "ShuffleBag.h"
+#include "ShuffleScheduler.h"
+#include "TimerWheel.h"
+#include "TraceRecorder.h"
+#include "TrainingCode.h"
+#include "TripleBuffer.h"
 #include "version.h"
+#include <array>
 #include <filesystem>
 #include <set>
 #include <memory>
+#include <span>
 
 // Forward declarations for additional windows
 class SuiteSpotSettingsWindow2;
@@ -26,33 +46,6 @@ constexpr auto plugin_version =
     stringify(VERSION_PATCH) "."
     stringify(VERSION_BUILD);
 
-struct PostMatchPlayerRow {
-    int teamIndex = -1;
-    bool isLocal = false;
-    std::string name;
-    int score = 0;
-    int goals = 0;
-    int assists = 0;
-    int saves = 0;
-    int shots = 0;
-    int ping = 0;
-    bool isMVP = false;
-};
-
-struct PostMatchInfo {
-    bool active = false;
-    std::chrono::steady_clock::time_point start;
-    int myScore = 0;
-    int oppScore = 0;
-    std::string myTeamName;
-    std::string oppTeamName;
-    std::string playlist;
-    bool overtime = false;
-    LinearColor myColor{};
-    LinearColor oppColor{};
-    std::vector<PostMatchPlayerRow> players;
-};
-
 // NOTE: inherit from SettingsWindowBase (not “GuiBase”)
 class SuiteSpot final : public BakkesMod::Plugin::BakkesModPlugin,
                         public SettingsWindowBase,
@@ -71,7 +64,6 @@ public:
     void SaveTrainingMaps() const;
     void LoadWorkshopMaps();
     void SaveWorkshopMaps() const; // no-op (legacy)
-    void DiscoverWorkshopInDir(const std::filesystem::path& dir);
     std::filesystem::path GetWorkshopLoaderConfigPath() const;
     std::filesystem::path ResolveConfiguredWorkshopRoot() const;
 
@@ -80,6 +72,20 @@ public:
     std::filesystem::path GetShuffleBagPath() const;
     void LoadShuffleBag();
     void SaveShuffleBag() const;
+    std::filesystem::path GetShuffleStatePath() const;  // SuiteTraining\SuiteShuffleState.txt
+    void LoadShuffleState();
+    void SaveShuffleState() const;
+    void FlushShuffleState();  // Saves only when a draw moved the rotation since the last flush
+
+    // Bulk imports (ss_bag_add, ss_bag_import, ss_training_import, ss_bag_from_query):
+    // everything is parsed and validated first, then applied with a single save
+    BulkImportResult ParseBulkText(std::string_view text);
+    bool ReadBulkImportFile(const std::string& pathArg, std::string& text, std::filesystem::path& resolved) const;
+    void ApplyBulkShuffleAdd(const BulkImportResult& parsed, const std::string& command);
+    void ApplyBulkTrainingImport(const BulkImportResult& parsed, const std::string& command);
+
+    // Rebuilds the code index rows for one catalog after its vector changed
+    void ReindexTrainingCodes(TrainingCodeSource source);
 
     // File/dir utilities
     void MirrorDirectory(const std::filesystem::path& src, const std::filesystem::path& dst) const;
@@ -97,10 +103,61 @@ public:
     void Render() override;
     void RenderWindow() override;
 
+    // Every deferred plugin action (button loads, loadout init, the
+    // scraper, the post-match tick) runs from this wheel, advanced by the
+    // viewport tick hook; onUnload shuts it down so nothing fires after.
+    // Declared before loadoutManager, which cancels its timer on destruction.
+    TimerWheel timerWheel;
+    static constexpr const char* kMapLoadTimerKey = "map.load";  // A newer load supersedes a pending one
+
     // hooks
     void LoadHooks();
     void GameEndedEvent(std::string name);
 
+    // One post-match run as resolved at match end; the configured delays
+    // are the longest each step waits for its game event
+    struct PostMatchPlan {
+        std::string loadCommand;  // Empty when no map is loaded
+        std::string loadName;
+        int loadDelaySec = 0;
+        LatencyMode mode = LatencyMode::Freeplay;
+        LoadoutRule loadoutRule = LoadoutRule::Freeplay;  // Equipped as the load goes out; Queue's as the queue does
+        bool queue = false;
+        int queueDelaySec = 0;
+        bool adaptive = false;  // Use learned delays and confirm each command (suitespot_adaptive_delays)
+        std::string playlist;   // Ended match's playlist; part of the learned-delay key
+    };
+    PostMatchSequencer::Task RunPostMatchSequence(PostMatchPlan plan);
+    void SchedulePostMatchTick();
+    bool IsMatchSettled();
+    PostMatchSequencer postMatchSequencer;  // Game thread: suspended post-match sequences
+    PostMatchLatency postMatchLatency;      // Match end -> map loaded / queue timings (ss_latency)
+
+    // Learned load/queue delays, per machine (SuiteTraining\SuiteAdaptiveDelays.txt)
+    std::filesystem::path GetAdaptiveDelaysPath() const;
+    void LoadAdaptiveDelays();
+    void SaveAdaptiveDelays() const;
+    AdaptiveDelayTable adaptiveDelayTable;
+    bool adaptiveDelaysEnabled = false;
+
+    // In-match stat timeline (suitespot_match_timeline, ss_timeline)
+    void ScheduleStatSample();
+    void SampleMatchStats();
+    MatchStatSampler statSampler;
+    std::string statSamplerMatch;     // Game thread: match identity of the current session
+    bool matchTimelineEnabled = false;
+
+    // Leveled async logging (suitespot_log_level, suitespot_log_file -> SuiteTraining\SuiteSpot.log)
+    std::filesystem::path GetLogFilePath() const;
+    std::filesystem::path GetTraceFilePath() const;
+    int logLevel = static_cast<int>(LogLevel::Info);
+    bool logToFile = false;
+
+    // Every captured result (SuiteTraining\SuiteMatchHistory.log + .idx)
+    std::filesystem::path GetMatchHistoryPath() const;
+    void OpenMatchHistory();
+    MatchHistory matchHistory;
+
     // Prejump scraper integration
     std::filesystem::path GetPrejumpPacksPath() const;
     void ScrapeAndLoadPrejumpPacks();
@@ -111,12 +168,45 @@ public:
     // Prejump UI rendering
     void RenderPrejumpPacksTab();
 
+    // Latency histograms (settings tab)
+    void RenderLatencyTab();
+    int latencyPanelMode = 1;  // LatencyMode shown; training by default
+
+    // Match history (settings tab)
+    void RenderHistoryTab();
+    uint32_t historyPanelPlaylist = 0;          // MatchHistory::PlaylistHash shown; 0 = all
+    uint64_t historySelectedOffset = UINT64_MAX;  // Log offset of the expanded match
+
+    // Scoped-marker profiler window (ss_profiler)
+    void RenderProfilerWindow();
+    bool profilerWindowOpen = false;                       // Render thread
+    std::atomic<bool> profilerWindowToggle{ false };       // Game thread (ss_profiler) -> render thread
+    std::filesystem::path traceFilePath;                   // Game thread: last ss_trace file; empty = GetTraceFilePath
+
     // Post-match overlay rendering
-    void RenderPostMatchOverlay();
+    void RenderPostMatchOverlay(const PostMatchInfo& postMatch);
+    PostMatchLayoutStyle GetOverlayLayoutStyle(float width, float height) const;
+    PostMatchLayout postMatchLayout;          // Render thread: cached overlay draw list
+    float GetOverlayTimelineHeight(const PostMatchInfo& postMatch) const;  // Extra overlay height for the timeline
+    void RenderOverlayTimeline(const PostMatchInfo& postMatch, float alpha);
+    std::vector<StatSample> timelineSamples;  // Render thread: copied session, sized once
+    StatTimelineSeries timelineSeries;
+    uint64_t timelineSeriesSession = 0;
     
-    PostMatchInfo& GetPostMatchInfo() { return postMatch; }
-
-    PostMatchInfo postMatch;
+    // Game thread: show (or hide, when visible) the overlay with the last
+    // captured match, or sample data before the first match
+    void ToggleTestOverlay();
+    // Game thread: stamps sequence/active/start on the write slot and publishes it
+    void PublishPostMatch(bool active);
+
+    // Written on the game thread, read on the render thread
+    TripleBuffer<PostMatchInfo> postMatchBuffer;
+    PostMatchInfo lastCapturedMatch;          // Game thread: source for the test overlay and the history append
+    int64_t lastCapturedTime = 0;             // Game thread: unix time of lastCapturedMatch
+    uint64_t postMatchSequence = 0;           // Game thread: last published sequence
+    bool postMatchShown = false;              // Game thread: last publish was visible...
+    std::chrono::steady_clock::time_point postMatchShownAt;  // ...starting here
+    uint64_t overlaySequenceSeen = 0;         // Render thread: last sequence applied to the window
     float postMatchDurationSec = 15.0f;
 
     // Window positioning and size
@@ -188,8 +278,10 @@ private:
 
     bool trainingShuffleEnabled = false;
     int  trainingBagSize = 1;
-    std::vector<TrainingEntry> trainingShuffleBag;
-    std::set<int> selectedTrainingIndices;
+    TrainingCodeIndex trainingCodeIndex;  // Code -> row in RLTraining and prejumpPacks
+    ShuffleBag trainingShuffleBag{ trainingCodeIndex };  // Its RLTraining row bits are the training-list selection
+    ShuffleScheduler shuffleScheduler;                   // No-repeat rotation over trainingShuffleBag
+    bool shuffleStateDirty = false;                      // Game thread: draws not yet saved; a flush timer is pending
 
     std::string lastGameMode = "";
 
@@ -197,7 +289,9 @@ private:
     bool prejumpScrapingInProgress = false;
     std::string prejumpLastUpdated = "";
     int prejumpPackCount = 0;
+    std::unique_ptr<CatalogArena> prejumpArena;  // Owns prejumpPacks' strings; declared first so it outlives them
     std::vector<TrainingEntry> prejumpPacks;  // Loaded prejump packs
+    unsigned int prejumpCatalogVersion = 0;   // Bumped on every (re)load; invalidates cached browser rows
     
     // Prejump UI state
     char prejumpSearchText[256] = {0};
@@ -207,9 +301,24 @@ private:
     int prejumpMaxShots = 100;
     int prejumpSortColumn = 0;  // 0=Name, 1=Creator, 2=Difficulty, 3=Shots, 4=Likes, 5=Plays
     bool prejumpSortAscending = true;
+    char prejumpQueryText[512] = {0};         // Effective browser query; the widgets above write into it
+    PackQueryCache prejumpQueryCache;         // Compiled queries keyed by text
+    std::unique_ptr<PackFilterEngine> prejumpFilterEngine;
+
+    // Match end: GameEndedEvent submits every signal through AcceptMatchEnd;
+    // only the first one per match captures the result and runs the actions
+    void GetMatchEvent(std::string& matchGuid, uint64_t& eventAddress);
+    void CaptureMatchResult();
+    void RunPostMatchActions();
+    MatchEndPipeline matchEndPipeline;  // Dedups the two match-ended hooks
 
     // Shuffle helpers
-    int GetRandomTrainingIndex() const;
+    int GetRandomTrainingIndex();
+    // Next pack of the shuffle rotation; empty when the bag is empty. The
+    // rotation is saved shortly after a draw, not on every draw.
+    std::optional<TrainingCode> NextShufflePack();
+    // Catalog entry for code (RLTraining first, then Prejump), or null
+    const TrainingEntry* FindTrainingEntry(TrainingCode code) const;
 
     ImGuiContext* imguiCtx = nullptr;
     
@@ -221,6 +330,9 @@ class PostMatchOverlayWindow : public PluginWindowBase {
 public:
     PostMatchOverlayWindow(SuiteSpot* plugin);
     void Render() override;
+    // SuiteSpot::Render passes the snapshot it read this frame, so sizing
+    // and drawing never see two different matches
+    void Render(const PostMatchInfo& postMatch);
     void RenderWindow() override;
     void Open();
     void Close();
@@ -0,0 +1,225 @@
+// #detailed comments: suitespot_bench
+// Purpose: Runs SuiteSpot's data-path benchmarks outside the game against
+// synthetic data, so they can be tracked on any machine and in CI. Built
+// only by CMakeLists.txt (SUITESPOT_HEADLESS); the plugin exposes the same
+// benchmarks through its ss_bench_* notifiers.
+//
+// Usage:
+//   suitespot_bench [--packs N] [--workshop M] [--iterations I] [--threads T]
+//                   [--only io,workshop,filter,shuffle,overlay,allocs]
+//                   [--json results.json] [--baseline old.json] [--tolerance 0.25]
+//
+// The table goes to stdout; --json writes the same rows machine-readable.
+// With --baseline, each timed row is compared to the row with the same
+// suite, name, items and threads in an earlier --json file, and a row
+// slower by more than the tolerance counts as a regression.
+//
+// Exit status: 0 clean; 1 if a row reported MISMATCH, an allocation
+// budget was exceeded or a row regressed; 2 on bad arguments.
+#include "pch.h"
+#include "AllocTracker.h"
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    struct Options {
+        size_t packs = 100000;
+        size_t workshopFolders = 2000;
+        size_t overlayFrames = 10000;
+        int iterations = 3;
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        std::set<std::string> only;
+        std::string jsonPath;
+        std::string baselinePath;
+        double tolerance = 0.25;
+    };
+
+    struct SuiteRow {
+        std::string suite;
+        BenchmarkResult result;
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: suitespot_bench [--packs N] [--workshop M] [--iterations I] [--threads T]\n"
+            "                       [--only io,workshop,filter,shuffle,overlay,allocs]\n"
+            "                       [--json results.json] [--baseline old.json] [--tolerance 0.25]\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        try {
+            for (int i = 1; i < argc; ++i) {
+                const std::string arg = argv[i];
+                if (arg == "--help" || arg == "-h") return false;
+                if (i + 1 >= argc) return false;
+                const std::string value = argv[++i];
+                if (arg == "--packs") options.packs = std::stoul(value);
+                else if (arg == "--workshop") options.workshopFolders = std::stoul(value);
+                else if (arg == "--iterations") options.iterations = std::max(1, std::stoi(value));
+                else if (arg == "--threads") options.threads = std::max<size_t>(1, std::stoul(value));
+                else if (arg == "--json") options.jsonPath = value;
+                else if (arg == "--baseline") options.baselinePath = value;
+                else if (arg == "--tolerance") options.tolerance = std::stod(value);
+                else if (arg == "--only") {
+                    std::istringstream list(value);
+                    for (std::string suite; std::getline(list, suite, ',');) {
+                        if (!suite.empty()) options.only.insert(suite);
+                    }
+                }
+                else return false;
+            }
+        } catch (...) {
+            return false;
+        }
+        return options.packs > 0;
+    }
+
+    std::string RowKey(const std::string& suite, const std::string& name, size_t items, size_t threads)
+    {
+        return suite + "/" + name + "/" + std::to_string(items) + "/" + std::to_string(threads);
+    }
+
+    // Rows of an earlier --json file by RowKey; empty if it cannot be read
+    std::map<std::string, double> LoadBaseline(const std::string& path)
+    {
+        std::map<std::string, double> baseline;
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            std::fprintf(stderr, "suitespot_bench: could not open baseline %s\n", path.c_str());
+            return baseline;
+        }
+        try {
+            nlohmann::json file;
+            in >> file;
+            for (const auto& row : file.at("results")) {
+                baseline[RowKey(row.at("suite").get<std::string>(), row.at("name").get<std::string>(),
+                    row.at("items").get<size_t>(), row.at("threads").get<size_t>())] = row.at("millis").get<double>();
+            }
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "suitespot_bench: baseline %s is not a results file: %s\n", path.c_str(), e.what());
+            baseline.clear();
+        }
+        return baseline;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+    const auto enabled = [&options](const char* suite) { return options.only.empty() || options.only.count(suite) != 0; };
+
+    std::vector<SuiteRow> rows;
+    const auto run = [&](const char* suite, const std::vector<BenchmarkResult>& results) {
+        for (const auto& result : results) {
+            std::printf("%-9s %s\n", suite, FormatBenchmarkResult(result).c_str());
+            rows.push_back({ suite, result });
+        }
+        std::fflush(stdout);
+    };
+
+    if (enabled("io")) run("io", RunCatalogIOBenchmark(options.packs, options.iterations));
+    if (enabled("workshop") && options.workshopFolders > 0) {
+        const auto root = std::filesystem::temp_directory_path() / "suitespot_bench_workshop";
+        run("workshop", RunWorkshopDiscoveryBenchmark(root, options.workshopFolders, options.iterations));
+    }
+    if (enabled("filter")) run("filter", RunFilterScalingBenchmark({ options.packs }, options.threads, options.iterations));
+    if (enabled("shuffle")) run("shuffle", RunShuffleBenchmark(options.packs, options.iterations));
+    if (enabled("overlay")) run("overlay", RunOverlayFrameBenchmark(options.overlayFrames, options.iterations));
+
+    std::vector<AllocationBenchmarkResult> allocations;
+    if (enabled("allocs")) {
+        allocations = RunRenderAllocationBenchmark(1000);
+        for (const auto& result : allocations) {
+            std::printf("%-9s %s\n", "allocs", FormatAllocationBenchmarkResult(result).c_str());
+        }
+    }
+
+    size_t failures = 0;
+    for (const auto& row : rows) {
+        if (row.result.name == "MISMATCH" || row.result.name == "REPEATED") ++failures;
+    }
+    for (const auto& result : allocations) {
+        if (!result.Passed()) ++failures;
+    }
+
+    if (!options.baselinePath.empty()) {
+        const auto baseline = LoadBaseline(options.baselinePath);
+        if (baseline.empty()) return 2;
+        for (const auto& row : rows) {
+            const auto it = baseline.find(RowKey(row.suite, row.result.name, row.result.items, row.result.threads));
+            if (it == baseline.end() || it->second <= 0.0) continue;
+            const double ratio = row.result.millis / it->second;
+            if (ratio > 1.0 + options.tolerance) {
+                std::printf("REGRESSED %s/%s: %.3f ms -> %.3f ms (%.2fx)\n", row.suite.c_str(), row.result.name.c_str(),
+                    it->second, row.result.millis, ratio);
+                ++failures;
+            }
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        nlohmann::json file;
+        file["schema"] = 1;
+        file["config"] = {
+            { "packs", options.packs },
+            { "workshopFolders", options.workshopFolders },
+            { "overlayFrames", options.overlayFrames },
+            { "iterations", options.iterations },
+            { "threads", options.threads },
+            { "allocTracking", AllocTrackingEnabled() },
+        };
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto& row : rows) {
+            results.push_back({
+                { "suite", row.suite },
+                { "name", row.result.name },
+                { "items", row.result.items },
+                { "threads", row.result.threads },
+                { "millis", row.result.millis },
+                { "itemsPerSec", row.result.itemsPerSec },
+                { "speedup", row.result.speedup },
+            });
+        }
+        file["results"] = std::move(results);
+        nlohmann::json allocRows = nlohmann::json::array();
+        for (const auto& result : allocations) {
+            allocRows.push_back({
+                { "name", result.name },
+                { "frames", result.frames },
+                { "allocsPerFrame", result.allocsPerFrame },
+                { "bytesPerFrame", result.bytesPerFrame },
+                { "budget", result.budget },
+                { "passed", result.Passed() },
+            });
+        }
+        file["allocations"] = std::move(allocRows);
+        file["failures"] = failures;
+
+        std::ofstream out(options.jsonPath, std::ios::trunc);
+        out << file.dump(2) << "\n";
+        if (!out) {
+            std::fprintf(stderr, "suitespot_bench: could not write %s\n", options.jsonPath.c_str());
+            return 2;
+        }
+    }
+
+    std::printf("%s\n", failures == 0 ? "ok" : (std::to_string(failures) + " failure(s)").c_str());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(Clock::time_point origin)
+    : origin_(origin)
+    , slots_(kSlots)
+{
+}
+
+uint64_t TimerWheel::TickAt(Clock::time_point t) const
+{
+    if (t <= origin_) return 0;
+    return static_cast<uint64_t>((t - origin_) / kTick);
+}
+
+void TimerWheel::EraseLocked(std::unordered_map<uint64_t, Timer>::iterator it)
+{
+    if (!it->second.key.empty()) {
+        const auto key = keys_.find(it->second.key);
+        if (key != keys_.end() && key->second == it->first) keys_.erase(key);
+    }
+    timers_.erase(it);
+}
+
+TimerHandle TimerWheel::Schedule(Clock::duration delay, Callback callback, std::string_view coalesceKey, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_ || !callback) return {};
+
+    const uint64_t id = nextId_++;
+    // Round up so a timer never fires early, and never into the bucket
+    // being scanned (or already scanned) this tick
+    const auto due = now + std::max(delay, Clock::duration::zero());
+    uint64_t dueTick = TickAt(due);
+    if (origin_ + dueTick * kTick < due) ++dueTick;
+    dueTick = std::max(dueTick, currentTick_ + 1);
+
+    Timer timer;
+    timer.dueTick = dueTick;
+    timer.callback = std::move(callback);
+    if (!coalesceKey.empty()) {
+        timer.key.assign(coalesceKey);
+        const auto previous = keys_.find(timer.key);
+        if (previous != keys_.end()) {
+            const auto it = timers_.find(previous->second);
+            if (it != timers_.end()) EraseLocked(it);
+        }
+        keys_[timer.key] = id;
+    }
+    timers_.emplace(id, std::move(timer));
+    slots_[dueTick % kSlots].push_back(id);
+    return TimerHandle{ id };
+}
+
+bool TimerWheel::Cancel(TimerHandle handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = timers_.find(handle.id);
+    if (it == timers_.end()) return false;
+    EraseLocked(it);
+    return true;
+}
+
+bool TimerWheel::CancelKey(std::string_view coalesceKey)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto key = keys_.find(std::string(coalesceKey));
+    if (key == keys_.end()) return false;
+    const auto it = timers_.find(key->second);
+    if (it == timers_.end()) {
+        keys_.erase(key);
+        return false;
+    }
+    EraseLocked(it);
+    return true;
+}
+
+void TimerWheel::CancelAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    timers_.clear();
+    keys_.clear();
+    for (auto& slot : slots_) slot.clear();
+}
+
+void TimerWheel::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    CancelAll();
+}
+
+// #detailed comments: TimerWheel::Advance
+// Purpose: Scan the buckets of every tick since the last call. After a
+// stall longer than a revolution each bucket is scanned once (with the
+// current tick), not once per missed revolution. Due ids are gathered
+// under the lock and sorted by (due tick, id) so timers fire in schedule
+// order; each one is then re-checked and removed just before it runs, so
+// a callback can still cancel a later timer due in the same Advance.
+size_t TimerWheel::Advance(Clock::time_point now)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> due;  // (dueTick, id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t target = TickAt(now);
+        if (target <= currentTick_) return 0;
+        if (timers_.empty()) {
+            currentTick_ = target;
+            return 0;
+        }
+
+        const uint64_t first = target - currentTick_ > kSlots ? target - kSlots + 1 : currentTick_ + 1;
+        for (uint64_t tick = first; tick <= target; ++tick) {
+            auto& slot = slots_[tick % kSlots];
+            size_t kept = 0;
+            for (const uint64_t id : slot) {
+                const auto it = timers_.find(id);
+                if (it == timers_.end()) continue;  // cancelled
+                if (it->second.dueTick <= target) {
+                    due.emplace_back(it->second.dueTick, id);
+                } else {
+                    slot[kept++] = id;  // a later revolution
+                }
+            }
+            slot.resize(kept);
+        }
+        currentTick_ = target;
+    }
+
+    std::sort(due.begin(), due.end());
+    size_t fired = 0;
+    for (const auto& entry : due) {
+        Callback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = timers_.find(entry.second);
+            if (it == timers_.end()) continue;
+            callback = std::move(it->second.callback);
+            EraseLocked(it);
+        }
+        callback();
+        ++fired;
+    }
+    return fired;
+}
+
+size_t TimerWheel::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.size();
+}
+
+bool TimerWheel::IsPending(TimerHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.count(handle.id) != 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Identifies one scheduled timer; a default handle refers to nothing
+struct TimerHandle {
+    uint64_t id = 0;
+    explicit operator bool() const { return id != 0; }
+};
+
+// TimerWheel: The plugin's deferred actions, driven by one tick
+//
+// Purpose: Replaces scattered gameWrapper->SetTimeout calls, which cannot
+// be cancelled and outlive the plugin, with timers the plugin owns:
+//   - Schedule returns a handle that Cancel accepts
+//   - a non-empty coalesce key supersedes the pending timer with the same
+//     key ("a newer map load replaces a pending one")
+//   - Shutdown cancels everything and refuses new timers, so nothing
+//     runs against an unloaded plugin
+//
+// Layout: A hashed timing wheel of kSlots buckets of kTick each. A timer
+// lives in the bucket of its due tick; a bucket is scanned once per
+// revolution and only fires the timers that are actually due, so
+// Schedule, Cancel and Advance cost O(1) per timer regardless of delay.
+//
+// Threading: Schedule and Cancel may be called from any thread (settings
+// buttons run on the render thread). Advance runs on the game thread
+// (SuiteSpot calls it from the viewport tick) and invokes callbacks
+// there, outside the lock, so callbacks may schedule or cancel timers.
+//
+// Usage Example:
+//   timers.Schedule(std::chrono::milliseconds(0), [this] { LoadMap(code); }, "map.load");
+//   auto h = timers.Schedule(std::chrono::seconds(2), [this] { Refresh(); });
+//   timers.Cancel(h);
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    static constexpr Clock::duration kTick = std::chrono::milliseconds(10);
+    static constexpr size_t kSlots = 512;  // ~5 s per revolution
+
+    explicit TimerWheel(Clock::time_point origin = Clock::now());
+
+    // Runs callback on the first Advance at least delay from now; an empty
+    // handle after Shutdown
+    TimerHandle Schedule(Clock::duration delay, Callback callback, std::string_view coalesceKey = {},
+                         Clock::time_point now = Clock::now());
+
+    // False when the timer already ran or was cancelled
+    bool Cancel(TimerHandle handle);
+    bool CancelKey(std::string_view coalesceKey);
+    void CancelAll();
+
+    // Game thread: fires every timer due at now; returns how many ran
+    size_t Advance(Clock::time_point now = Clock::now());
+
+    // Cancels everything; Schedule is refused from here on
+    void Shutdown();
+
+    size_t Size() const;
+    bool IsPending(TimerHandle handle) const;
+
+private:
+    struct Timer {
+        uint64_t dueTick = 0;
+        Callback callback;
+        std::string key;
+    };
+
+    uint64_t TickAt(Clock::time_point t) const;
+    void EraseLocked(std::unordered_map<uint64_t, Timer>::iterator it);
+
+    mutable std::mutex mutex_;
+    const Clock::time_point origin_;
+    uint64_t currentTick_ = 0;  // Last tick whose bucket was scanned
+    uint64_t nextId_ = 1;
+    bool shutdown_ = false;
+    std::vector<std::vector<uint64_t>> slots_;  // Timer ids; cancelled ids are dropped on the next scan
+    std::unordered_map<uint64_t, Timer> timers_;
+    std::unordered_map<std::string, uint64_t> keys_;
+};
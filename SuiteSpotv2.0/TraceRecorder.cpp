@@ -0,0 +1,207 @@
+#include "pch.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    // Literals are ours, but a quote or backslash must not break the file
+    void WriteJsonString(std::ostream& out, const char* text)
+    {
+        out.put('"');
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out.put('\\');
+            if (static_cast<unsigned char>(*c) >= 0x20) out.put(*c);
+        }
+        out.put('"');
+    }
+
+    char PhaseCode(TracePhase phase)
+    {
+        switch (phase) {
+            case TracePhase::Begin: return 'B';
+            case TracePhase::End: return 'E';
+            case TracePhase::Counter: return 'C';
+            default: return 'i';
+        }
+    }
+}
+
+bool WriteChromeTrace(std::ostream& out, const std::vector<TraceEvent>& events,
+                      const std::vector<std::string>& threadNames, int64_t originNs)
+{
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    const auto separator = [&out, &first] {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    out << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"SuiteSpot"}})";
+    first = false;
+    for (size_t i = 0; i < threadNames.size(); ++i) {
+        separator();
+        out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << i << R"(,"args":{"name":)";
+        WriteJsonString(out, threadNames[i].c_str());
+        out << "}}";
+    }
+
+    char ts[32];
+    for (const auto& event : events) {
+        separator();
+        // Microseconds with nanosecond precision
+        std::snprintf(ts, sizeof(ts), "%.3f", (event.timestampNs - originNs) / 1000.0);
+        out << "{\"name\":";
+        WriteJsonString(out, event.name);
+        out << ",\"cat\":";
+        WriteJsonString(out, event.category);
+        out << ",\"ph\":\"" << PhaseCode(event.phase) << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << event.thread;
+        if (event.phase == TracePhase::Instant) {
+            out << ",\"s\":\"t\"";
+        } else if (event.phase == TracePhase::Counter) {
+            out << ",\"args\":{\"value\":" << event.value << "}";
+        }
+        out.put('}');
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+TraceRecorder& TraceRecorder::Get()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+int64_t TraceRecorder::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    Shutdown();
+}
+
+// Owned by the recorder, so a finished thread's events can still be drained
+TraceRecorder::ThreadBuffer& TraceRecorder::LocalBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto owned = std::make_unique<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        owned->index = static_cast<uint16_t>(std::min<size_t>(buffers_.size(), UINT16_MAX));
+        buffer = owned.get();
+        buffers_.push_back(std::move(owned));
+    }
+    return *buffer;
+}
+
+void TraceRecorder::Record(TracePhase phase, const char* category, const char* name, double value)
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.timestampNs = NowNs();
+    event.value = value;
+    event.phase = phase;
+    event.thread = buffer.index;
+    buffer.ring.Push(event);
+}
+
+void TraceRecorder::NameThread(const char* name)
+{
+    LocalBuffer().name.store(name, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::Start()
+{
+    if (Recording()) return false;
+    {
+        // Whatever was buffered since the last session is not part of this one
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& buffer : buffers_) buffer->readCursor = buffer->ring.Written();
+    }
+    session_.clear();
+    sessionCount_.store(0, std::memory_order_relaxed);
+    dropped_ = 0;
+    sessionStart_ = NowNs();
+    recording_.store(true, std::memory_order_release);
+    return true;
+}
+
+void TraceRecorder::Drain()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainBuffers_.clear();
+        for (const auto& buffer : buffers_) drainBuffers_.push_back(buffer.get());
+    }
+    scratch_.resize(kThreadCapacity);
+
+    for (ThreadBuffer* buffer : drainBuffers_) {
+        const uint64_t end = buffer->ring.Written();
+        uint64_t first = end;
+        const size_t count = buffer->ring.Copy(buffer->readCursor, end, scratch_.data(), &first);
+        dropped_ += first - buffer->readCursor;  // Overwritten before this drain
+        buffer->readCursor = end;
+
+        const size_t room = kMaxSessionEvents - std::min(kMaxSessionEvents, session_.size());
+        const size_t kept = std::min(count, room);
+        session_.insert(session_.end(), scratch_.begin(), scratch_.begin() + kept);
+        dropped_ += count - kept;
+    }
+    sessionCount_.store(session_.size(), std::memory_order_relaxed);
+}
+
+// #detailed comments: TraceRecorder::Stop
+// Purpose: The last Drain picks up everything recorded before recording_
+// went false; a scope that was open keeps its Begin without an End, which
+// trace viewers draw as running to the end of the trace. The session moves
+// to the writer thread with the thread names, so Start can begin the next
+// session at once.
+bool TraceRecorder::Stop(std::filesystem::path path, Completion done)
+{
+    if (!recording_.exchange(false, std::memory_order_acq_rel)) return false;
+    Drain();
+
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& buffer : buffers_) {
+            const char* name = buffer->name.load(std::memory_order_relaxed);
+            threadNames.push_back(name ? name : "Thread " + std::to_string(buffer->index));
+        }
+    }
+
+    if (writer_.joinable()) writer_.join();
+    writer_ = std::thread([events = std::move(session_), threadNames = std::move(threadNames), origin = sessionStart_,
+                           dropped = dropped_, path = std::move(path), done = std::move(done)]() {
+        TraceWriteResult result;
+        result.path = path;
+        result.events = events.size();
+        result.dropped = dropped;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            result.error = "could not open file";
+        } else if (!WriteChromeTrace(out, events, threadNames, origin)) {
+            result.error = "write failed";
+        } else {
+            result.ok = true;
+        }
+        if (done) done(result);
+    });
+    session_ = {};
+    sessionCount_.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void TraceRecorder::Shutdown()
+{
+    recording_.store(false, std::memory_order_release);
+    if (writer_.joinable()) writer_.join();
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "SpscRing.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TracePhase : uint8_t { Begin, End, Instant, Counter };
+
+// One trace event. name and category point at string literals, so an
+// event is a fixed-size copy and the strings outlive any session.
+struct TraceEvent {
+    const char* name = "";
+    const char* category = "";
+    int64_t timestampNs = 0;  // TraceRecorder::NowNs()
+    double value = 0.0;       // Counter only
+    TracePhase phase = TracePhase::Instant;
+    uint16_t thread = 0;      // TraceRecorder's index for the recording thread
+};
+
+struct TraceWriteResult {
+    std::filesystem::path path;
+    size_t events = 0;
+    uint64_t dropped = 0;  // Lost to full buffers
+    bool ok = false;
+    std::string error;
+};
+
+// Writes events as Chrome trace-event JSON (chrome://tracing, Perfetto).
+// threadNames[i] names thread index i; timestamps are made relative to
+// originNs. Returns false if the stream failed.
+bool WriteChromeTrace(std::ostream& out, const std::vector<TraceEvent>& events,
+                      const std::vector<std::string>& threadNames, int64_t originNs);
+
+// TraceRecorder: Trace-event capture for offline analysis
+//
+// Purpose: ss_trace start records begin/end, instant and counter events
+// from the plugin's hot paths (catalog loads, filter rebuilds, scrapes,
+// saves, hook callbacks, render passes); ss_trace stop writes them as a
+// Chrome trace. Unlike the Profiler's markers these are compiled into
+// every build, so a session can be captured in production; while not
+// recording, an event costs one relaxed load.
+//
+// Memory: each thread records into its own SpscRing of kThreadCapacity
+// events (no lock, no allocation after the thread's first event). The
+// game thread drains the rings every tick into the session, which stops
+// growing at kMaxSessionEvents (about 20 MB). Events lost to a full ring
+// or a full session are counted and reported with the file.
+//
+// Threading: Record, NameThread and Recording from any thread. Start, Drain
+// and Stop from the game thread. Stop hands the session to a writer
+// thread, so a large trace does not stall the game; the result callback
+// runs there.
+//
+// Usage Example:
+//   void SuiteSpot::SaveShuffleBag() const {
+//       SS_TRACE_SCOPE("io", "SaveShuffleBag");
+//       ...
+//   }
+//   SS_TRACE_COUNTER("catalog", "PrejumpPacks", packs.size());
+//   // game thread
+//   recorder.Start();
+//   recorder.Drain();  // every tick
+//   recorder.Stop(path, [](const TraceWriteResult& r) { ... });
+class TraceRecorder
+{
+public:
+    static constexpr size_t kThreadCapacity = 16384;          // Events buffered per thread between drains
+    static constexpr size_t kMaxSessionEvents = size_t(1) << 19;
+
+    using Completion = std::function<void(const TraceWriteResult& result)>;
+
+    static TraceRecorder& Get();
+    static int64_t NowNs();
+
+    ~TraceRecorder();
+
+    bool Recording() const { return recording_.load(std::memory_order_relaxed); }
+
+    // Any thread; name and category must be string literals
+    void Record(TracePhase phase, const char* category, const char* name, double value = 0.0);
+    // Any thread; shown as the thread's track name. name must be a literal.
+    void NameThread(const char* name);
+
+    // Game thread. Start returns false if a session is already recording.
+    bool Start();
+    void Drain();
+    // Game thread: stops, drains and writes the session to path on the
+    // writer thread. Returns false if nothing was recording.
+    bool Stop(std::filesystem::path path, Completion done);
+    // onUnload: waits for a pending write
+    void Shutdown();
+
+    size_t SessionEvents() const { return sessionCount_.load(std::memory_order_relaxed); }
+
+private:
+    struct ThreadBuffer {
+        SpscRing<TraceEvent, kThreadCapacity> ring;
+        uint16_t index = 0;
+        std::atomic<const char*> name{ nullptr };
+        uint64_t readCursor = 0;  // Drain only
+    };
+
+    ThreadBuffer& LocalBuffer();
+
+    std::atomic<bool> recording_{ false };
+
+    std::mutex mutex_;  // Guards buffers_ (only grows)
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    // Game thread only
+    std::vector<ThreadBuffer*> drainBuffers_;
+    std::vector<TraceEvent> scratch_;
+    std::vector<TraceEvent> session_;
+    std::atomic<size_t> sessionCount_{ 0 };  // session_.size(), readable from the UI
+    uint64_t dropped_ = 0;
+    int64_t sessionStart_ = 0;
+    std::thread writer_;
+};
+
+// RAII begin/end pair; use SS_TRACE_SCOPE rather than naming it directly
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name)
+    {
+        TraceRecorder& recorder = TraceRecorder::Get();
+        if (!recorder.Recording()) return;
+        category_ = category;
+        name_ = name;
+        recorder.Record(TracePhase::Begin, category, name);
+    }
+    ~TraceScope()
+    {
+        // Ends what it began even if recording stopped in between
+        if (name_) TraceRecorder::Get().Record(TracePhase::End, category_, name_);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category_ = nullptr;
+    const char* name_ = nullptr;
+};
+
+#define SS_TRACE_CONCAT_INNER(a, b) a##b
+#define SS_TRACE_CONCAT(a, b) SS_TRACE_CONCAT_INNER(a, b)
+
+#define SS_TRACE_SCOPE(category, name) TraceScope SS_TRACE_CONCAT(ssTraceScope_, __LINE__)(category, name)
+#define SS_TRACE_INSTANT(category, name)                                                        \
+    do {                                                                                       \
+        if (TraceRecorder::Get().Recording()) TraceRecorder::Get().Record(TracePhase::Instant, category, name); \
+    } while (0)
+#define SS_TRACE_COUNTER(category, name, value)                                                 \
+    do {                                                                                       \
+        if (TraceRecorder::Get().Recording())                                                  \
+            TraceRecorder::Get().Record(TracePhase::Counter, category, name, static_cast<double>(value)); \
+    } while (0)
@@ -0,0 +1,138 @@
+#include "pch.h"
+#include "TrainingCode.h"
+
+namespace
+{
+    int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+}
+
+// #detailed comments: TrainingCode::Parse
+// Purpose: Accepts the 19-character dashed form or the bare 16 hex digits.
+// Dashes are only legal at the group boundaries of the dashed form, so
+// "555F7-503B-BB9E-1E3" is rejected rather than silently repacked.
+std::optional<TrainingCode> TrainingCode::Parse(std::string_view text)
+{
+    while (!text.empty() && IsSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && IsSpace(text.back())) text.remove_suffix(1);
+
+    const bool dashed = text.size() == 19;
+    if (!dashed && text.size() != 16) {
+        return std::nullopt;
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (dashed && (i == 4 || i == 9 || i == 14)) {
+            if (text[i] != '-') return std::nullopt;
+            continue;
+        }
+        const int digit = HexValue(text[i]);
+        if (digit < 0) return std::nullopt;
+        value = (value << 4) | static_cast<uint64_t>(digit);
+    }
+    return TrainingCode(value);
+}
+
+std::string TrainingCode::Normalize(std::string_view text)
+{
+    const auto code = Parse(text);
+    return code ? code->ToString() : std::string();
+}
+
+std::string TrainingCode::ToString() const
+{
+    static const char kDigits[] = "0123456789ABCDEF";
+    std::string out(19, '-');
+    size_t pos = out.size();
+    uint64_t v = value_;
+    for (int digit = 0; digit < 16; ++digit) {
+        --pos;
+        if (pos == 14 || pos == 9 || pos == 4) --pos;  // keep the dash slots
+        out[pos] = kDigits[v & 0xF];
+        v >>= 4;
+    }
+    return out;
+}
+
+bool TrainingCodeLocation::IsEmpty() const
+{
+    for (int row : rows) {
+        if (row >= 0) return false;
+    }
+    return true;
+}
+
+// #detailed comments: TrainingCodeIndex::Reindex
+// Purpose: Drops every key the source inserted last time, then indexes
+// rows afresh. Rows are indexed in order so the first occurrence of a
+// duplicated code keeps the slot, matching what the old find_if scans
+// returned.
+TrainingCodeIndexReport TrainingCodeIndex::Reindex(TrainingCodeSource source, const std::vector<TrainingEntry>& rows)
+{
+    auto& keys = keys_[static_cast<size_t>(source)];
+    for (TrainingCode key : keys) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) continue;
+        it->second.Get(source) = -1;
+        if (it->second.IsEmpty()) {
+            entries_.erase(it);
+        }
+    }
+    keys.clear();
+    keys.reserve(rows.size());
+
+    TrainingCodeIndexReport report;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const auto code = TrainingCode::Parse(rows[i].code);
+        if (!code) {
+            ++report.invalid;
+            continue;
+        }
+        auto& location = entries_[*code];
+        int& slot = location.Get(source);
+        if (slot >= 0) {
+            ++report.duplicates;
+            continue;
+        }
+        slot = static_cast<int>(i);
+        keys.push_back(*code);
+        ++report.indexed;
+
+        for (size_t s = 0; s < location.rows.size(); ++s) {
+            if (s != static_cast<size_t>(source) && location.rows[s] >= 0) {
+                ++report.shared;
+                break;
+            }
+        }
+    }
+    return report;
+}
+
+const TrainingCodeLocation* TrainingCodeIndex::Find(TrainingCode code) const
+{
+    auto it = entries_.find(code);
+    return it == entries_.end() ? nullptr : &it->second;
+}
+
+int TrainingCodeIndex::IndexOf(TrainingCodeSource source, TrainingCode code) const
+{
+    const auto* location = Find(code);
+    return location ? location->Get(source) : -1;
+}
+
+int TrainingCodeIndex::IndexOf(TrainingCodeSource source, std::string_view code) const
+{
+    const auto parsed = TrainingCode::Parse(code);
+    return parsed ? IndexOf(source, *parsed) : -1;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "MapList.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// TrainingCode: Packed 64-bit training pack code
+//
+// Purpose: Rocket League training codes are 16 hex digits shown as
+// XXXX-XXXX-XXXX-XXXX. Packing them into a uint64_t turns every code
+// comparison and hash into a single integer operation and gives one
+// canonical form regardless of how the user or a data file wrote it.
+//
+// Parsing accepts either case, with or without the dashes, and ignores
+// surrounding whitespace ("555f7503bbb9e1e3" == "555F-7503-BBB9-E1E3").
+// Anything else (wrong length, non-hex digits, misplaced dashes) fails.
+//
+// Usage Example:
+//   if (auto code = TrainingCode::Parse(input)) {
+//       entry.code = code->ToString();  // canonical uppercase, dashed
+//   }
+class TrainingCode
+{
+public:
+    constexpr TrainingCode() = default;
+    constexpr explicit TrainingCode(uint64_t value) : value_(value) {}
+
+    static std::optional<TrainingCode> Parse(std::string_view text);
+
+    // Canonical "XXXX-XXXX-XXXX-XXXX" form of text, or empty when invalid
+    static std::string Normalize(std::string_view text);
+
+    std::string ToString() const;
+    constexpr uint64_t Value() const { return value_; }
+
+    constexpr bool operator==(const TrainingCode& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const TrainingCode& other) const { return value_ != other.value_; }
+
+private:
+    uint64_t value_ = 0;
+};
+
+struct TrainingCodeHash {
+    size_t operator()(TrainingCode code) const
+    {
+        // splitmix64 finalizer: codes are random hex, but user-made ones
+        // often share prefixes, so mix every bit into the bucket index
+        uint64_t x = code.Value();
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<size_t>(x ^ (x >> 31));
+    }
+};
+
+// Catalogs that hold training packs
+enum class TrainingCodeSource : uint8_t {
+    Training,  // RLTraining (user's saved packs)
+    Prejump,   // prejumpPacks (browser catalog)
+    Count,
+};
+
+// Row of a code in every catalog; -1 when the catalog does not contain it
+struct TrainingCodeLocation {
+    std::array<int, static_cast<size_t>(TrainingCodeSource::Count)> rows = { -1, -1 };
+
+    int Get(TrainingCodeSource source) const { return rows[static_cast<size_t>(source)]; }
+    int& Get(TrainingCodeSource source) { return rows[static_cast<size_t>(source)]; }
+    bool IsEmpty() const;
+};
+
+// What a Reindex call found; the caller decides what to log
+struct TrainingCodeIndexReport {
+    size_t indexed = 0;     // distinct valid codes now in the source
+    size_t invalid = 0;     // rows whose code does not parse
+    size_t duplicates = 0;  // rows repeating a code earlier in the same source
+    size_t shared = 0;      // codes also present in another source
+};
+
+// TrainingCodeIndex: One hash index from code to location across catalogs
+//
+// Purpose: Replaces the linear find_if scans over RLTraining and
+// prejumpPacks with O(1) lookups. Each source is reindexed as a whole
+// whenever its vector changes (load, sort, add); the index remembers
+// which keys each source inserted so reindexing one source never walks
+// the others. The shuffle bag keeps its own code set (see ShuffleBag)
+// and maps codes to catalog rows through this index.
+//
+// Duplicates: within one source the first row wins and later rows are
+// counted in the report. The same code in both sources is expected (a
+// saved pack that is also on Prejump) and is reported as shared.
+class TrainingCodeIndex
+{
+public:
+    TrainingCodeIndexReport Reindex(TrainingCodeSource source, const std::vector<TrainingEntry>& rows);
+
+    const TrainingCodeLocation* Find(TrainingCode code) const;
+
+    // Row of code in source, or -1 (also -1 when code does not parse)
+    int IndexOf(TrainingCodeSource source, TrainingCode code) const;
+    int IndexOf(TrainingCodeSource source, std::string_view code) const;
+    bool Contains(TrainingCodeSource source, std::string_view code) const { return IndexOf(source, code) >= 0; }
+
+    size_t Size() const { return entries_.size(); }
+
+private:
+    std::unordered_map<TrainingCode, TrainingCodeLocation, TrainingCodeHash> entries_;
+    std::array<std::vector<TrainingCode>, static_cast<size_t>(TrainingCodeSource::Count)> keys_;
+};
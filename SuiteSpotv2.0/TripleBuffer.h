@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// TripleBuffer: Lock-free single-writer / single-reader value handoff
+//
+// Purpose: Lets one thread publish complete values of T while another
+// thread reads the latest one, without locks and without either side ever
+// seeing a half-written value. There are three slots: the writer fills
+// its private back slot and publishes it by swapping it with the shared
+// middle slot; the reader swaps the middle slot into its private front
+// slot when a newer value is waiting. Neither side blocks or allocates.
+//
+// Rules:
+// - Exactly one writer thread (WriteSlot/Publish) and one reader thread
+//   (Read). Other threads must hand work to one of them first.
+// - The slot returned by WriteSlot holds whatever was published two
+//   swaps ago, not a cleared value; the writer must set every field.
+// - A reference returned by Read stays valid until the next Read.
+//
+// Usage Example:
+//   // game thread
+//   PostMatchInfo& slot = buffer.WriteSlot();
+//   FillFromServer(slot);
+//   buffer.Publish();
+//   // render thread
+//   const PostMatchInfo& latest = buffer.Read();
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : slots_{ initial, initial, initial } {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: the private slot to fill before Publish
+    T& WriteSlot() { return slots_[back_]; }
+
+    // Writer: make the filled slot the latest value
+    void Publish()
+    {
+        back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Reader: latest published value (the previous one if nothing new)
+    const T& Read()
+    {
+        if (middle_.load(std::memory_order_relaxed) & kFresh) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        }
+        return slots_[front_];
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;  // middle holds a value the reader has not taken
+
+    std::array<T, 3> slots_{};
+    uint8_t back_ = 0;                   // writer only
+    uint8_t front_ = 1;                  // reader only
+    std::atomic<uint8_t> middle_{ 2 };   // shared, index | kFresh
+};
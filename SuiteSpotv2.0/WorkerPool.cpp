@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <utility>
+
+// WorkerPool Implementation
+//
+// Job handshake: ParallelFor publishes the callback and chunk count under
+// jobMutex_, bumps jobSerial_ and wakes the workers. Each worker registers
+// itself in activeWorkers_ while it holds a reference to the job, so the
+// caller cannot return (and invalidate the callback) while a late-waking
+// worker is still looking at it.
+//
+// Failures: the first exception a chunk throws is kept in jobError_ and
+// nextChunk_ is pushed past the end so no further chunks start. Chunks
+// already running finish normally; the caller rethrows after the join.
+
+size_t WorkerPool::DefaultWorkerCount()
+{
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+WorkerPool::WorkerPool(size_t workerCount)
+{
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopping_ = true;
+    }
+    jobReady_.notify_all();
+    for (auto& t : workers_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void WorkerPool::ParallelFor(size_t chunkCount, const std::function<void(size_t)>& fn)
+{
+    if (chunkCount == 0) {
+        return;
+    }
+
+    // Nothing to fan out: run inline and skip the handshake entirely
+    if (workers_.empty() || chunkCount == 1) {
+        for (size_t i = 0; i < chunkCount; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(submitMutex_);
+    RunJob(chunkCount, fn);
+}
+
+bool WorkerPool::ParallelForOrInline(size_t chunkCount, const std::function<void(size_t)>& fn)
+{
+    std::unique_lock<std::mutex> submitLock(submitMutex_, std::defer_lock);
+    const bool fanOut = !workers_.empty() && chunkCount > 1;
+    // Busy: run here rather than queue behind the other caller's job
+    if (!fanOut || !submitLock.try_lock()) {
+        for (size_t i = 0; i < chunkCount; ++i) {
+            fn(i);
+        }
+        return !fanOut;
+    }
+    RunJob(chunkCount, fn);
+    return true;
+}
+
+void WorkerPool::RunJob(size_t chunkCount, const std::function<void(size_t)>& fn)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobFn_ = &fn;
+        jobChunkCount_ = chunkCount;
+        pendingChunks_ = chunkCount;
+        nextChunk_.store(0);
+        ++jobSerial_;
+    }
+    jobReady_.notify_all();
+
+    DrainChunks();
+
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    jobDone_.wait(lock, [this]() { return pendingChunks_ == 0 && activeWorkers_ == 0; });
+    jobFn_ = nullptr;
+    jobChunkCount_ = 0;
+    if (jobError_) {
+        std::rethrow_exception(std::exchange(jobError_, nullptr));
+    }
+}
+
+void WorkerPool::DrainChunks()
+{
+    const std::function<void(size_t)>* fn = nullptr;
+    size_t chunkCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        fn = jobFn_;
+        chunkCount = jobChunkCount_;
+    }
+    if (!fn) {
+        return;
+    }
+
+    size_t completed = 0;
+    for (;;) {
+        const size_t chunk = nextChunk_.fetch_add(1);
+        if (chunk >= chunkCount) {
+            break;
+        }
+        try {
+            (*fn)(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(jobMutex_);
+            if (!jobError_) {
+                jobError_ = std::current_exception();
+            }
+            // Chunks nobody has claimed yet will never run: count them done
+            const size_t claimed = std::min(nextChunk_.exchange(chunkCount), chunkCount);
+            pendingChunks_ -= chunkCount - claimed;
+        }
+        ++completed;
+    }
+
+    if (completed > 0) {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        pendingChunks_ -= completed;
+    }
+}
+
+void WorkerPool::WorkerLoop()
+{
+    unsigned long long seenSerial = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobReady_.wait(lock, [&]() { return stopping_ || (jobSerial_ != seenSerial && jobFn_ != nullptr); });
+            if (stopping_) {
+                return;
+            }
+            seenSerial = jobSerial_;
+            ++activeWorkers_;
+        }
+
+        DrainChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex_);
+            --activeWorkers_;
+        }
+        jobDone_.notify_all();
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkerPool: Small fork-join thread pool for data-parallel catalog work
+//
+// Purpose: Lets data paths (filtering, imports) split a large array into
+// chunks and process them on several cores without spawning threads per
+// call. Threads are created once and park on a condition variable between
+// jobs, so an idle pool costs nothing on the game or render thread.
+//
+// Design Principles:
+// - ParallelFor() is blocking: the calling thread participates in the job
+//   and returns only after every chunk has completed
+// - Chunks are claimed through an atomic counter, so uneven chunks balance
+//   themselves across workers
+// - One job at a time; concurrent callers are serialized, or with
+//   ParallelForOrInline run their chunks on their own thread instead
+// - The first exception thrown by a chunk is rethrown on the calling thread
+//   once the job has joined, so a failed job never looks like a complete one
+// - Never touch BakkesMod wrappers from a chunk callback (worker threads are
+//   not the game thread)
+//
+// Usage Example:
+//   WorkerPool pool;  // DefaultWorkerCount() background workers
+//   pool.ParallelFor(chunkCount, [&](size_t chunk) { ProcessChunk(chunk); });
+class WorkerPool
+{
+public:
+    // workerCount: number of background threads (0 runs every chunk inline)
+    explicit WorkerPool(size_t workerCount = DefaultWorkerCount());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // hardware_concurrency() - 1, leaving the calling thread as the last core
+    static size_t DefaultWorkerCount();
+
+    // Total threads that execute chunks (background workers + calling thread)
+    size_t GetConcurrency() const { return workers_.size() + 1; }
+
+    // Runs fn(chunkIndex) for every chunkIndex in [0, chunkCount)
+    // Returns after all chunks have finished. If any chunk threw, chunks not
+    // yet started are skipped and the first exception is rethrown here.
+    void ParallelFor(size_t chunkCount, const std::function<void(size_t)>& fn);
+
+    // As ParallelFor, but never waits for another caller: while the pool is
+    // busy every chunk runs inline on the calling thread. Returns false when
+    // that happened. For callers that must not stall (the render thread).
+    bool ParallelForOrInline(size_t chunkCount, const std::function<void(size_t)>& fn);
+
+private:
+    void RunJob(size_t chunkCount, const std::function<void(size_t)>& fn);  // submitMutex_ held
+    void WorkerLoop();
+    void DrainChunks();
+
+    std::vector<std::thread> workers_;
+
+    std::mutex submitMutex_;  // serializes ParallelFor callers
+    std::mutex jobMutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable jobDone_;
+
+    const std::function<void(size_t)>* jobFn_ = nullptr;
+    size_t jobChunkCount_ = 0;
+    std::atomic<size_t> nextChunk_{0};
+    size_t pendingChunks_ = 0;  // guarded by jobMutex_
+    size_t activeWorkers_ = 0;  // guarded by jobMutex_
+    std::exception_ptr jobError_;  // first chunk failure; guarded by jobMutex_
+    unsigned long long jobSerial_ = 0;
+    bool stopping_ = false;
+};
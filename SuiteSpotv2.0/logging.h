@@ -6,9 +6,35 @@
 #include <memory>
 
 #include "bakkesmod/wrappers/cvarmanagerwrapper.h"
+#include "AsyncLogger.h"
 
 extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
-constexpr bool DEBUG_LOG = false;
+
+// Lowest level compiled in; calls below it compile to nothing. Override with
+// /DSUITESPOT_LOG_MIN_LEVEL=<0..5> (Trace..Off).
+#ifndef SUITESPOT_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define SUITESPOT_LOG_MIN_LEVEL 0
+#else
+#define SUITESPOT_LOG_MIN_LEVEL 1
+#endif
+#endif
+constexpr LogLevel COMPILED_LOG_LEVEL = static_cast<LogLevel>(SUITESPOT_LOG_MIN_LEVEL);
+constexpr bool DEBUG_LOG = COMPILED_LOG_LEVEL <= LogLevel::Debug;
+
+// Runtime check (suitespot_log_level); false means the line is not formatted
+inline bool LogEnabled(LogLevel level)
+{
+	return level >= COMPILED_LOG_LEVEL && level >= GlobalLogger().Level() && level != LogLevel::Off;
+}
+
+// Hands a formatted line to the async logger, or writes it directly when the
+// logger is not running (before onLoad starts it, after onUnload stops it)
+inline void LogWrite(LogLevel level, std::string line)
+{
+	if (GlobalLogger().Submit(level, line)) return;
+	if (_globalCvarManager) _globalCvarManager->log(line);
+}
 
 
 struct FormatString
@@ -51,27 +77,61 @@ struct FormatWstring
 };
 
 
+// Level fixed at compile time: below COMPILED_LOG_LEVEL the body is discarded,
+// below the runtime level nothing is formatted
+template <LogLevel Level, typename... Args>
+void LogAt(std::string_view format_str, Args&&... args)
+{
+	if constexpr (Level >= COMPILED_LOG_LEVEL && Level != LogLevel::Off)
+	{
+		if (!LogEnabled(Level)) return;
+		LogWrite(Level, std::vformat(format_str, std::make_format_args(args...)));
+	}
+}
+
+// Info
 template <typename... Args>
 void LOG(std::string_view format_str, Args&&... args)
 {
-	_globalCvarManager->log(std::vformat(format_str, std::make_format_args(args...)));
+	LogAt<LogLevel::Info>(format_str, std::forward<Args>(args)...);
 }
 
+// Wide lines are rare; they skip the queue but still honor the level
 template <typename... Args>
 void LOG(std::wstring_view format_str, Args&&... args)
 {
+	if (!LogEnabled(LogLevel::Info)) return;
 	_globalCvarManager->log(std::vformat(format_str, std::make_wformat_args(args...)));
 }
 
+template <typename... Args>
+void WARNLOG(std::string_view format_str, Args&&... args)
+{
+	LogAt<LogLevel::Warn>(format_str, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+void ERRORLOG(std::string_view format_str, Args&&... args)
+{
+	LogAt<LogLevel::Error>(format_str, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+void TRACELOG(std::string_view format_str, Args&&... args)
+{
+	LogAt<LogLevel::Trace>(format_str, std::forward<Args>(args)...);
+}
 
+// Debug, with the call site appended
 template <typename... Args>
 void DEBUGLOG(const FormatString& format_str, Args&&... args)
 {
 	if constexpr (DEBUG_LOG)
 	{
+		if (!LogEnabled(LogLevel::Debug)) return;
 		auto text = std::vformat(format_str.str, std::make_format_args(args...));
 		auto location = format_str.GetLocation();
-		_globalCvarManager->log(std::format("{} {}", text, location));
+		LogWrite(LogLevel::Debug, std::format("{} {}", text, location));
 	}
 }
 
@@ -80,6 +140,7 @@ void DEBUGLOG(const FormatWstring& format_str, Args&&... args)
 {
 	if constexpr (DEBUG_LOG)
 	{
+		if (!LogEnabled(LogLevel::Debug)) return;
 		auto text = std::vformat(format_str.str, std::make_wformat_args(args...));
 		auto location = format_str.GetLocation();
 		_globalCvarManager->log(std::format(L"{} {}", text, location));
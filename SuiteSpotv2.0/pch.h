@@ -2,17 +2,26 @@
 
 #define WIN32_LEAN_AND_MEAN
 #define _CRT_SECURE_NO_WARNINGS
+
+// SUITESPOT_HEADLESS builds only the portable core (CMakeLists.txt), which
+// needs nothing from BakkesMod or ImGui
+#ifndef SUITESPOT_HEADLESS
 #include "bakkesmod/plugin/bakkesmodplugin.h"
+#endif
 
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
 
+#ifndef SUITESPOT_HEADLESS
 #include "IMGUI/imgui.h"
 #include "IMGUI/imgui_stdlib.h"
 #include "IMGUI/imgui_searchablecombo.h"
 #include "IMGUI/imgui_rangeslider.h"
+#endif
 #include "IMGUI/json.hpp"
 
-#include "logging.h"
\ No newline at end of file
+#ifndef SUITESPOT_HEADLESS
+#include "logging.h"
+#endif
@@ -0,0 +1,185 @@
+// #detailed comments: MatchEndPipeline test
+// Purpose: Drives both match-ended hooks against a fake game and checks
+// that each match runs its post-match actions exactly once. FakeGame
+// stands in for ServerWrapper (match GUID, game event address) and fires
+// the two hooks the way the game does at the end of a match. Each hook goes
+// through AcceptMatchEnd, the same call SuiteSpot::GameEndedEvent makes, and
+// an accepted one counts as one capture and one action. Time comes from the
+// pipeline's injectable clock, so windows are exact.
+//
+// Built by CMakeLists.txt and run by ctest; exits non-zero on failure.
+#include "pch.h"
+#include "MatchEndPipeline.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = MatchEndPipeline::Clock;
+    using namespace std::chrono_literals;
+
+    int failures = 0;
+
+#define CHECK_EQ(actual, expected)                                                              \
+    do {                                                                                       \
+        const auto a_ = (actual);                                                              \
+        const auto e_ = (expected);                                                            \
+        if (!(a_ == e_)) {                                                                     \
+            std::printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual,     \
+                static_cast<long long>(a_), static_cast<long long>(e_));                      \
+            ++failures;                                                                        \
+        }                                                                                      \
+    } while (0)
+
+    constexpr const char* kEventMatchEnded = "Function TAGame.GameEvent_Soccar_TA.EventMatchEnded";
+    constexpr const char* kHandleMatchEnded = "Function TAGame.AchievementManager_TA.HandleMatchEnded";
+
+    // The parts of the game that GameEndedEvent reads
+    struct FakeGame {
+        Clock::time_point now = Clock::time_point{} + 1h;
+        std::string matchGuid;           // Empty for matches without one (offline, some privates)
+        uint64_t eventAddress = 0;       // 0 = no game event (menus)
+
+        void Advance(Clock::duration d) { now += d; }
+    };
+
+    // SuiteSpot::GameEndedEvent with the capture and actions reduced to counters
+    struct MatchEndHarness {
+        explicit MatchEndHarness(FakeGame& g) : game(g) {}
+
+        FakeGame& game;
+        MatchEndPipeline pipeline{ MatchEndPipeline::kDefaultWindow };
+        int captures = 0;
+        int actions = 0;
+        std::vector<std::string> acceptedKeys;
+
+        void GameEndedEvent(const std::string& hook)
+        {
+            std::string key;
+            if (!AcceptMatchEnd(pipeline, game.matchGuid, game.eventAddress, hook, key, game.now)) return;
+            ++captures;
+            ++actions;
+            acceptedKeys.push_back(key);
+        }
+
+        // Both hooks for one match end, the second a few frames later
+        void EndMatch()
+        {
+            GameEndedEvent(kEventMatchEnded);
+            game.Advance(50ms);
+            GameEndedEvent(kHandleMatchEnded);
+        }
+    };
+
+    void IdentityRules()
+    {
+        CHECK_EQ(MatchIdentity("A1B2C3", 0x1000) == "A1B2C3", true);
+        CHECK_EQ(MatchIdentity("", 0xabc) == "event@abc", true);
+        // No game event: nothing identifies the match, even with a stale GUID
+        CHECK_EQ(MatchIdentity("A1B2C3", 0).empty(), true);
+    }
+
+    void DuplicateSignalsInsideWindow()
+    {
+        FakeGame game;
+        game.matchGuid = "A1B2C3";
+        game.eventAddress = 0x1000;
+        MatchEndHarness harness(game);
+
+        harness.EndMatch();
+        CHECK_EQ(harness.captures, 1);
+        CHECK_EQ(harness.actions, 1);
+        CHECK_EQ(harness.pipeline.GetCoalescedCount(), 1u);
+        CHECK_EQ(harness.pipeline.GetLastSource() == kEventMatchEnded, true);
+
+        // A late repeat of either hook inside the window is still the same match
+        game.Advance(5s);
+        harness.GameEndedEvent(kHandleMatchEnded);
+        harness.GameEndedEvent(kEventMatchEnded);
+        CHECK_EQ(harness.actions, 1);
+        CHECK_EQ(harness.pipeline.GetCoalescedCount(), 3u);
+    }
+
+    void TwoDistinctMatches()
+    {
+        FakeGame game;
+        game.matchGuid = "MATCH-1";
+        game.eventAddress = 0x1000;
+        MatchEndHarness harness(game);
+
+        harness.EndMatch();
+
+        // Back-to-back private match: a new identity inside the window
+        game.Advance(2s);
+        game.matchGuid = "MATCH-2";
+        game.eventAddress = 0x2000;
+        harness.EndMatch();
+
+        CHECK_EQ(harness.actions, 2);
+        CHECK_EQ(harness.pipeline.GetAcceptedCount(), 2u);
+        CHECK_EQ(harness.pipeline.GetCoalescedCount(), 2u);
+        CHECK_EQ(harness.acceptedKeys.size(), 2u);
+        CHECK_EQ(harness.acceptedKeys.size() == 2 && harness.acceptedKeys[1] == "MATCH-2", true);
+
+        // No GUID: the game event's address tells matches apart
+        game.Advance(2s);
+        game.matchGuid.clear();
+        game.eventAddress = 0x3000;
+        harness.EndMatch();
+        CHECK_EQ(harness.actions, 3);
+        CHECK_EQ(harness.acceptedKeys.back() == "event@3000", true);
+    }
+
+    void EmptyIdentity()
+    {
+        FakeGame game;  // No game event: the identity is empty
+        MatchEndHarness harness(game);
+
+        harness.EndMatch();
+        CHECK_EQ(harness.actions, 1);
+        CHECK_EQ(harness.pipeline.GetCoalescedCount(), 1u);
+        CHECK_EQ(harness.acceptedKeys.size() == 1 && harness.acceptedKeys[0].empty(), true);
+
+        // Unknown on either side inside the window counts as the same match
+        game.Advance(1s);
+        game.matchGuid = "LATE-GUID";
+        game.eventAddress = 0x4000;
+        harness.GameEndedEvent(kHandleMatchEnded);
+        CHECK_EQ(harness.actions, 1);
+
+        // Past the window an empty identity starts a new match
+        game.Advance(MatchEndPipeline::kDefaultWindow);
+        game.matchGuid.clear();
+        game.eventAddress = 0;
+        harness.EndMatch();
+        CHECK_EQ(harness.actions, 2);
+        CHECK_EQ(harness.pipeline.GetCoalescedCount(), 3u);
+    }
+
+    void ResetForgetsLastMatch()
+    {
+        FakeGame game;
+        game.matchGuid = "SAME";
+        game.eventAddress = 0x1000;
+        MatchEndHarness harness(game);
+
+        harness.EndMatch();
+        harness.pipeline.Reset();
+        harness.GameEndedEvent(kHandleMatchEnded);
+        CHECK_EQ(harness.actions, 2);
+    }
+}
+
+int main()
+{
+    IdentityRules();
+    DuplicateSignalsInsideWindow();
+    TwoDistinctMatches();
+    EmptyIdentity();
+    ResetForgetsLastMatch();
+
+    std::printf("%s\n", failures == 0 ? "MatchEndPipeline: ok" : "MatchEndPipeline: FAILED");
+    return failures == 0 ? 0 : 1;
+}